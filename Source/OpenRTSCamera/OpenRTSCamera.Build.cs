@@ -41,6 +41,8 @@ public class OpenRTSCamera : ModuleRules
 				"MassBattle",
 				"MassAPI",
 				"MassEntity",
+				"MassCommon",
+				"MassSpawner",
 				"LandmarkSystem",
 				"GameplayTags",
 				"RTSCommandSystem"
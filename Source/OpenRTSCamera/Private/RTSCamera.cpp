@@ -2,18 +2,48 @@
 
 #define RTS_CAMERA_CPP
 #include "RTSCamera.h"
-#include "MassBattleMinimapRegion.h"
+#include "OpenRTSCamera.h"
+#include "RTSCameraInputPreprocessor.h"
+#include "RTSCameraManagerSubsystem.h"
+#include "RTSCameraRegionSubsystem.h"
+#include "RTSTerrainHeightfieldSubsystem.h"
 
 // 定义 RTSCamera 专用日志分类
 DEFINE_LOG_CATEGORY_STATIC(LogRTSCamera, Log, All);
 
-#include "Blueprint/WidgetLayoutLibrary.h"
+DECLARE_CYCLE_STAT(TEXT("Sync Ground Trace"), STAT_RTSCameraSyncGroundTrace, STATGROUP_OpenRTSCamera);
+DECLARE_CYCLE_STAT(TEXT("Terrain Arm Avoidance"), STAT_RTSCameraTerrainArmAvoidance, STATGROUP_OpenRTSCamera);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Async Ground Probes Submitted"), STAT_RTSCameraAsyncGroundProbes, STATGROUP_OpenRTSCamera);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Sync Trace Time Saved (ms)"), STAT_RTSCameraSyncTraceTimeSaved, STATGROUP_OpenRTSCamera);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Input To Commit Latency (ms)"), STAT_RTSCameraInputToCommitLatency, STATGROUP_OpenRTSCamera);
+
+namespace
+{
+	/// 异步探针槽位布局
+	constexpr int32 rootGroundProbeSlot = 0;
+	constexpr int32 firstFrustumGroundProbeSlot = 1;
+	constexpr int32 followTargetGroundProbeSlot = 5;
+
+	/// 流送用平移速度的平滑时间常数（秒）
+	constexpr float streamingVelocitySmoothingSeconds = 0.1f;
+
+	/// 外推位移小于该值时不上报预测视野
+	constexpr float minimumStreamingExtrapolationDistance = 100.0f;
+}
+
+#include "Curves/CurveFloat.h"
+#include "Engine/GameViewportClient.h"
 #include "Engine/LocalPlayer.h"
 #include "Engine/World.h"
+#include "Framework/Application/SlateApplication.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerController.h"
 #include "EnhancedInputComponent.h"
 #include "EnhancedInputSubsystems.h"
-#include "Kismet/GameplayStatics.h"
 #include "Kismet/KismetMathLibrary.h"
+#include "TimerManager.h"
+#include "Widgets/SViewport.h"
+#include "WorldPartition/WorldPartitionSubsystem.h"
 #include "Runtime/CoreUObject/Public/UObject/ConstructorHelpers.h"
 
 URTSCamera::URTSCamera()
@@ -29,6 +59,25 @@ URTSCamera::URTSCamera()
 	this->enableDynamicCameraHeight = true;
 	this->enableEdgeScrolling = true;
 	this->findGroundTraceLength = 100000;
+	this->enableTerrainHeightCache = true;
+	this->terrainHeightCacheCellSize = 200.0f;
+	this->terrainHeightfield = nullptr;
+	this->enableAsyncGroundProbes = false;
+	this->asyncGroundHeightSmoothingSpeed = 12.0f;
+	this->enableTerrainArmAvoidance = true;
+	this->terrainArmClearance = 150.0f;
+	this->terrainArmSampleCount = 4;
+	this->terrainArmRaiseSpeed = 12.0f;
+	this->terrainArmLowerSpeed = 2.0f;
+	this->terrainAvoidanceBaseOffsetZ = 0.0f;
+	this->terrainAvoidanceTargetLift = 0.0f;
+	this->terrainAvoidanceLift = 0.0f;
+	this->averageSyncGroundTraceSeconds = 0.0;
+	for (int32 probeIndex = 0; probeIndex < asyncGroundProbeCount; ++probeIndex)
+	{
+		this->asyncGroundProbeHeights[probeIndex] = 0.0f;
+		this->asyncGroundProbeValid[probeIndex] = false;
+	}
 	this->maximumZoomLength = 5000;
 	this->minimumZoomLength = 500;
 	this->maxMovementSpeed = 1024.0f;
@@ -45,6 +94,66 @@ URTSCamera::URTSCamera()
 	this->bEnableYBoundaryConstraint = true;
 	this->currentLateralSocketOffset = 0.0f;
 	this->currentVerticalSocketOffset = 0.0f;
+	this->stagedRootLocation = FVector::ZeroVector;
+	this->bHasStagedRootLocation = false;
+	this->bMinimapFrustumRefreshRequested = false;
+	this->minimapFrustumBroadcastTolerance = 1.0f;
+	this->bHasBroadcastMinimapFrustum = false;
+	this->lastMinimapFrustumBroadcastFrame = 0;
+	for (int32 cornerIndex = 0; cornerIndex < 4; ++cornerIndex)
+	{
+		this->minimapFrustumPoints[cornerIndex] = FVector::ZeroVector;
+		this->broadcastMinimapFrustumPoints[cornerIndex] = FVector::ZeroVector;
+	}
+	this->enableIdleTickSleep = true;
+	this->idleEdgeScrollProbeInterval = 0.05f;
+	this->viewTargetProbeInterval = 0.25f;
+	this->updateWithoutViewTarget = false;
+	this->idleZoomConvergenceTolerance = 0.5f;
+	this->bEdgeScrollActiveThisTick = false;
+	this->bIsTickSleeping = false;
+	this->enableLateUpdate = false;
+	this->earliestPendingInputSeconds = 0.0;
+	this->enableRawInputAccumulation = false;
+	this->enableBatchedUpdate = true;
+	this->enableReplayRecording = true;
+	this->replayBufferKilobytes = 512;
+	this->bIsReplaying = false;
+	this->replayPlaybackSeconds = 0.0;
+	this->replayPlaybackRate = 1.0f;
+	this->snapshotChannel = MakeShared<FRTSCameraSnapshotChannel, ESPMode::ThreadSafe>();
+	this->enablePredictiveStreaming = true;
+	this->streamingLookaheadSeconds = 0.5f;
+	this->jumpStreamingHoldSeconds = 2.0f;
+	this->maxStreamingSourceRadius = 50000.0f;
+	this->bRegisteredStreamingSourceProvider = false;
+	this->streamingPanVelocity = FVector2D::ZeroVector;
+	this->lastStreamingPlanarLocation = FVector2D::ZeroVector;
+	this->bHasStreamingVelocitySample = false;
+	this->bStreamingVelocityResetRequested = false;
+	this->streamingPrefetchLocation = FVector::ZeroVector;
+	this->streamingPrefetchExpireSeconds = -1.0;
+	this->cameraManager = nullptr;
+	this->regionSubsystem = nullptr;
+	this->bRegionLookupRequested = false;
+	this->drainedCursorPosition = FVector2D::ZeroVector;
+	this->bHasDrainedCursorPosition = false;
+	this->enableFixedTimestepSimulation = false;
+	this->fixedSimulationRate = 60.0f;
+	this->maxSimulationSubSteps = 4;
+	this->simulationTimeAccumulator = 0.0f;
+	this->previousSimulatedPlanarLocation = FVector2D::ZeroVector;
+	this->currentSimulatedPlanarLocation = FVector2D::ZeroVector;
+	this->previousSimulatedArmLength = 0.0f;
+	this->currentSimulatedArmLength = 0.0f;
+	this->simulationRenderedPlanarLocation = FVector2D::ZeroVector;
+	this->bSimulationStateInitialized = false;
+	this->bSimulationTeleportPending = false;
+	this->normalizeDiagonalEdgeScroll = false;
+	this->edgeScrollResponseCurve = nullptr;
+	this->edgeScrollAccelerationCurve = nullptr;
+	this->edgeScrollDwellSeconds = 0.0f;
+	this->cachedViewportSize = FVector2D::ZeroVector;
 
 	/// 载入并关联输入资产
 	static ConstructorHelpers::FObjectFinder<UInputAction> xMoveActionFinder(TEXT("/OpenRTSCamera/Inputs/MoveCameraXAxis"));
@@ -75,8 +184,18 @@ void URTSCamera::BeginPlay()
 	{
 		/// 初始化依赖架构，建立输入映射链条
 		this->resolveComponentDependencyPointers();
+		this->configureLateUpdateTick();
+		this->registerWithCameraManager();
+		this->registerInputPreprocessor();
+		this->refreshCachedViewportSize();
+		this->viewportResizedHandle = FViewport::ViewportResizedEvent.AddUObject(this, &URTSCamera::handleViewportResized);
 		this->setupInitialSpringArmState();
-		this->locateMapBoundaryVolumeByTag();
+		this->locateMovementBoundaryRegion();
+		this->registerStreamingSourceProvider();
+		if (this->enableReplayRecording)
+		{
+			this->replayBuffer.initialize(this->replayBufferKilobytes * 1024);
+		}
 		this->configureInputModeForEdgeScrolling();
 		this->validateEnhancedInputAvailability();
 		this->registerInputMappingContext();
@@ -84,6 +203,30 @@ void URTSCamera::BeginPlay()
 	}
 }
 
+void URTSCamera::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	/// 解除视口与边界区域事件订阅，并停止休眠探测定时器
+	FViewport::ViewportResizedEvent.Remove(this->viewportResizedHandle);
+	this->unregisterInputPreprocessor();
+	this->unregisterStreamingSourceProvider();
+	if (this->cameraManager != nullptr)
+	{
+		this->cameraManager->UnregisterCamera(this);
+		this->cameraManager = nullptr;
+	}
+	if (this->regionSubsystem != nullptr)
+	{
+		this->regionSubsystem->OnRegionsChanged.Remove(this->regionsChangedHandle);
+	}
+	if (const UWorld* world = this->GetWorld())
+	{
+		world->GetTimerManager().ClearTimer(this->idleEdgeScrollProbeTimerHandle);
+		world->GetTimerManager().ClearTimer(this->viewTargetProbeTimerHandle);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
 void URTSCamera::TickComponent(
 	float DeltaTime,
 	ELevelTick TickType,
@@ -91,17 +234,161 @@ void URTSCamera::TickComponent(
 )
 {
 	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
-	const auto netMode = this->GetNetMode();
-	
-	/// 仅在大客户端中处理相机位置插值与状态同步
-	if (netMode != NM_DedicatedServer && this->realTimeStrategyPlayerController->GetViewTarget() == this->cameraOwner)
+
+	/// 未交由相机管理器批量更新时（例如禁用了批量更新），在自身 Tick 中顺序执行全部阶段
+	if (this->advanceCameraFrame(DeltaTime, false))
+	{
+		this->commitStagedCameraMotion();
+		this->finishCameraFrame();
+	}
+}
+
+bool URTSCamera::advanceCameraFrame(const float frameDeltaSeconds, const bool bDeferArmLengthInterpolation)
+{
+	/// 仅在客户端处理正被本地玩家观看的相机（或画中画相机）；无人观看的相机进入休眠，不再逐帧判断
+	if (this->GetNetMode() == NM_DedicatedServer)
+	{
+		return false;
+	}
+	if (!this->shouldAdvanceCameraFrame())
+	{
+		this->enterUnviewedSleep();
+		return false;
+	}
+
+	this->deltaSeconds = frameDeltaSeconds;
+	this->drainRawPointerInput();
+	this->resolvePendingRegionLookup();
+
+	/// 回放期间由记录驱动，丢弃本帧的玩家输入
+	if (this->bIsReplaying)
+	{
+		this->advanceReplayPlayback(frameDeltaSeconds);
+		this->pendingMovementCommands.Reset();
+		return true;
+	}
+
+	if (this->shouldSampleDragInTick() && this->isDragging)
+	{
+		this->sampleDragMovement();
+	}
+	if (this->enableFixedTimestepSimulation)
+	{
+		this->runFixedTimestepSimulation(frameDeltaSeconds);
+	}
+	else
 	{
-		this->deltaSeconds = DeltaTime;
 		this->applyAccumulatedMovementCommands();
 		this->executeEdgeScrollingEvaluation();
-		this->handleTargetArmLengthInterpolation();
+		if (!bDeferArmLengthInterpolation)
+		{
+			this->handleTargetArmLengthInterpolation();
+		}
 		this->updateFollowPositionIfTargetActive();
-		this->applyBoundaryConstraints();
+		this->pendingMovementCommands.Reset();
+	}
+	return true;
+}
+
+void URTSCamera::finishCameraFrame()
+{
+	if (this->enableFixedTimestepSimulation)
+	{
+		this->simulationRenderedPlanarLocation = FVector2D(this->rootComponent->GetComponentLocation());
+	}
+	this->bHasDrainedCursorPosition = false;
+
+	if (this->enableIdleTickSleep && this->isCameraMotionIdle())
+	{
+		this->enterIdleTickSleep();
+	}
+}
+
+bool URTSCamera::isViewedByLocalPlayer() const
+{
+	/// 只读取缓存的控制器；视角切换后的重新解析由休眠期间的低频探测完成，不在逐帧路径上遍历控制器
+	return this->realTimeStrategyPlayerController != nullptr && this->realTimeStrategyPlayerController->GetViewTarget() == this->cameraOwner;
+}
+
+bool URTSCamera::shouldAdvanceCameraFrame() const
+{
+	/// 画中画相机通过场景捕获渲染，不是任何控制器的视角目标，但仍需要逐帧推进
+	return this->updateWithoutViewTarget || this->isViewedByLocalPlayer();
+}
+
+void URTSCamera::enterUnviewedSleep()
+{
+	/// 无人观看时与空闲休眠共用同一状态位，并改为低频探测是否重新成为视角目标
+	this->enterIdleTickSleep();
+	this->GetWorld()->GetTimerManager().ClearTimer(this->idleEdgeScrollProbeTimerHandle);
+	this->GetWorld()->GetTimerManager().SetTimer(
+		this->viewTargetProbeTimerHandle,
+		this,
+		&URTSCamera::probeViewTargetWhileUnviewed,
+		this->viewTargetProbeInterval,
+		true
+	);
+}
+
+void URTSCamera::probeViewTargetWhileUnviewed()
+{
+	/// 缓存的控制器已不再观看本相机时（分屏、观战切换、延迟占有）重新解析一次
+	if (!this->isViewedByLocalPlayer())
+	{
+		this->realTimeStrategyPlayerController = this->resolveOwningPlayerController();
+	}
+	if (this->shouldAdvanceCameraFrame())
+	{
+		this->bMinimapFrustumRefreshRequested = true;
+		this->wakeCameraTick();
+	}
+}
+
+APlayerController* URTSCamera::resolveOwningPlayerController() const
+{
+	/// 优先使用拥有者自身的控制器：分屏时每位玩家的相机 Pawn 各自被对应的控制器持有
+	if (const APawn* ownerPawn = Cast<APawn>(this->cameraOwner))
+	{
+		if (APlayerController* pawnController = ownerPawn->GetController<APlayerController>())
+		{
+			return pawnController;
+		}
+	}
+	if (APlayerController* ownerController = Cast<APlayerController>(this->cameraOwner != nullptr ? this->cameraOwner->GetOwner() : nullptr))
+	{
+		return ownerController;
+	}
+
+	/// 观战视角：拥有者不归任何控制器所有，查找正以其为视角目标的本地控制器
+	const UWorld* world = this->GetWorld();
+	if (world == nullptr)
+	{
+		return nullptr;
+	}
+	for (FConstPlayerControllerIterator iterator = world->GetPlayerControllerIterator(); iterator; ++iterator)
+	{
+		APlayerController* playerController = iterator->Get();
+		if (playerController != nullptr && playerController->IsLocalController() && playerController->GetViewTarget() == this->cameraOwner)
+		{
+			return playerController;
+		}
+	}
+	return world->GetFirstPlayerController();
+}
+
+void URTSCamera::registerWithCameraManager()
+{
+	if (!this->enableBatchedUpdate)
+	{
+		return;
+	}
+
+	/// 交由管理器统一推进：自身 Tick 关闭，休眠与唤醒改为通知管理器
+	this->cameraManager = this->GetWorld()->GetSubsystem<URTSCameraManagerSubsystem>();
+	if (this->cameraManager != nullptr)
+	{
+		this->cameraManager->RegisterCamera(this);
+		this->SetComponentTickEnabled(false);
 	}
 }
 
@@ -109,6 +396,19 @@ void URTSCamera::followTarget(AActor* target)
 {
 	/// 设置物理跟随标记，相机将进入逐帧对齐模式
 	this->activeCameraFollowTarget = target;
+	if (target != nullptr)
+	{
+		/// 已销毁的目标在回放中也无法解析，登记新目标时顺带清理
+		for (auto iterator = this->replayFollowTargetsById.CreateIterator(); iterator; ++iterator)
+		{
+			if (!iterator->Value.IsValid())
+			{
+				iterator.RemoveCurrent();
+			}
+		}
+		this->replayFollowTargetsById.Add(target->GetUniqueID(), target);
+	}
+	this->wakeCameraTick();
 }
 
 void URTSCamera::unFollowTarget()
@@ -120,6 +420,8 @@ void URTSCamera::unFollowTarget()
 void URTSCamera::onZoomCameraActionTriggered(const FInputActionValue& value)
 {
 	/// 更新意图缩放距离并通过该参数联动调整移动阻尼感
+	this->wakeCameraTick();
+	this->markInputSampled();
 	this->desiredZoomLength = FMath::Clamp(
 		this->desiredZoomLength + value.Get<float>() * this->zoomSpeed,
 		this->minimumZoomLength,
@@ -129,13 +431,14 @@ void URTSCamera::onZoomCameraActionTriggered(const FInputActionValue& value)
 	float speedAlpha = (this->desiredZoomLength - this->minimumZoomLength) / (this->maximumZoomLength - this->minimumZoomLength);
 	this->currentMovementSpeed = FMath::Lerp(this->minMovementSpeed, this->maxMovementSpeed, speedAlpha);
 
-	/// 缩放意图发生的瞬间即时投射視野框，确保 UI 的战略响应无延迟
-	this->updateMinimapFrustum();
+	/// 缩放意图发生时标记視野框待刷新，由本帧的提交阶段统一投射
+	this->bMinimapFrustumRefreshRequested = true;
 }
 
 void URTSCamera::onRotateCameraActionTriggered(const FInputActionValue& value)
 {
 	/// 处理水平偏航角输入并更新世界变换
+	this->wakeCameraTick();
 	const auto actorRotation = this->rootComponent->GetComponentRotation();
 	this->rootComponent->SetWorldRotation(
 		FRotator::MakeFromEuler(
@@ -146,12 +449,13 @@ void URTSCamera::onRotateCameraActionTriggered(const FInputActionValue& value)
 			)
 		)
 	);
-	this->updateMinimapFrustum();
+	this->bMinimapFrustumRefreshRequested = true;
 }
 
 void URTSCamera::onTurnCameraLeftActionTriggered(const FInputActionValue&)
 {
 	/// 向左执行定量的步进式偏转
+	this->wakeCameraTick();
 	const FRotator relativeRotation = this->rootComponent->GetRelativeRotation();
 	this->rootComponent->SetRelativeRotation(
 		FRotator::MakeFromEuler(
@@ -162,12 +466,13 @@ void URTSCamera::onTurnCameraLeftActionTriggered(const FInputActionValue&)
 			)
 		)
 	);
-	this->updateMinimapFrustum();
+	this->bMinimapFrustumRefreshRequested = true;
 }
 
 void URTSCamera::onTurnCameraRightActionTriggered(const FInputActionValue&)
 {
 	/// 向右执行定量的步进式偏转
+	this->wakeCameraTick();
 	const FRotator relativeRotation = this->rootComponent->GetRelativeRotation();
 	this->rootComponent->SetRelativeRotation(
 		FRotator::MakeFromEuler(
@@ -178,7 +483,7 @@ void URTSCamera::onTurnCameraRightActionTriggered(const FInputActionValue&)
 			)
 		)
 	);
-	this->updateMinimapFrustum();
+	this->bMinimapFrustumRefreshRequested = true;
 }
 
 void URTSCamera::onMoveCameraYAxisActionTriggered(const FInputActionValue& value)
@@ -203,35 +508,22 @@ void URTSCamera::onMoveCameraXAxisActionTriggered(const FInputActionValue& value
 
 void URTSCamera::onDragCameraActionTriggered(const FInputActionValue& value)
 {
+	this->wakeCameraTick();
+
 	/// 记录拖拽起始状态
 	if (!this->isDragging && value.Get<bool>())
 	{
-		this->isDragging = true;
-		this->dragInteractionInitialLocation = UWidgetLayoutLibrary::GetMousePositionOnViewport(this->GetWorld());
+		this->resetRawPointerInput();
+		this->isDragging = this->sampleCursorInViewport(this->dragInteractionInitialLocation);
 	}
 
-	/// 在激活期间计算平滑增量并转换为运动指令
+	/// 在激活期间计算平滑增量并转换为运动指令；延迟更新或原始输入累积模式下改由 Tick 在提交前采样
 	else if (this->isDragging && value.Get<bool>())
 	{
-		const auto mousePosition = UWidgetLayoutLibrary::GetMousePositionOnViewport(this->GetWorld());
-		auto viewportSizeExtent = UWidgetLayoutLibrary::GetViewportWidgetGeometry(this->GetWorld()).GetLocalSize();
-		viewportSizeExtent *= dragExtent;
-
-		auto dragDelta = mousePosition - this->dragInteractionInitialLocation;
-		dragDelta.X = FMath::Clamp(dragDelta.X, -viewportSizeExtent.X, viewportSizeExtent.X) / viewportSizeExtent.X;
-		dragDelta.Y = FMath::Clamp(dragDelta.Y, -viewportSizeExtent.Y, viewportSizeExtent.Y) / viewportSizeExtent.Y;
-
-		this->requestCameraMovement(
-			this->rootComponent->GetRightVector().X,
-			this->rootComponent->GetRightVector().Y,
-			dragDelta.X
-		);
-
-		this->requestCameraMovement(
-			this->rootComponent->GetForwardVector().X,
-			this->rootComponent->GetForwardVector().Y,
-			dragDelta.Y * -1
-		);
+		if (!this->shouldSampleDragInTick())
+		{
+			this->sampleDragMovement();
+		}
 	}
 
 	/// 清理拖拽标记
@@ -241,9 +533,120 @@ void URTSCamera::onDragCameraActionTriggered(const FInputActionValue& value)
 	}
 }
 
+void URTSCamera::sampleDragMovement()
+{
+	FVector2D mousePosition;
+	if (!this->sampleCursorInViewport(mousePosition))
+	{
+		return;
+	}
+	const FVector2D viewportSizeExtent = this->cachedViewportSize * dragExtent;
+
+	auto dragDelta = mousePosition - this->dragInteractionInitialLocation;
+	dragDelta.X = FMath::Clamp(dragDelta.X, -viewportSizeExtent.X, viewportSizeExtent.X) / viewportSizeExtent.X;
+	dragDelta.Y = FMath::Clamp(dragDelta.Y, -viewportSizeExtent.Y, viewportSizeExtent.Y) / viewportSizeExtent.Y;
+
+	this->requestCameraMovement(
+		this->rootComponent->GetRightVector().X,
+		this->rootComponent->GetRightVector().Y,
+		dragDelta.X
+	);
+
+	this->requestCameraMovement(
+		this->rootComponent->GetForwardVector().X,
+		this->rootComponent->GetForwardVector().Y,
+		dragDelta.Y * -1
+	);
+}
+
+bool URTSCamera::shouldSampleDragInTick() const
+{
+	return this->enableLateUpdate || this->inputPreprocessor.IsValid();
+}
+
+void URTSCamera::registerInputPreprocessor()
+{
+	if (!this->enableRawInputAccumulation || this->inputPreprocessor.IsValid() || !FSlateApplication::IsInitialized())
+	{
+		return;
+	}
+
+	this->inputPreprocessor = MakeShared<FRTSCameraInputPreprocessor>();
+	FSlateApplication::Get().RegisterInputPreProcessor(this->inputPreprocessor);
+}
+
+void URTSCamera::unregisterInputPreprocessor()
+{
+	if (!this->inputPreprocessor.IsValid())
+	{
+		return;
+	}
+
+	if (FSlateApplication::IsInitialized())
+	{
+		FSlateApplication::Get().UnregisterInputPreProcessor(this->inputPreprocessor);
+	}
+	this->inputPreprocessor.Reset();
+}
+
+void URTSCamera::drainRawPointerInput()
+{
+	this->bHasDrainedCursorPosition = false;
+	FVector2D latestScreenPosition;
+	if (!this->inputPreprocessor.IsValid() || !this->inputPreprocessor->drain(latestScreenPosition))
+	{
+		return;
+	}
+
+	/// 用视口控件上一帧排布好的几何把屏幕坐标换算到视口像素空间，不再额外查询实时光标
+	const UGameViewportClient* gameViewport = this->GetWorld()->GetGameViewport();
+	const TSharedPtr<SViewport> viewportWidget = gameViewport != nullptr ? gameViewport->GetGameViewportWidget() : nullptr;
+	if (!viewportWidget.IsValid())
+	{
+		return;
+	}
+
+	const FGeometry& viewportGeometry = viewportWidget->GetCachedGeometry();
+	const FVector2D localSize = viewportGeometry.GetLocalSize();
+	if (localSize.X <= 0.0 || localSize.Y <= 0.0 || this->cachedViewportSize.X <= 0.0f || this->cachedViewportSize.Y <= 0.0f)
+	{
+		return;
+	}
+
+	/// 与实时查询一致：光标不在视口内时不提供位置
+	const FVector2D viewportPosition = viewportGeometry.AbsoluteToLocal(latestScreenPosition) * (this->cachedViewportSize / localSize);
+	if (viewportPosition.X < 0.0 || viewportPosition.Y < 0.0 || viewportPosition.X > this->cachedViewportSize.X || viewportPosition.Y > this->cachedViewportSize.Y)
+	{
+		return;
+	}
+
+	this->drainedCursorPosition = viewportPosition;
+	this->bHasDrainedCursorPosition = true;
+}
+
+void URTSCamera::resetRawPointerInput()
+{
+	/// 丢弃唤醒或拖拽开始之前记录的光标，直到新的事件到达前回退到实时查询
+	if (this->inputPreprocessor.IsValid())
+	{
+		this->inputPreprocessor->resetSampleWindow();
+	}
+	this->bHasDrainedCursorPosition = false;
+}
+
+void URTSCamera::markInputSampled()
+{
+	if (this->earliestPendingInputSeconds == 0.0)
+	{
+		this->earliestPendingInputSeconds = FPlatformTime::Seconds();
+	}
+}
+
 void URTSCamera::requestCameraMovement(const float xAxisValue, const float yAxisValue, const float movementScale)
 {
 	/// 将运动请求压入队列，供 Tick 阶段统一消化
+	this->wakeCameraTick();
+	this->markInputSampled();
 	FMoveCameraCommand movementCommand;
 	movementCommand.xAxisValue = xAxisValue;
 	movementCommand.yAxisValue = yAxisValue;
@@ -253,19 +656,36 @@ void URTSCamera::requestCameraMovement(const float xAxisValue, const float yAxis
 
 void URTSCamera::applyAccumulatedMovementCommands()
 {
-	/// 执行帧内所有挂起的平移指令并清空
+	/// 将帧内所有挂起的平移指令累加到暂存目标上，不触发任何变换提交；指令由调用方在本帧积分完成后清空
+	if (this->pendingMovementCommands.Num() == 0)
+	{
+		return;
+	}
+
+	this->applyPlanarMovementVelocity(this->resolveMovementCommandVelocity());
+}
+
+FVector2D URTSCamera::resolveMovementCommandVelocity() const
+{
+	/// 每条指令视为本帧按住的一个方向，各自归一化后按速度与权重叠加
+	FVector2D planarVelocity = FVector2D::ZeroVector;
 	for (const auto& [xAxisValue, yAxisValue, movementScale] : this->pendingMovementCommands)
 	{
 		FVector2D directionVector(xAxisValue, yAxisValue);
 		directionVector.Normalize();
-		directionVector *= this->currentMovementSpeed * movementScale * this->deltaSeconds;
-		
-		this->jumpTo(
-			this->rootComponent->GetComponentLocation() + FVector(directionVector.X, directionVector.Y, 0.0f)
-		);
+		planarVelocity += directionVector * this->currentMovementSpeed * movementScale;
 	}
+	return planarVelocity;
+}
+
+void URTSCamera::applyPlanarMovementVelocity(const FVector2D& planarVelocity)
+{
+	/// 按当前步长积分一次平移速度
+	FVector& stagedLocation = this->acquireStagedRootLocation();
+	stagedLocation.X += planarVelocity.X * this->deltaSeconds;
+	stagedLocation.Y += planarVelocity.Y * this->deltaSeconds;
 
-	this->pendingMovementCommands.Empty();
+	this->bMinimapFrustumRefreshRequested = true;
 }
 
 void URTSCamera::resolveComponentDependencyPointers()
@@ -275,7 +695,7 @@ void URTSCamera::resolveComponentDependencyPointers()
 	this->rootComponent = this->cameraOwner->GetRootComponent();
 	this->cameraComponent = Cast<UCameraComponent>(this->cameraOwner->GetComponentByClass(UCameraComponent::StaticClass()));
 	this->springArmComponent = Cast<USpringArmComponent>(this->cameraOwner->GetComponentByClass(USpringArmComponent::StaticClass()));
-	this->realTimeStrategyPlayerController = UGameplayStatics::GetPlayerController(this->GetWorld(), 0);
+	this->realTimeStrategyPlayerController = this->resolveOwningPlayerController();
 }
 
 void URTSCamera::setupInitialSpringArmState()
@@ -283,7 +703,9 @@ void URTSCamera::setupInitialSpringArmState()
 	/// 配置弹簧臂的物理约束与渲染初始位姿
 	this->desiredZoomLength = this->minimumZoomLength;
 	this->springArmComponent->TargetArmLength = this->desiredZoomLength;
+	/// 物理扫掠开销过高，地形避让改由高度场采样完成（见 updateTerrainArmAvoidance）
 	this->springArmComponent->bDoCollisionTest = false;
+	this->terrainAvoidanceBaseOffsetZ = this->springArmComponent->TargetOffset.Z;
 	this->springArmComponent->bEnableCameraLag = this->enableCameraLag;
 	this->springArmComponent->bEnableCameraRotationLag = this->enableCameraRotationLag;
 	this->springArmComponent->SetRelativeRotation(
@@ -311,227 +733,686 @@ void URTSCamera::setupInitialSpringArmState()
 	}
 }
 
-void URTSCamera::locateMapBoundaryVolumeByTag()
+void URTSCamera::configureLateUpdateTick()
 {
-	/// 直接在世界中通过类类型检索 AMinimapRegion
-	TArray<AActor*> foundActors;
-	UGameplayStatics::GetAllActorsOfClass(
-		this->GetWorld(),
-		AMinimapRegion::StaticClass(),
-		foundActors
-	);
-
-	if (foundActors.Num() > 0)
+	if (!this->enableLateUpdate)
 	{
-		this->movementBoundaryVolume = foundActors[0];
-		if (AMinimapRegion* minimapRegion = Cast<AMinimapRegion>(this->movementBoundaryVolume)) 
-		{
-			const FVector logicalExtent = minimapRegion->BoundsComponent->GetScaledBoxExtent();
-			const float mapOverflowDistance = minimapRegion->MapOverflowUU;
-			
-			// --- 視野溢出定量诊断 (V14 - 全程线性强稳版) ---
-			// 我们精确量化高空与低空视角的物理物性，以验证线性斜率 k。
-			if (this->cameraComponent != nullptr)
-			{
-				const float pitchAngleInRadians = FMath::DegreesToRadians(FMath::Abs(this->startingPitchAngle));
-				const float horizontalFieldOfViewHalf = FMath::DegreesToRadians(this->cameraComponent->FieldOfView) / 2.0f;
-				const FVector2D viewportSize = UWidgetLayoutLibrary::GetViewportSize(this->GetWorld());
-				const float viewportAspectRatioValue = (viewportSize.Y > 0.0f) ? (viewportSize.X / viewportSize.Y) : this->cameraComponent->AspectRatio;
-				const float verticalFieldOfViewHalf = FMath::Atan(FMath::Tan(horizontalFieldOfViewHalf) / viewportAspectRatioValue);
-				
-				// 辅助计算闭包函数 (用于获取任意高度下的视野属性)
-				auto calculateReachForLength = [&](float length) {
-					const float z = length * FMath::Sin(pitchAngleInRadians);
-					const float slant = z / FMath::Sin(pitchAngleInRadians + verticalFieldOfViewHalf);
-					const float lateralReach = slant * FMath::Tan(horizontalFieldOfViewHalf);
-					const float forwardReach = slant * FMath::Cos(pitchAngleInRadians + verticalFieldOfViewHalf);
-					return FVector(z, lateralReach, forwardReach);
-				};
-
-				const FVector maxPhysics = calculateReachForLength(this->maximumZoomLength); 
-				const FVector minPhysics = calculateReachForLength(this->minimumZoomLength);
-
-				const float maxPhysicsX = maxPhysics.Z; // 南北延伸 (Forward Reach)
-				const float maxPhysicsY = maxPhysics.Y; // 东西跨度 (Lateral Reach)
-				
-				// 计算后向延伸 (Backward Reach)
-				const float slantBottom = maxPhysics.X / FMath::Sin(pitchAngleInRadians - verticalFieldOfViewHalf);
-				const float backwardReach = slantBottom * FMath::Cos(pitchAngleInRadians - verticalFieldOfViewHalf);
-
-				this->lateralReachFactor = maxPhysicsY / this->maximumZoomLength;
-				this->forwardReachFactor = maxPhysicsX / this->maximumZoomLength;
-				this->backwardReachFactor = backwardReach / this->maximumZoomLength;
-
-				const float lateralAngleDeg = FMath::RadiansToDegrees(FMath::Atan(this->lateralReachFactor));
-				const float forwardAngleDeg = FMath::RadiansToDegrees(FMath::Atan(this->forwardReachFactor));
-				const float backwardAngleDeg = FMath::RadiansToDegrees(FMath::Atan(this->backwardReachFactor));
-
-				UE_LOG(LogRTSCamera, Warning, TEXT("=== 边界溢出诊断报告 (V14 - 全程线性版) ==="));
-				UE_LOG(LogRTSCamera, Warning, TEXT("俯仰基准: %.1f | 溢出阈值 (MapOverflowUU): %.1f"), this->startingPitchAngle, mapOverflowDistance);
-				UE_LOG(LogRTSCamera, Warning, TEXT("[预计算系数] Lateral: %.4f (%.2f°) | Forward: %.4f (%.2f°) | Backward: %.4f (%.2f°)"), 
-					this->lateralReachFactor, lateralAngleDeg, this->forwardReachFactor, forwardAngleDeg, this->backwardReachFactor, backwardAngleDeg);
-				const float minPhysicsX = minPhysics.Z;
-				const float minPhysicsY = minPhysics.Y;
-
-				UE_LOG(LogRTSCamera, Warning, TEXT("[高空 Zmax=%.1f] 东西补偿 (Reach-O): %.1f | 南北补偿 (Reach-O): %.1f"), maxPhysics.X, maxPhysicsY - mapOverflowDistance, maxPhysicsX - mapOverflowDistance);
-				UE_LOG(LogRTSCamera, Warning, TEXT("[低空 Zmin=%.1f] 东西补偿 (Reach-O): %.1f | 南北补偿 (Reach-O): %.1f"), minPhysics.X, minPhysicsY - mapOverflowDistance, minPhysicsX - mapOverflowDistance);
-				UE_LOG(LogRTSCamera, Warning, TEXT("--- 线性偏置计算 (y = kz + b) ---"));
-				UE_LOG(LogRTSCamera, Warning, TEXT("东西向 (Y) 补偿范围: %.1f -> %.1f"), minPhysics.Y - mapOverflowDistance, maxPhysics.Y - mapOverflowDistance);
-				UE_LOG(LogRTSCamera, Warning, TEXT("南北向 (X) 补偿范围: %.1f -> %.1f"), minPhysics.Z - mapOverflowDistance, maxPhysics.Z - mapOverflowDistance);
-				UE_LOG(LogRTSCamera, Warning, TEXT("========================================="));
-			}
+		return;
+	}
 
-			// 还原基础初始化信息日志
-			UE_LOG(LogRTSCamera, Log, TEXT("RTSCamera 初始化: 挂载 [%s], 逻辑边界: %.1f x %.1f, 溢出保护: %.1f"), 
-				*minimapRegion->GetName(), logicalExtent.X * 2.0f, logicalExtent.Y * 2.0f, minimapRegion->MapOverflowUU);
-		}
-		this->updateMinimapFrustum();
+	/// 相机管理器在所有 Tick 组之后才计算视图，TG_LastDemotable 是其之前最晚的位置；
+	/// 弹簧臂依赖本组件写回的根坐标，必须排在相机之后求解最终位姿
+	this->SetTickGroup(TG_LastDemotable);
+	if (this->springArmComponent != nullptr)
+	{
+		this->springArmComponent->SetTickGroup(TG_LastDemotable);
+		this->springArmComponent->AddTickPrerequisiteComponent(this);
 	}
 }
 
-void URTSCamera::configureInputModeForEdgeScrolling()
+void URTSCamera::locateMovementBoundaryRegion()
 {
-	/// 当鼠标用于边缘滚动时，强制应用视口锁定策略
-	if (this->enableEdgeScrolling)
+	/// 活动区域由区域注册表按坐标查询，不再遍历世界中的 Actor
+	this->regionSubsystem = this->GetWorld()->GetSubsystem<URTSCameraRegionSubsystem>();
+	if (this->regionSubsystem == nullptr)
 	{
-		FInputModeGameAndUI gameModeSettings;
-		gameModeSettings.SetLockMouseToViewportBehavior(EMouseLockMode::LockAlways);
-		gameModeSettings.SetHideCursorDuringCapture(false);
-		this->realTimeStrategyPlayerController->SetInputMode(gameModeSettings);
+		return;
 	}
+
+	this->regionsChangedHandle = this->regionSubsystem->OnRegionsChanged.AddUObject(this, &URTSCamera::handleCameraRegionsChanged);
+	this->resolveMovementBoundaryRegion(FVector2D(this->rootComponent->GetComponentLocation()));
+	this->updateMinimapFrustum();
 }
 
-void URTSCamera::validateEnhancedInputAvailability()
+void URTSCamera::resolveMovementBoundaryRegion(const FVector2D& location)
 {
-	/// 校验当前的 InputComponent 是否兼容 Enhanced Input 语法
-	if (Cast<UEnhancedInputComponent>(this->realTimeStrategyPlayerController->InputComponent) == nullptr)
+	const FRTSCameraRegion* region = this->regionSubsystem != nullptr ? this->regionSubsystem->FindRegionAt(location, true) : nullptr;
+	AActor* regionActor = region != nullptr ? region->RegionActor.Get() : nullptr;
+	const bool bRegionChanged = regionActor != this->movementBoundaryVolume;
+	this->movementBoundaryVolume = regionActor;
+
+	/// 同一区域的范围变化只会更新求解器缓存；求解器在输入未变化时不做任何计算
+	if (region != nullptr)
 	{
-		UKismetSystemLibrary::PrintString(
-			this->GetWorld(),
-			TEXT("Warning: RTSCamera requires Enhanced Input Component! Check Project Settings."), true, true,
-			FLinearColor::Red,
-			100
-		);
+		this->boundarySolver.setRegion(region->Origin, region->Extents);
+		this->boundarySolver.setBoundaryField(region->BoundaryField);
 	}
-}
+	else
+	{
+		this->boundarySolver.clearRegion();
+	}
+	this->bMinimapFrustumRefreshRequested = true;
 
-void URTSCamera::registerInputMappingContext()
-{
-	/// 向玩家输入子系统注册相机专用的映射上下文
-	if (this->realTimeStrategyPlayerController && this->realTimeStrategyPlayerController->GetLocalPlayer())
+	/// 区域网格已存在且范围未变时只是一次查表，不会重复采样
+	this->buildTerrainHeightCache();
+	if (!bRegionChanged)
 	{
-		if (const auto inputSystem = this->realTimeStrategyPlayerController->GetLocalPlayer()->GetSubsystem<UEnhancedInputLocalPlayerSubsystem>())
-		{
-			this->realTimeStrategyPlayerController->bShowMouseCursor = true;
+		return;
+	}
 
-			if (!inputSystem->HasMappingContext(this->inputMappingContext))
-			{
-				inputSystem->AddMappingContext(this->inputMappingContext, 0);
-			}
-		}
+	if (region != nullptr)
+	{
+		this->logBoundaryDiagnostics(region->OverflowDistance);
+
+		// 还原基础初始化信息日志
+		UE_LOG(LogRTSCamera, Log, TEXT("RTSCamera 初始化: 挂载 [%s], 逻辑边界: %.1f x %.1f, 溢出保护: %.1f"), 
+			*regionActor->GetName(), region->Extents.X * 2.0f, region->Extents.Y * 2.0f, region->OverflowDistance);
 	}
+	this->onMovementBoundaryChanged.Broadcast();
 }
 
-void URTSCamera::bindActionCallbacks()
+void URTSCamera::resolvePendingRegionLookup()
 {
-	/// 执行运动指令与 C++ 响应函数的逻辑挂挂接
-	if (const auto enhancedInputComponent = Cast<UEnhancedInputComponent>(this->realTimeStrategyPlayerController->InputComponent))
+	if (!this->bRegionLookupRequested)
 	{
-		enhancedInputComponent->BindAction(this->zoomCameraAction, ETriggerEvent::Triggered, this, &URTSCamera::onZoomCameraActionTriggered);
-		enhancedInputComponent->BindAction(this->rotateCameraAxisAction, ETriggerEvent::Triggered, this, &URTSCamera::onRotateCameraActionTriggered);
-		enhancedInputComponent->BindAction(this->turnCameraLeftAction, ETriggerEvent::Triggered, this, &URTSCamera::onTurnCameraLeftActionTriggered);
-		enhancedInputComponent->BindAction(this->turnCameraRightAction, ETriggerEvent::Triggered, this, &URTSCamera::onTurnCameraRightActionTriggered);
-		enhancedInputComponent->BindAction(this->moveCameraXAxisAction, ETriggerEvent::Triggered, this, &URTSCamera::onMoveCameraXAxisActionTriggered);
-		enhancedInputComponent->BindAction(this->moveCameraYAxisAction, ETriggerEvent::Triggered, this, &URTSCamera::onMoveCameraYAxisActionTriggered);
-		enhancedInputComponent->BindAction(this->dragCameraAction, ETriggerEvent::Triggered, this, &URTSCamera::onDragCameraActionTriggered);
+		return;
 	}
+	this->bRegionLookupRequested = false;
+
+	const FVector location = this->bHasStagedRootLocation ? this->stagedRootLocation : this->rootComponent->GetComponentLocation();
+	this->resolveMovementBoundaryRegion(FVector2D(location));
 }
 
-void URTSCamera::setActiveCamera()
+void URTSCamera::handleCameraRegionsChanged()
 {
-	/// 将玩家当前的渲染视角强制聚焦于此组件
-	this->realTimeStrategyPlayerController->SetViewTarget(this->GetOwner());
+	/// 区域增删、启用切换或范围变化后，在下一次提交前重新查询
+	this->bRegionLookupRequested = true;
+	this->wakeCameraTick();
 }
 
-void URTSCamera::jumpTo(const FVector position)
+void URTSCamera::logBoundaryDiagnostics(const float mapOverflowDistance)
 {
-	/// 执行瞬时的视变换同步，并触发视野投影点手动刷新
-	float cachedZ = this->rootComponent->GetComponentLocation().Z;
-	this->rootComponent->SetWorldLocation(FVector(position.X, position.Y, cachedZ));
-	this->applyBoundaryConstraints();
-	this->updateMinimapFrustum();
+	// --- 視野溢出定量诊断 (V14 - 全程线性强稳版) ---
+	// 我们精确量化高空与低空视角的物理物性，以验证线性斜率 k。
+	if (this->cameraComponent == nullptr)
+	{
+		return;
+	}
+
+	this->refreshBoundarySolverProjection();
+
+	const FVector maxPhysics = this->boundarySolver.calculateReachForArmLength(this->maximumZoomLength); 
+	const FVector minPhysics = this->boundarySolver.calculateReachForArmLength(this->minimumZoomLength);
+
+	const float lateralReachFactor = this->boundarySolver.getLateralReachFactor();
+	const float forwardReachFactor = this->boundarySolver.getForwardReachFactor();
+	const float backwardReachFactor = this->boundarySolver.getBackwardReachFactor();
+
+	const float lateralAngleDeg = FMath::RadiansToDegrees(FMath::Atan(lateralReachFactor));
+	const float forwardAngleDeg = FMath::RadiansToDegrees(FMath::Atan(forwardReachFactor));
+	const float backwardAngleDeg = FMath::RadiansToDegrees(FMath::Atan(backwardReachFactor));
+
+	UE_LOG(LogRTSCamera, Warning, TEXT("=== 边界溢出诊断报告 (V14 - 全程线性版) ==="));
+	UE_LOG(LogRTSCamera, Warning, TEXT("俯仰基准: %.1f | 溢出阈值 (MapOverflowUU): %.1f"), this->startingPitchAngle, mapOverflowDistance);
+	UE_LOG(LogRTSCamera, Warning, TEXT("[预计算系数] Lateral: %.4f (%.2f°) | Forward: %.4f (%.2f°) | Backward: %.4f (%.2f°)"), 
+		lateralReachFactor, lateralAngleDeg, forwardReachFactor, forwardAngleDeg, backwardReachFactor, backwardAngleDeg);
+
+	UE_LOG(LogRTSCamera, Warning, TEXT("[高空 Zmax=%.1f] 东西补偿 (Reach-O): %.1f | 南北补偿 (Reach-O): %.1f"), maxPhysics.X, maxPhysics.Y - mapOverflowDistance, maxPhysics.Z - mapOverflowDistance);
+	UE_LOG(LogRTSCamera, Warning, TEXT("[低空 Zmin=%.1f] 东西补偿 (Reach-O): %.1f | 南北补偿 (Reach-O): %.1f"), minPhysics.X, minPhysics.Y - mapOverflowDistance, minPhysics.Z - mapOverflowDistance);
+	UE_LOG(LogRTSCamera, Warning, TEXT("--- 线性偏置计算 (y = kz + b) ---"));
+	UE_LOG(LogRTSCamera, Warning, TEXT("东西向 (Y) 补偿范围: %.1f -> %.1f"), minPhysics.Y - mapOverflowDistance, maxPhysics.Y - mapOverflowDistance);
+	UE_LOG(LogRTSCamera, Warning, TEXT("南北向 (X) 补偿范围: %.1f -> %.1f"), minPhysics.Z - mapOverflowDistance, maxPhysics.Z - mapOverflowDistance);
+	UE_LOG(LogRTSCamera, Warning, TEXT("========================================="));
+}
+
+void URTSCamera::refreshBoundarySolverProjection()
+{
+	if (this->cameraComponent == nullptr || this->springArmComponent == nullptr)
+	{
+		return;
+	}
+
+	const float aspectRatioValue = (this->cachedViewportSize.Y > 0.0f)
+		? (this->cachedViewportSize.X / this->cachedViewportSize.Y)
+		: this->cameraComponent->AspectRatio;
+
+	this->boundarySolver.setProjection(this->cameraComponent->FieldOfView, this->springArmComponent->GetRelativeRotation().Pitch, aspectRatioValue);
+	this->boundarySolver.setConstraintSettings(
+		this->boundaryTransitionZoneRatio,
+		this->minimumZoomBoundaryConstraint,
+		this->bEnableXBoundaryConstraint,
+		this->bEnableYBoundaryConstraint
+	);
+}
+
+void URTSCamera::buildTerrainHeightCache()
+{
+	/// 以边界区域为范围请求该区域的共享高度场；网格在子系统中分帧构建，之后的高度校正在缓存命中时完全绕过物理查询
+	if (!this->enableDynamicCameraHeight || !this->enableTerrainHeightCache || !this->boundarySolver.hasRegion() || this->movementBoundaryVolume == nullptr)
+	{
+		return;
+	}
+
+	this->terrainHeightfield = this->GetWorld()->GetSubsystem<URTSTerrainHeightfieldSubsystem>();
+	if (this->terrainHeightfield == nullptr)
+	{
+		return;
+	}
+
+	const FVector& boxOrigin = this->boundarySolver.getRegionOrigin();
+	const FVector& boxExtents = this->boundarySolver.getRegionExtents();
+	this->terrainHeightfield->BuildHeightfield(
+		this->movementBoundaryVolume,
+		FBox2D(FVector2D(boxOrigin.X - boxExtents.X, boxOrigin.Y - boxExtents.Y), FVector2D(boxOrigin.X + boxExtents.X, boxOrigin.Y + boxExtents.Y)),
+		this->terrainHeightCacheCellSize,
+		this->collisionChannel,
+		boxOrigin.Z + boxExtents.Z + this->findGroundTraceLength,
+		boxOrigin.Z - boxExtents.Z - this->findGroundTraceLength
+	);
+}
+
+void URTSCamera::configureInputModeForEdgeScrolling()
+{
+	/// 当鼠标用于边缘滚动时，强制应用视口锁定策略
+	if (this->enableEdgeScrolling)
+	{
+		FInputModeGameAndUI gameModeSettings;
+		gameModeSettings.SetLockMouseToViewportBehavior(EMouseLockMode::LockAlways);
+		gameModeSettings.SetHideCursorDuringCapture(false);
+		this->realTimeStrategyPlayerController->SetInputMode(gameModeSettings);
+	}
+}
+
+void URTSCamera::validateEnhancedInputAvailability()
+{
+	/// 校验当前的 InputComponent 是否兼容 Enhanced Input 语法
+	if (Cast<UEnhancedInputComponent>(this->realTimeStrategyPlayerController->InputComponent) == nullptr)
+	{
+		UKismetSystemLibrary::PrintString(
+			this->GetWorld(),
+			TEXT("Warning: RTSCamera requires Enhanced Input Component! Check Project Settings."), true, true,
+			FLinearColor::Red,
+			100
+		);
+	}
+}
+
+void URTSCamera::registerInputMappingContext()
+{
+	/// 向玩家输入子系统注册相机专用的映射上下文
+	if (this->realTimeStrategyPlayerController && this->realTimeStrategyPlayerController->GetLocalPlayer())
+	{
+		if (const auto inputSystem = this->realTimeStrategyPlayerController->GetLocalPlayer()->GetSubsystem<UEnhancedInputLocalPlayerSubsystem>())
+		{
+			this->realTimeStrategyPlayerController->bShowMouseCursor = true;
+
+			if (!inputSystem->HasMappingContext(this->inputMappingContext))
+			{
+				inputSystem->AddMappingContext(this->inputMappingContext, 0);
+			}
+		}
+	}
+}
+
+void URTSCamera::bindActionCallbacks()
+{
+	/// 执行运动指令与 C++ 响应函数的逻辑挂挂接
+	if (const auto enhancedInputComponent = Cast<UEnhancedInputComponent>(this->realTimeStrategyPlayerController->InputComponent))
+	{
+		enhancedInputComponent->BindAction(this->zoomCameraAction, ETriggerEvent::Triggered, this, &URTSCamera::onZoomCameraActionTriggered);
+		enhancedInputComponent->BindAction(this->rotateCameraAxisAction, ETriggerEvent::Triggered, this, &URTSCamera::onRotateCameraActionTriggered);
+		enhancedInputComponent->BindAction(this->turnCameraLeftAction, ETriggerEvent::Triggered, this, &URTSCamera::onTurnCameraLeftActionTriggered);
+		enhancedInputComponent->BindAction(this->turnCameraRightAction, ETriggerEvent::Triggered, this, &URTSCamera::onTurnCameraRightActionTriggered);
+		enhancedInputComponent->BindAction(this->moveCameraXAxisAction, ETriggerEvent::Triggered, this, &URTSCamera::onMoveCameraXAxisActionTriggered);
+		enhancedInputComponent->BindAction(this->moveCameraYAxisAction, ETriggerEvent::Triggered, this, &URTSCamera::onMoveCameraYAxisActionTriggered);
+		enhancedInputComponent->BindAction(this->dragCameraAction, ETriggerEvent::Triggered, this, &URTSCamera::onDragCameraActionTriggered);
+	}
+}
+
+void URTSCamera::setActiveCamera()
+{
+	/// 将玩家当前的渲染视角强制聚焦于此组件
+	this->realTimeStrategyPlayerController->SetViewTarget(this->GetOwner());
+}
+
+void URTSCamera::jumpTo(const FVector position)
+{
+	/// 跨越当前视野的跳转视为瞬移：立即在目标处登记流送源，且该次位移不计入平移速度
+	if (this->bRegisteredStreamingSourceProvider)
+	{
+		const FVector rootLocation = this->rootComponent->GetComponentLocation();
+		FVector viewCenter = rootLocation;
+		float viewRadius = 0.0f;
+		const bool bHasView = this->calculateFrustumGroundCircle(viewCenter, viewRadius);
+		if (!bHasView || FVector2D::DistSquared(FVector2D(position), FVector2D(rootLocation)) > FMath::Square(viewRadius))
+		{
+			/// 视野中心相对根坐标的偏移（俯仰造成的前移）在跳转后保持不变
+			const FVector viewOffset = viewCenter - rootLocation;
+			this->requestStreamingPrefetch(FVector(position.X + viewOffset.X, position.Y + viewOffset.Y, viewCenter.Z));
+			this->bStreamingVelocityResetRequested = true;
+		}
+	}
+
+	/// 仅改写暂存目标的 X/Y，约束、地形校正与视野广播统一由 Tick 末尾的提交阶段完成
+	FVector& stagedLocation = this->acquireStagedRootLocation();
+	stagedLocation.X = position.X;
+	stagedLocation.Y = position.Y;
+	this->bMinimapFrustumRefreshRequested = true;
+	this->bSimulationTeleportPending = true;
+	this->bRegionLookupRequested = true;
+	this->wakeCameraTick();
+}
+
+FVector& URTSCamera::acquireStagedRootLocation()
+{
+	/// 每帧首个运动来源从根组件同步一次起点，之后所有来源都在同一个暂存值上叠加
+	if (!this->bHasStagedRootLocation)
+	{
+		this->stagedRootLocation = this->rootComponent->GetComponentLocation();
+		this->bHasStagedRootLocation = true;
+	}
+	return this->stagedRootLocation;
+}
+
+void URTSCamera::commitStagedCameraMotion()
+{
+	/// 单次提交：地形校正、边界约束与 SocketOffset 在暂存值上计算，之后只写一次世界变换
+	FVector committedLocation = this->stageCommitLocation();
+	this->applyBoundaryConstraints(committedLocation);
+	this->finishStagedCommit(committedLocation, nullptr);
+}
+
+FVector URTSCamera::stageCommitLocation()
+{
+	FVector committedLocation = this->bHasStagedRootLocation
+		? this->stagedRootLocation
+		: this->rootComponent->GetComponentLocation();
+
+	if (this->enableAsyncGroundProbes)
+	{
+		this->consumeAsyncGroundProbes();
+	}
+
+	this->resolvePendingRegionLookup();
+	if (this->boundarySolver.hasRegion() && this->springArmComponent != nullptr)
+	{
+		this->refreshBoundarySolverProjection();
+		this->rectifyRootHeightFromTerrain(committedLocation);
+	}
+	return committedLocation;
+}
+
+void URTSCamera::finishStagedCommit(const FVector& committedLocation, const FVector* precomputedFrustumPoints)
+{
+	this->rootComponent->SetWorldLocation(committedLocation);
+	this->bHasStagedRootLocation = false;
+	if (this->enableTerrainArmAvoidance && this->terrainHeightfield != nullptr)
+	{
+		this->updateTerrainArmAvoidance();
+	}
+	if (this->bRegisteredStreamingSourceProvider)
+	{
+		this->updateStreamingPanVelocity(committedLocation);
+	}
+
+	/// 统计从首个输入采样到变换写回的耗时；延迟更新模式下该值应接近零
+	if (this->earliestPendingInputSeconds > 0.0)
+	{
+		SET_FLOAT_STAT(STAT_RTSCameraInputToCommitLatency, (FPlatformTime::Seconds() - this->earliestPendingInputSeconds) * 1000.0);
+		this->earliestPendingInputSeconds = 0.0;
+	}
+
+	/// 变换确定后才投射視野框，保证每帧至多广播一次
+	this->resolvePendingMinimapFrustum(precomputedFrustumPoints);
+	this->publishCameraSnapshot();
+	if (!this->bIsReplaying && this->replayBuffer.isInitialized())
+	{
+		this->recordReplaySample(committedLocation);
+	}
+
+	/// 最终变换与视野四角确定后，整批提交下一帧需要的地面探针
+	if (this->enableAsyncGroundProbes && this->enableDynamicCameraHeight)
+	{
+		this->submitAsyncGroundProbes();
+	}
 }
 
 void URTSCamera::executeEdgeScrollingEvaluation()
 {
-	/// 仅在功能开启且未进行拖拽干扰时，执行屏幕边缘检测
-	if (this->enableEdgeScrolling && !this->isDragging)
+	/// 仅在功能开启且未进行拖拽干扰时，执行屏幕边缘检测；画中画相机不响应主视口的光标
+	this->bEdgeScrollActiveThisTick = false;
+	if (this->enableEdgeScrolling && !this->isDragging && this->isViewedByLocalPlayer())
 	{
-		const FVector locationBeforePush = this->rootComponent->GetComponentLocation();
-		
-		this->performEdgeScrollLeft();
-		this->performEdgeScrollRight();
-		this->performEdgeScrollUp();
-		this->performEdgeScrollDown();
+		FVector2D cursorPosition;
+		if (!this->sampleCursorInViewport(cursorPosition))
+		{
+			this->edgeScrollDwellSeconds = 0.0f;
+			return;
+		}
+
+		/// 单次求值：四个边缘的推力合成为一个二维向量（X 为右向，Y 为前向）
+		FVector2D pushVector = this->calculateEdgeScrollPush(cursorPosition);
+		if (pushVector.IsNearlyZero())
+		{
+			this->edgeScrollDwellSeconds = 0.0f;
+			return;
+		}
+
+		if (this->normalizeDiagonalEdgeScroll && pushVector.SizeSquared() > 1.0f)
+		{
+			pushVector.Normalize();
+		}
+
+		/// 停留在边缘的时长经加速曲线放大推力
+		this->edgeScrollDwellSeconds += this->deltaSeconds;
+		float accelerationScale = 1.0f;
+		if (this->edgeScrollAccelerationCurve != nullptr)
+		{
+			accelerationScale = this->edgeScrollAccelerationCurve->GetFloatValue(this->edgeScrollDwellSeconds);
+		}
+
+		/// 只读取一次朝向并只写一次暂存坐标
+		const float pushDistance = this->currentMovementSpeed * accelerationScale * this->deltaSeconds;
+		const FVector rightVector = this->rootComponent->GetRightVector();
+		const FVector forwardVector = this->rootComponent->GetForwardVector();
+		this->acquireStagedRootLocation() += (rightVector * pushVector.X + forwardVector * pushVector.Y) * pushDistance;
+
+		this->bEdgeScrollActiveThisTick = true;
+		this->markInputSampled();
+		this->bMinimapFrustumRefreshRequested = true;
+	}
+	else
+	{
+		this->edgeScrollDwellSeconds = 0.0f;
+	}
+}
 
-		if (!this->rootComponent->GetComponentLocation().Equals(locationBeforePush, 0.1f))
+FVector2D URTSCamera::calculateEdgeScrollPush(const FVector2D& cursorPosition) const
+{
+	const float edgeWidth = this->cachedViewportSize.X * this->distanceFromEdgeThreshold;
+	const float edgeHeight = this->cachedViewportSize.Y * this->distanceFromEdgeThreshold;
+	if (edgeWidth <= 0.0f || edgeHeight <= 0.0f)
+	{
+		return FVector2D::ZeroVector;
+	}
+
+	/// 各边缘的侵入深度归一化到 [0, 1]，再经可选响应曲线映射为推力强度
+	auto shapePenetration = [this](const float penetration) -> float
+	{
+		const float clampedPenetration = FMath::Clamp(penetration, 0.0f, 1.0f);
+		if (clampedPenetration <= 0.0f || this->edgeScrollResponseCurve == nullptr)
 		{
-			this->updateMinimapFrustum();
+			return clampedPenetration;
 		}
+		return this->edgeScrollResponseCurve->GetFloatValue(clampedPenetration);
+	};
+
+	const float leftAlpha = shapePenetration(1.0f - cursorPosition.X / edgeWidth);
+	const float rightAlpha = shapePenetration((cursorPosition.X - (this->cachedViewportSize.X - edgeWidth)) / edgeWidth);
+	const float upAlpha = shapePenetration(1.0f - cursorPosition.Y / edgeHeight);
+	const float downAlpha = shapePenetration((cursorPosition.Y - (this->cachedViewportSize.Y - edgeHeight)) / edgeHeight);
+
+	return FVector2D(rightAlpha - leftAlpha, upAlpha - downAlpha);
+}
+
+bool URTSCamera::sampleCursorInViewport(FVector2D& outCursorPosition) const
+{
+	/// Tick 内优先复用本帧由原始输入汇总出的光标位置
+	if (this->bHasDrainedCursorPosition)
+	{
+		outCursorPosition = this->drainedCursorPosition;
+		return true;
+	}
+
+	/// 一次光标查询，坐标与缓存的视口尺寸同为像素空间
+	if (this->realTimeStrategyPlayerController == nullptr || this->cachedViewportSize.X <= 0.0f || this->cachedViewportSize.Y <= 0.0f)
+	{
+		return false;
+	}
+
+	float mouseX = 0.0f;
+	float mouseY = 0.0f;
+	if (!this->realTimeStrategyPlayerController->GetMousePosition(mouseX, mouseY))
+	{
+		return false;
+	}
+
+	outCursorPosition = FVector2D(mouseX, mouseY);
+	return true;
+}
+
+void URTSCamera::refreshCachedViewportSize()
+{
+	/// 视口尺寸只在初始化与尺寸变化事件中读取，Tick 内不再查询 Slate 几何
+	if (const UGameViewportClient* gameViewport = this->GetWorld()->GetGameViewport())
+	{
+		if (gameViewport->Viewport != nullptr)
+		{
+			const FIntPoint viewportSize = gameViewport->Viewport->GetSizeXY();
+			this->cachedViewportSize = FVector2D(viewportSize.X, viewportSize.Y);
+		}
+	}
+}
+
+void URTSCamera::handleViewportResized(FViewport* viewport, uint32)
+{
+	const UGameViewportClient* gameViewport = this->GetWorld() ? this->GetWorld()->GetGameViewport() : nullptr;
+	if (gameViewport != nullptr && viewport == gameViewport->Viewport)
+	{
+		this->refreshCachedViewportSize();
+		this->bMinimapFrustumRefreshRequested = true;
+		this->wakeCameraTick();
 	}
 }
 
-void URTSCamera::performEdgeScrollLeft()
+bool URTSCamera::isCameraMotionIdle()
 {
-	/// 基于鼠标左偏移计算平移推力
-	const auto mousePosition = UWidgetLayoutLibrary::GetMousePositionOnViewport(this->GetWorld());
-	const auto viewportSize = UWidgetLayoutLibrary::GetViewportWidgetGeometry(this->GetWorld()).GetLocalSize();
-	const auto normalizedValue = 1 - UKismetMathLibrary::NormalizeToRange(mousePosition.X, 0.0f, viewportSize.X * this->distanceFromEdgeThreshold);
+	/// 任一运动来源仍然活跃时保持 Tick
+	if (this->isDragging || this->bEdgeScrollActiveThisTick || this->activeCameraFollowTarget != nullptr || (this->bIsReplaying && this->replayPlaybackRate != 0.0f))
+	{
+		return false;
+	}
+
+	if (this->pendingMovementCommands.Num() > 0 || this->bMinimapFrustumRefreshRequested)
+	{
+		return false;
+	}
+
+	/// 缩放收敛后直接吸附到意图长度，避免 FInterpTo 的渐近尾巴让相机永远无法入睡
+	if (!FMath::IsNearlyEqual(this->springArmComponent->TargetArmLength, this->desiredZoomLength, this->idleZoomConvergenceTolerance))
+	{
+		return false;
+	}
+	this->springArmComponent->TargetArmLength = this->desiredZoomLength;
+
+	/// 固定步长模式下前后两个模拟状态一致才算收敛，否则插值仍在推进
+	if (this->enableFixedTimestepSimulation)
+	{
+		if (!this->previousSimulatedPlanarLocation.Equals(this->currentSimulatedPlanarLocation))
+		{
+			return false;
+		}
+		this->previousSimulatedArmLength = this->desiredZoomLength;
+		this->currentSimulatedArmLength = this->desiredZoomLength;
+	}
 
-	const float alpha = UKismetMathLibrary::FClamp(normalizedValue, 0.0, 1.0);
-	this->rootComponent->AddRelativeLocation(-1 * this->rootComponent->GetRightVector() * alpha * this->currentMovementSpeed * this->deltaSeconds);
+	/// 地形避让的抬升量仍在过渡时继续 Tick
+	if (!FMath::IsNearlyEqual(this->terrainAvoidanceLift, this->terrainAvoidanceTargetLift, 1.0f))
+	{
+		return false;
+	}
+
+	/// 异步高度平滑尚未追上探针结果时继续 Tick
+	if (this->enableAsyncGroundProbes && this->asyncGroundProbeValid[rootGroundProbeSlot]
+		&& !FMath::IsNearlyEqual(this->rootComponent->GetComponentLocation().Z, this->asyncGroundProbeHeights[rootGroundProbeSlot], 1.0f))
+	{
+		return false;
+	}
+
+	return true;
 }
 
-void URTSCamera::performEdgeScrollRight()
+void URTSCamera::enterIdleTickSleep()
 {
-	/// 基于鼠标右偏移计算平移推力
-	const auto mousePosition = UWidgetLayoutLibrary::GetMousePositionOnViewport(this->GetWorld());
-	const auto viewportSize = UWidgetLayoutLibrary::GetViewportWidgetGeometry(this->GetWorld()).GetLocalSize();
-	const auto normalizedValue = UKismetMathLibrary::NormalizeToRange(mousePosition.X, viewportSize.X * (1 - this->distanceFromEdgeThreshold), viewportSize.X);
+	/// 关闭自身 Tick（由管理器推进时只需标记，管理器会跳过休眠中的相机）；开启边缘滚动时改由低频定时器监视光标
+	if (this->cameraManager == nullptr)
+	{
+		this->SetComponentTickEnabled(false);
+	}
+	this->bIsTickSleeping = true;
 
-	const float alpha = UKismetMathLibrary::FClamp(normalizedValue, 0.0, 1.0);
-	this->rootComponent->AddRelativeLocation(this->rootComponent->GetRightVector() * alpha * this->currentMovementSpeed * this->deltaSeconds);
+	/// 静止后不再外推视野；唤醒后的首次提交重新建立速度基准
+	this->streamingPanVelocity = FVector2D::ZeroVector;
+	this->bHasStreamingVelocitySample = false;
+
+	if (this->enableEdgeScrolling)
+	{
+		this->GetWorld()->GetTimerManager().SetTimer(
+			this->idleEdgeScrollProbeTimerHandle,
+			this,
+			&URTSCamera::probeEdgeScrollZoneWhileIdle,
+			this->idleEdgeScrollProbeInterval,
+			true
+		);
+	}
 }
 
-void URTSCamera::performEdgeScrollUp()
+void URTSCamera::wakeCameraTick()
 {
-	/// 基于鼠标上偏移计算平移推力
-	const auto mousePosition = UWidgetLayoutLibrary::GetMousePositionOnViewport(this->GetWorld());
-	const auto viewportSize = UWidgetLayoutLibrary::GetViewportWidgetGeometry(this->GetWorld()).GetLocalSize();
-	const auto normalizedValue = UKismetMathLibrary::NormalizeToRange(mousePosition.Y, 0.0f, viewportSize.Y * this->distanceFromEdgeThreshold);
+	/// 从休眠中恢复逐帧更新，并停止边缘区域探测
+	if (!this->bIsTickSleeping)
+	{
+		return;
+	}
 
-	const float alpha = 1 - UKismetMathLibrary::FClamp(normalizedValue, 0.0, 1.0);
-	this->rootComponent->AddRelativeLocation(this->rootComponent->GetForwardVector() * alpha * this->currentMovementSpeed * this->deltaSeconds);
+	this->bIsTickSleeping = false;
+	this->simulationTimeAccumulator = 0.0f;
+	this->resetRawPointerInput();
+	if (const UWorld* world = this->GetWorld())
+	{
+		world->GetTimerManager().ClearTimer(this->idleEdgeScrollProbeTimerHandle);
+		world->GetTimerManager().ClearTimer(this->viewTargetProbeTimerHandle);
+	}
+	if (this->cameraManager != nullptr)
+	{
+		this->cameraManager->NotifyCameraAwake(this);
+	}
+	else
+	{
+		this->SetComponentTickEnabled(true);
+	}
 }
 
-void URTSCamera::performEdgeScrollDown()
+void URTSCamera::probeEdgeScrollZoneWhileIdle()
 {
-	/// 基于鼠标下偏移计算平移推力
-	const auto mousePosition = UWidgetLayoutLibrary::GetMousePositionOnViewport(this->GetWorld());
-	const auto viewportSize = UWidgetLayoutLibrary::GetViewportWidgetGeometry(this->GetWorld()).GetLocalSize();
-	const auto normalizedValue = UKismetMathLibrary::NormalizeToRange(mousePosition.Y, viewportSize.Y * (1 - this->distanceFromEdgeThreshold), viewportSize.Y);
+	/// 仅读取一次光标位置，进入边缘区域即唤醒
+	if (!this->isDragging && this->isCursorInsideEdgeScrollZone())
+	{
+		this->wakeCameraTick();
+	}
+}
 
-	const float alpha = UKismetMathLibrary::FClamp(normalizedValue, 0.0, 1.0);
-	this->rootComponent->AddRelativeLocation(-1 * this->rootComponent->GetForwardVector() * alpha * this->currentMovementSpeed * this->deltaSeconds);
+bool URTSCamera::isCursorInsideEdgeScrollZone() const
+{
+	FVector2D cursorPosition;
+	return this->sampleCursorInViewport(cursorPosition) && !this->calculateEdgeScrollPush(cursorPosition).IsNearlyZero();
 }
 
 void URTSCamera::updateFollowPositionIfTargetActive()
 {
-	/// 将相机根坐标强行锚定在追随目标之上
-	if (this->activeCameraFollowTarget != nullptr)
+	/// 将相机根坐标强行锚定在追随目标之上。跟随是连续运动而非瞬移：只改写暂存坐标，不标记瞬移，
+	/// 固定步长模拟因此照常在两步之间插值
+	if (this->activeCameraFollowTarget == nullptr)
+	{
+		return;
+	}
+
+	const FVector targetLocation = this->activeCameraFollowTarget->GetActorLocation();
+	FVector& stagedLocation = this->acquireStagedRootLocation();
+	stagedLocation.X = targetLocation.X;
+	stagedLocation.Y = targetLocation.Y;
+	this->bMinimapFrustumRefreshRequested = true;
+
+	/// 只有目标离开当前区域时才需要重新查询区域
+	const FVector2D targetPlanarLocation(targetLocation);
+	if (!this->boundarySolver.clampPlanarLocation(targetPlanarLocation).Equals(targetPlanarLocation, 1.0f))
+	{
+		this->bRegionLookupRequested = true;
+	}
+}
+
+void URTSCamera::runFixedTimestepSimulation(float frameDeltaSeconds)
+{
+	const float stepSeconds = 1.0f / FMath::Max(this->fixedSimulationRate, 1.0f);
+	const float rootAltitude = this->rootComponent->GetComponentLocation().Z;
+
+	/// 首帧或 Actor 被外部直接移动时，以当前变换重新初始化两个模拟状态
+	const FVector2D rootPlanarLocation(this->rootComponent->GetComponentLocation());
+	const float renderedArmLengthLastFrame = this->springArmComponent->TargetArmLength;
+	if (!this->bSimulationStateInitialized || !rootPlanarLocation.Equals(this->simulationRenderedPlanarLocation, 1.0f))
+	{
+		this->previousSimulatedPlanarLocation = rootPlanarLocation;
+		this->currentSimulatedPlanarLocation = rootPlanarLocation;
+		this->previousSimulatedArmLength = this->springArmComponent->TargetArmLength;
+		this->currentSimulatedArmLength = this->springArmComponent->TargetArmLength;
+		this->bSimulationStateInitialized = true;
+	}
+
+	/// 帧间的跳转请求（小地图点击等）直接瞬移两个状态
+	if (this->bHasStagedRootLocation)
+	{
+		this->currentSimulatedPlanarLocation = this->boundarySolver.clampPlanarLocation(FVector2D(this->stagedRootLocation));
+		this->previousSimulatedPlanarLocation = this->currentSimulatedPlanarLocation;
+		this->bSimulationTeleportPending = false;
+	}
+
+	/// 累积时间并限制单帧步数，长时间卡顿后丢弃超出部分而不是追帧
+	this->simulationTimeAccumulator += frameDeltaSeconds;
+	int32 stepCount = FMath::FloorToInt(this->simulationTimeAccumulator / stepSeconds);
+	if (stepCount > this->maxSimulationSubSteps)
+	{
+		stepCount = FMath::Max(this->maxSimulationSubSteps, 1);
+		this->simulationTimeAccumulator = stepCount * stepSeconds + FMath::Fmod(this->simulationTimeAccumulator, stepSeconds);
+	}
+
+	/// 本帧的平移指令折算为按住的速度，每一步积分一次，位移与显示帧率无关
+	const FVector2D heldMovementVelocity = this->resolveMovementCommandVelocity();
+	this->pendingMovementCommands.Reset();
+
+	this->deltaSeconds = stepSeconds;
+	for (int32 stepIndex = 0; stepIndex < stepCount; ++stepIndex)
+	{
+		this->previousSimulatedPlanarLocation = this->currentSimulatedPlanarLocation;
+		this->previousSimulatedArmLength = this->currentSimulatedArmLength;
+
+		this->stagedRootLocation = FVector(this->currentSimulatedPlanarLocation, rootAltitude);
+		this->bHasStagedRootLocation = true;
+		this->springArmComponent->TargetArmLength = this->currentSimulatedArmLength;
+
+		if (!heldMovementVelocity.IsZero())
+		{
+			this->applyPlanarMovementVelocity(heldMovementVelocity);
+		}
+		this->executeEdgeScrollingEvaluation();
+		this->handleTargetArmLengthInterpolation();
+		this->updateFollowPositionIfTargetActive();
+
+		/// 每一步都钳制到边界内，插值端点始终合法
+		this->currentSimulatedPlanarLocation = this->boundarySolver.clampPlanarLocation(FVector2D(this->stagedRootLocation));
+		this->currentSimulatedArmLength = this->springArmComponent->TargetArmLength;
+
+		if (this->bSimulationTeleportPending)
+		{
+			this->previousSimulatedPlanarLocation = this->currentSimulatedPlanarLocation;
+			this->bSimulationTeleportPending = false;
+		}
+	}
+	this->simulationTimeAccumulator -= stepCount * stepSeconds;
+	this->deltaSeconds = frameDeltaSeconds;
+
+	/// 渲染状态 = 上一步与当前步之间按剩余时间比例插值
+	const float interpolationAlpha = FMath::Clamp(this->simulationTimeAccumulator / stepSeconds, 0.0f, 1.0f);
+	const FVector2D renderedPlanarLocation = FMath::Lerp(this->previousSimulatedPlanarLocation, this->currentSimulatedPlanarLocation, interpolationAlpha);
+	const float renderedArmLength = FMath::Lerp(this->previousSimulatedArmLength, this->currentSimulatedArmLength, interpolationAlpha);
+
+	if (!renderedPlanarLocation.Equals(rootPlanarLocation) || !FMath::IsNearlyEqual(renderedArmLength, renderedArmLengthLastFrame))
 	{
-		this->jumpTo(this->activeCameraFollowTarget->GetActorLocation());
+		this->bMinimapFrustumRefreshRequested = true;
 	}
+
+	this->stagedRootLocation = FVector(renderedPlanarLocation, rootAltitude);
+	this->bHasStagedRootLocation = true;
+	this->springArmComponent->TargetArmLength = renderedArmLength;
 }
 
 void URTSCamera::handleTargetArmLengthInterpolation()
@@ -545,209 +1426,674 @@ void URTSCamera::handleTargetArmLengthInterpolation()
 	);
 }
 
-void URTSCamera::rectifyRootHeightFromTerrain()
+void URTSCamera::updateTerrainArmAvoidance()
 {
-	/// 射线补偿检测：使根节点坐标实时贴合地形海拔
+	SCOPE_CYCLE_COUNTER(STAT_RTSCameraTerrainArmAvoidance);
+
+	/// 不含抬升量的弹簧臂端点：枢轴位于弹簧臂原点 + TargetOffset，相机位于枢轴沿臂反方向 TargetArmLength 处再加 SocketOffset
+	const FQuat armRotation = this->springArmComponent->GetComponentQuat();
+	const FVector targetOffset(this->springArmComponent->TargetOffset.X, this->springArmComponent->TargetOffset.Y, this->terrainAvoidanceBaseOffsetZ);
+	const FVector pivotLocation = this->springArmComponent->GetComponentLocation() + targetOffset;
+	const FVector cameraLocation = pivotLocation
+		- armRotation.GetForwardVector() * this->springArmComponent->TargetArmLength
+		+ armRotation.RotateVector(this->springArmComponent->SocketOffset);
+
+	/// 整条弹簧臂整体抬升，所需抬升量为各采样点处 地面高度 + 间隙 - 弹簧臂高度 的最大值
+	float requiredLift = 0.0f;
+	const int32 sampleCount = FMath::Clamp(this->terrainArmSampleCount, 1, 8);
+	for (int32 sampleIndex = 1; sampleIndex <= sampleCount; ++sampleIndex)
+	{
+		const FVector sampleLocation = FMath::Lerp(pivotLocation, cameraLocation, static_cast<float>(sampleIndex) / sampleCount);
+		float groundHeight = 0.0f;
+		if (this->terrainHeightfield->GetGroundHeightAt(this->movementBoundaryVolume, sampleLocation.X, sampleLocation.Y, groundHeight))
+		{
+			requiredLift = FMath::Max(requiredLift, groundHeight + this->terrainArmClearance - static_cast<float>(sampleLocation.Z));
+		}
+	}
+	this->terrainAvoidanceTargetLift = requiredLift;
+
+	const float interpolationSpeed = requiredLift > this->terrainAvoidanceLift ? this->terrainArmRaiseSpeed : this->terrainArmLowerSpeed;
+	this->terrainAvoidanceLift = interpolationSpeed > 0.0f
+		? FMath::FInterpTo(this->terrainAvoidanceLift, requiredLift, this->deltaSeconds, interpolationSpeed)
+		: requiredLift;
+	if (FMath::IsNearlyEqual(this->terrainAvoidanceLift, requiredLift, 1.0f))
+	{
+		this->terrainAvoidanceLift = requiredLift;
+	}
+
+	this->springArmComponent->TargetOffset.Z = this->terrainAvoidanceBaseOffsetZ + this->terrainAvoidanceLift;
+}
+
+void URTSCamera::rectifyRootHeightFromTerrain(FVector& rootLocation)
+{
+	/// 射线补偿检测：使暂存的根坐标贴合地形海拔
 	if (this->enableDynamicCameraHeight)
 	{
-		const FVector currentRootXYZ = this->rootComponent->GetComponentLocation();
-		const TArray<AActor*> excludedActors;
+		/// 高度场命中时直接取插值高度，未覆盖或未命中的位置回退到射线检测
+		float cachedGroundHeight = 0.0f;
+		if (this->terrainHeightfield != nullptr && this->terrainHeightfield->GetGroundHeightAt(this->movementBoundaryVolume, rootLocation.X, rootLocation.Y, cachedGroundHeight))
+		{
+			rootLocation.Z = cachedGroundHeight;
+			return;
+		}
 
-		FHitResult floorHit;
-		const bool bValidFloor = UKismetSystemLibrary::LineTraceSingle(
-			this->GetWorld(),
-			FVector(currentRootXYZ.X, currentRootXYZ.Y, currentRootXYZ.Z + this->findGroundTraceLength),
-			FVector(currentRootXYZ.X, currentRootXYZ.Y, currentRootXYZ.Z - this->findGroundTraceLength),
-			UEngineTypes::ConvertToTraceType(this->collisionChannel),
-			true,
-			excludedActors,
-			EDrawDebugTrace::None,
-			floorHit,
-			true
-		);
+		/// 异步模式：平滑追赶上一帧批次返回的高度，本帧不阻塞在物理场景上；
+		/// 首个批次返回前回退到同步射线，既修正高度，也为“节省耗时”统计测得单次射线成本
+		if (this->enableAsyncGroundProbes)
+		{
+			const int32 probeSlot = this->activeCameraFollowTarget != nullptr ? followTargetGroundProbeSlot : rootGroundProbeSlot;
+			if (this->asyncGroundProbeValid[probeSlot])
+			{
+				rootLocation.Z = this->asyncGroundHeightSmoothingSpeed > 0.0f
+					? FMath::FInterpTo(rootLocation.Z, this->asyncGroundProbeHeights[probeSlot], this->deltaSeconds, this->asyncGroundHeightSmoothingSpeed)
+					: this->asyncGroundProbeHeights[probeSlot];
+				INC_FLOAT_STAT_BY(STAT_RTSCameraSyncTraceTimeSaved, this->averageSyncGroundTraceSeconds * 1000.0);
+				return;
+			}
+		}
+
+		float groundHeight = 0.0f;
+		if (this->traceGroundHeightSynchronously(rootLocation, groundHeight))
+		{
+			rootLocation.Z = groundHeight;
+		}
+	}
+}
+
+bool URTSCamera::traceGroundHeightSynchronously(const FVector& probeLocation, float& outGroundHeight)
+{
+	SCOPE_CYCLE_COUNTER(STAT_RTSCameraSyncGroundTrace);
+	const double traceStartTime = FPlatformTime::Seconds();
+	const TArray<AActor*> excludedActors;
+
+	FHitResult floorHit;
+	const bool bValidFloor = UKismetSystemLibrary::LineTraceSingle(
+		this->GetWorld(),
+		FVector(probeLocation.X, probeLocation.Y, probeLocation.Z + this->findGroundTraceLength),
+		FVector(probeLocation.X, probeLocation.Y, probeLocation.Z - this->findGroundTraceLength),
+		UEngineTypes::ConvertToTraceType(this->collisionChannel),
+		true,
+		excludedActors,
+		EDrawDebugTrace::None,
+		floorHit,
+		true
+	);
+
+	/// 指数滑动平均，作为异步模式下“节省耗时”统计的单次射线成本
+	const double traceSeconds = FPlatformTime::Seconds() - traceStartTime;
+	this->averageSyncGroundTraceSeconds = this->averageSyncGroundTraceSeconds > 0.0
+		? FMath::Lerp(this->averageSyncGroundTraceSeconds, traceSeconds, 0.1)
+		: traceSeconds;
+
+	if (bValidFloor)
+	{
+		outGroundHeight = floorHit.Location.Z;
+	}
+	return bValidFloor;
+}
+
+void URTSCamera::consumeAsyncGroundProbes()
+{
+	/// 上一帧提交的批次在本帧已完成，逐槽读取结果；未命中的槽位保留旧值
+	const UWorld* world = this->GetWorld();
+	for (int32 probeIndex = 0; probeIndex < asyncGroundProbeCount; ++probeIndex)
+	{
+		FTraceHandle& probeHandle = this->asyncGroundProbeHandles[probeIndex];
+		if (!probeHandle.IsValid())
+		{
+			continue;
+		}
+
+		FTraceDatum probeResult;
+		if (world->QueryTraceData(probeHandle, probeResult))
+		{
+			if (probeResult.OutHits.Num() > 0 && probeResult.OutHits[0].bBlockingHit)
+			{
+				this->asyncGroundProbeHeights[probeIndex] = probeResult.OutHits[0].Location.Z;
+				this->asyncGroundProbeValid[probeIndex] = true;
+			}
+		}
+		probeHandle.Invalidate();
+	}
+}
+
+void URTSCamera::submitAsyncGroundProbes()
+{
+	/// 根坐标、视野四角与跟随目标合并为同一批次提交
+	FVector probeLocations[asyncGroundProbeCount];
+	bool probeRequested[asyncGroundProbeCount] = {};
+
+	const FVector rootLocation = this->rootComponent->GetComponentLocation();
+	probeLocations[rootGroundProbeSlot] = rootLocation;
+	probeRequested[rootGroundProbeSlot] = true;
+
+	for (int32 cornerIndex = 0; cornerIndex < 4; ++cornerIndex)
+	{
+		const FVector& corner = this->minimapFrustumPoints[cornerIndex];
+		probeLocations[firstFrustumGroundProbeSlot + cornerIndex] = FVector(corner.X, corner.Y, rootLocation.Z);
+		probeRequested[firstFrustumGroundProbeSlot + cornerIndex] = true;
+	}
 
-		if (bValidFloor)
+	if (this->activeCameraFollowTarget != nullptr)
+	{
+		const FVector targetLocation = this->activeCameraFollowTarget->GetActorLocation();
+		probeLocations[followTargetGroundProbeSlot] = FVector(targetLocation.X, targetLocation.Y, rootLocation.Z);
+		probeRequested[followTargetGroundProbeSlot] = true;
+	}
+
+	UWorld* world = this->GetWorld();
+	const FCollisionQueryParams queryParams(SCENE_QUERY_STAT(RTSCameraAsyncGroundProbe), true);
+	int32 submittedProbeCount = 0;
+	for (int32 probeIndex = 0; probeIndex < asyncGroundProbeCount; ++probeIndex)
+	{
+		if (!probeRequested[probeIndex])
 		{
-			this->rootComponent->SetWorldLocation(FVector(floorHit.Location.X, floorHit.Location.Y, floorHit.Location.Z));
+			continue;
 		}
+
+		const FVector& probeLocation = probeLocations[probeIndex];
+		this->asyncGroundProbeHandles[probeIndex] = world->AsyncLineTraceByChannel(
+			EAsyncTraceType::Single,
+			FVector(probeLocation.X, probeLocation.Y, probeLocation.Z + this->findGroundTraceLength),
+			FVector(probeLocation.X, probeLocation.Y, probeLocation.Z - this->findGroundTraceLength),
+			this->collisionChannel,
+			queryParams
+		);
+		++submittedProbeCount;
 	}
+	INC_DWORD_STAT_BY(STAT_RTSCameraAsyncGroundProbes, submittedProbeCount);
 }
 
 
 void URTSCamera::updateMinimapFrustum()
 {
-	/// 战略視野投影核心逻辑：直接基于相机的世界位姿计算四个角点。
-	if (this->cameraComponent == nullptr || this->rootComponent == nullptr) 
+	/// 显式调用时无视广播容差，但仍受每帧一次的广播限制
+	if (this->resolveMinimapFrustumPoints())
+	{
+		this->broadcastMinimapFrustum();
+	}
+}
+
+void URTSCamera::resolvePendingMinimapFrustum(const FVector* precomputedFrustumPoints)
+{
+	if (!this->bMinimapFrustumRefreshRequested)
 	{
 		return;
 	}
-	
-	// 核心：强制触发 SpringArm 及其子组件的世界变换计算
-	// 否则在同一帧内，GetComponentLocation 拿到的可能是修改 SocketOffset 之前的旧位置
-	// 但是我不认可这种逻辑，因为对小地图来说这不重要，我觉得是无稽之谈
-	// if (this->springArmComponent)
-	// {
-	// 	this->springArmComponent->UpdateComponentToWorld();
-	// }
-	// this->cameraComponent->UpdateComponentToWorld();
-
-	const FVector cameraLocation = this->cameraComponent->GetComponentLocation();
-	const FRotator cameraRotation = this->cameraComponent->GetComponentRotation();
-	
-	const float fieldOfViewValue = this->cameraComponent->FieldOfView;
-	
-	// 拒绝假设：动态获取视口尺寸计算长宽比
-	const FVector2D viewportSize = UWidgetLayoutLibrary::GetViewportSize(this->GetWorld());
-	float aspectRatioValue = (viewportSize.Y > 0.0f) ? (viewportSize.X / viewportSize.Y) : this->cameraComponent->AspectRatio;
-	if (this->cameraComponent->bConstrainAspectRatio)
+	this->bMinimapFrustumRefreshRequested = false;
+
+	/// 批量更新时角点已由管理器在任务线程上求出，直接采用
+	if (precomputedFrustumPoints != nullptr)
+	{
+		for (int32 cornerIndex = 0; cornerIndex < 4; ++cornerIndex)
+		{
+			this->minimapFrustumPoints[cornerIndex] = precomputedFrustumPoints[cornerIndex];
+		}
+	}
+	else if (!this->resolveMinimapFrustumPoints())
+	{
+		return;
+	}
+
+	/// 与上一次广播的角点比较，任一角点位移超过容差才通知订阅者
+	bool bMovedBeyondTolerance = !this->bHasBroadcastMinimapFrustum;
+	const float toleranceSquared = FMath::Square(this->minimapFrustumBroadcastTolerance);
+	for (int32 cornerIndex = 0; cornerIndex < 4 && !bMovedBeyondTolerance; ++cornerIndex)
+	{
+		bMovedBeyondTolerance = FVector::DistSquared(this->minimapFrustumPoints[cornerIndex], this->broadcastMinimapFrustumPoints[cornerIndex]) > toleranceSquared;
+	}
+
+	if (bMovedBeyondTolerance)
+	{
+		this->broadcastMinimapFrustum();
+	}
+}
+
+void URTSCamera::broadcastMinimapFrustum()
+{
+	/// 本帧已经广播过：推迟到下一帧提交阶段重新比较，订阅者每帧至多收到一次通知
+	if (this->bHasBroadcastMinimapFrustum && this->lastMinimapFrustumBroadcastFrame == GFrameCounter)
+	{
+		this->bMinimapFrustumRefreshRequested = true;
+		this->wakeCameraTick();
+		return;
+	}
+
+	for (int32 cornerIndex = 0; cornerIndex < 4; ++cornerIndex)
+	{
+		this->broadcastMinimapFrustumPoints[cornerIndex] = this->minimapFrustumPoints[cornerIndex];
+	}
+	this->bHasBroadcastMinimapFrustum = true;
+	this->lastMinimapFrustumBroadcastFrame = GFrameCounter;
+
+	/// 计算完成后发起视野更新广播
+	this->onMinimapFrustumUpdated.Broadcast();
+}
+
+bool URTSCamera::resolveMinimapFrustumPoints()
+{
+	/// 战略視野投影核心逻辑：由已提交的根坐标与弹簧臂参数解析出相机位姿，再计算四个角点。
+	if (this->cameraComponent == nullptr || this->rootComponent == nullptr || this->springArmComponent == nullptr) 
+	{
+		return false;
+	}
+
+	// 不读取相机组件的世界变换：弹簧臂在自身 Tick 中才会应用本帧的臂长与 SocketOffset，
+	// 且开启相机延迟时相机位置会滞后于意图。这里按弹簧臂的求解公式直接得到最终位姿，
+	// 臂长使用缩放意图，使视野框在缩放开始时即反映目标视野。
+	const FQuat armRotation = this->springArmComponent->GetComponentQuat();
+	const float armLength = (this->desiredZoomLength > 0.0f) ? this->desiredZoomLength : this->springArmComponent->TargetArmLength;
+	const FVector armOrigin = this->springArmComponent->GetComponentLocation() + this->springArmComponent->TargetOffset;
+	const FVector cameraLocation = armOrigin
+		- armRotation.GetForwardVector() * armLength
+		+ armRotation.RotateVector(this->springArmComponent->SocketOffset);
+	const FQuat cameraRotation = armRotation * this->cameraComponent->GetRelativeRotation().Quaternion();
+
+	float cornerAltitudes[4];
+	this->resolveFrustumCornerAltitudes(this->rootComponent->GetComponentLocation().Z, cornerAltitudes);
+
+	/// 填充战略投影点数组
+	projectFrustumGroundCorners(cameraLocation, cameraRotation, this->cameraComponent->FieldOfView, this->calculateFrustumAspectRatio(), cornerAltitudes, this->minimapFrustumPoints);
+	return true;
+}
+
+float URTSCamera::calculateFrustumAspectRatio() const
+{
+	// 拒绝假设：使用随视口尺寸变化事件刷新的缓存计算长宽比
+	if (this->cameraComponent->bConstrainAspectRatio || this->cachedViewportSize.Y <= 0.0f)
+	{
+		return this->cameraComponent->AspectRatio;
+	}
+	return this->cachedViewportSize.X / this->cachedViewportSize.Y;
+}
+
+void URTSCamera::resolveFrustumCornerAltitudes(const float groundAltitude, float outCornerAltitudes[4]) const
+{
+	/// 异步模式下各角点使用上一批探针测得的地面高度，否则退化为根坐标所在的水平面
+	for (int32 cornerIndex = 0; cornerIndex < 4; ++cornerIndex)
 	{
-		aspectRatioValue = this->cameraComponent->AspectRatio;
+		const int32 probeSlot = firstFrustumGroundProbeSlot + cornerIndex;
+		outCornerAltitudes[cornerIndex] = this->enableAsyncGroundProbes && this->asyncGroundProbeValid[probeSlot]
+			? this->asyncGroundProbeHeights[probeSlot]
+			: groundAltitude;
 	}
+}
 
-	const float horizontalFieldOfView = FMath::DegreesToRadians(fieldOfViewValue) / 2.0f;
-	const float verticalFieldOfView = FMath::Atan(FMath::Tan(horizontalFieldOfView) / aspectRatioValue);
+void URTSCamera::projectFrustumGroundCorners(
+	const FVector& cameraLocation,
+	const FQuat& cameraRotation,
+	const float fieldOfViewDegrees,
+	const float aspectRatio,
+	const float cornerAltitudes[4],
+	FVector outCorners[4]
+)
+{
+	const float horizontalFieldOfView = FMath::DegreesToRadians(fieldOfViewDegrees) / 2.0f;
+	const float verticalFieldOfView = FMath::Atan(FMath::Tan(horizontalFieldOfView) / FMath::Max(aspectRatio, KINDA_SMALL_NUMBER));
 
 	const float tangentHorizontal = FMath::Tan(horizontalFieldOfView);
 	const float tangentVertical = FMath::Tan(verticalFieldOfView);
 
-	const FVector forwardVector = cameraRotation.Vector();
-	const FVector rightVector = FRotationMatrix(cameraRotation).GetScaledAxis(EAxis::Y);
-	const FVector upVector = FRotationMatrix(cameraRotation).GetScaledAxis(EAxis::Z);
+	const FVector forwardVector = cameraRotation.GetForwardVector();
+	const FVector rightVector = cameraRotation.GetRightVector();
+	const FVector upVector = cameraRotation.GetUpVector();
 
-	/// 计算四个边界射线
-	const FVector topRightDirection = (forwardVector + rightVector * tangentHorizontal + upVector * tangentVertical).GetSafeNormal();
-	const FVector topLeftDirection = (forwardVector - rightVector * tangentHorizontal + upVector * tangentVertical).GetSafeNormal();
-	const FVector bottomRightDirection = (forwardVector + rightVector * tangentHorizontal - upVector * tangentVertical).GetSafeNormal();
-	const FVector bottomLeftDirection = (forwardVector - rightVector * tangentHorizontal - upVector * tangentVertical).GetSafeNormal();
+	/// 计算四个边界射线，顺序与角点数组一致：左上、右上、右下、左下
+	const FVector cornerDirections[4] = {
+		(forwardVector - rightVector * tangentHorizontal + upVector * tangentVertical).GetSafeNormal(),
+		(forwardVector + rightVector * tangentHorizontal + upVector * tangentVertical).GetSafeNormal(),
+		(forwardVector + rightVector * tangentHorizontal - upVector * tangentVertical).GetSafeNormal(),
+		(forwardVector - rightVector * tangentHorizontal - upVector * tangentVertical).GetSafeNormal()
+	};
 
-	const float groundAltitude = this->rootComponent->GetComponentLocation().Z;
-	
-	auto calculateIntersection = [&](const FVector& rayOrigin, const FVector& rayDirection) -> FVector
+	for (int32 cornerIndex = 0; cornerIndex < 4; ++cornerIndex)
 	{
-		if (rayDirection.Z >= -0.001f) 
+		const FVector& rayDirection = cornerDirections[cornerIndex];
+		if (rayDirection.Z >= -0.001f)
 		{
-			return rayOrigin + rayDirection * 100000.0f;
+			outCorners[cornerIndex] = cameraLocation + rayDirection * 100000.0f;
+			continue;
 		}
 
-		const float timeToIntersection = (groundAltitude - rayOrigin.Z) / rayDirection.Z;
-		if (timeToIntersection < 0.0f) 
+		const float timeToIntersection = (cornerAltitudes[cornerIndex] - cameraLocation.Z) / rayDirection.Z;
+		outCorners[cornerIndex] = timeToIntersection < 0.0f
+			? cameraLocation + rayDirection * 100000.0f
+			: cameraLocation + rayDirection * timeToIntersection;
+	}
+}
+
+void URTSCamera::publishCameraSnapshot()
+{
+	if (this->cameraComponent == nullptr || this->springArmComponent == nullptr)
+	{
+		return;
+	}
+
+	/// 与视野投影相同的弹簧臂求解公式，但臂长取当前值，描述的是本帧实际渲染的位姿
+	FRTSCameraSnapshot snapshot;
+	const FQuat armRotation = this->springArmComponent->GetComponentQuat();
+	snapshot.ArmLength = this->springArmComponent->TargetArmLength;
+	snapshot.Location = this->springArmComponent->GetComponentLocation() + this->springArmComponent->TargetOffset
+		- armRotation.GetForwardVector() * snapshot.ArmLength
+		+ armRotation.RotateVector(this->springArmComponent->SocketOffset);
+	snapshot.Rotation = armRotation * this->cameraComponent->GetRelativeRotation().Quaternion();
+	snapshot.RootLocation = this->rootComponent->GetComponentLocation();
+
+	const float zoomRange = this->maximumZoomLength - this->minimumZoomLength;
+	snapshot.ZoomAlpha = zoomRange > 0.0f ? FMath::Clamp((snapshot.ArmLength - this->minimumZoomLength) / zoomRange, 0.0f, 1.0f) : 0.0f;
+	snapshot.FieldOfView = this->cameraComponent->FieldOfView;
+	snapshot.AspectRatio = this->calculateFrustumAspectRatio();
+
+	for (int32 cornerIndex = 0; cornerIndex < 4; ++cornerIndex)
+	{
+		snapshot.GroundCorners[cornerIndex] = this->minimapFrustumPoints[cornerIndex];
+	}
+	snapshot.FrameNumber = GFrameCounter;
+
+	this->snapshotChannel->publish(snapshot);
+	this->frustumQuery.build(snapshot);
+
+	/// 分屏时只有第一位本地玩家正在观看的相机驱动全局消费者（Mass 重要度等），画中画相机不参与
+	if (this->isViewedByLocalPlayer() && this->realTimeStrategyPlayerController->IsPrimaryPlayer())
+	{
+		URTSCameraManagerSubsystem* manager = this->cameraManager != nullptr ? this->cameraManager : this->GetWorld()->GetSubsystem<URTSCameraManagerSubsystem>();
+		if (manager != nullptr)
 		{
-			return rayOrigin + rayDirection * 100000.0f;
+			manager->PublishPrimarySnapshot(snapshot);
 		}
+	}
+}
 
-		return rayOrigin + rayDirection * timeToIntersection;
-	};
+void URTSCamera::registerStreamingSourceProvider()
+{
+	if (!this->enablePredictiveStreaming)
+	{
+		return;
+	}
 
-	/// 填充战略投影点数组
-	this->minimapFrustumPoints[0] = calculateIntersection(cameraLocation, topLeftDirection);
-	this->minimapFrustumPoints[1] = calculateIntersection(cameraLocation, topRightDirection);
-	this->minimapFrustumPoints[2] = calculateIntersection(cameraLocation, bottomRightDirection);
-	this->minimapFrustumPoints[3] = calculateIntersection(cameraLocation, bottomLeftDirection);
+	/// 仅 World Partition 地图存在该子系统
+	UWorldPartitionSubsystem* worldPartitionSubsystem = this->GetWorld()->GetSubsystem<UWorldPartitionSubsystem>();
+	if (worldPartitionSubsystem == nullptr)
+	{
+		return;
+	}
 
-	/// 计算完成后发起视野更新广播
-	this->onMinimapFrustumUpdated.Broadcast();
+	const FString sourcePrefix = this->GetPathName();
+	this->currentViewStreamingSourceName = FName(*(sourcePrefix + TEXT("_View")));
+	this->predictedViewStreamingSourceName = FName(*(sourcePrefix + TEXT("_PredictedView")));
+	this->prefetchStreamingSourceName = FName(*(sourcePrefix + TEXT("_Prefetch")));
+
+	worldPartitionSubsystem->RegisterStreamingSourceProvider(this);
+	this->bRegisteredStreamingSourceProvider = true;
 }
 
-void URTSCamera::applyBoundaryConstraints()
+void URTSCamera::unregisterStreamingSourceProvider()
 {
-	if (this->movementBoundaryVolume == nullptr || this->springArmComponent == nullptr)
+	if (!this->bRegisteredStreamingSourceProvider)
 	{
 		return;
 	}
 
-	// 1. 获取边界数据
-	FVector boxOrigin = FVector::ZeroVector;
-	FVector boxExtents = FVector::ZeroVector;
-	if (const AMinimapRegion* minimapRegion = Cast<AMinimapRegion>(this->movementBoundaryVolume))
+	if (UWorldPartitionSubsystem* worldPartitionSubsystem = this->GetWorld() ? this->GetWorld()->GetSubsystem<UWorldPartitionSubsystem>() : nullptr)
 	{
-		if (minimapRegion->BoundsComponent != nullptr)
-		{
-			boxExtents = minimapRegion->BoundsComponent->GetScaledBoxExtent();
-			boxOrigin = minimapRegion->BoundsComponent->GetComponentLocation();
-		}
+		worldPartitionSubsystem->UnregisterStreamingSourceProvider(this);
 	}
+	this->bRegisteredStreamingSourceProvider = false;
+}
 
-	if (boxExtents.IsZero()) return;
+void URTSCamera::requestStreamingPrefetch(const FVector position, const float holdSeconds)
+{
+	const UWorld* world = this->GetWorld();
+	if (world == nullptr)
+	{
+		return;
+	}
 
-	// 2. 地形高度同步 (取代 Tick 中的独立调用)
-	this->rectifyRootHeightFromTerrain();
+	/// 流送子系统每帧轮询提供者，登记后的下一次轮询即开始加载
+	this->streamingPrefetchLocation = position;
+	this->streamingPrefetchExpireSeconds = world->GetTimeSeconds() + (holdSeconds > 0.0f ? holdSeconds : this->jumpStreamingHoldSeconds);
+}
 
-	// 3. 计算并应用偏移
-	const FVector currentPos = this->rootComponent->GetComponentLocation();
-	this->currentLateralSocketOffset = this->calculateYOffset(currentPos.Y);
-	this->currentVerticalSocketOffset = this->calculateXOffset(currentPos.X);
+bool URTSCamera::startReplay(const float secondsAgo, const float playbackRate)
+{
+	if (this->replayBuffer.isEmpty())
+	{
+		return false;
+	}
 
-	this->springArmComponent->SocketOffset = FVector(this->currentVerticalSocketOffset, this->currentLateralSocketOffset, 0.0f);
+	this->bIsReplaying = true;
+	this->replayPlaybackRate = playbackRate;
+	this->replayPlaybackSeconds = FMath::Clamp(
+		this->GetWorld()->GetTimeSeconds() - secondsAgo,
+		this->replayBuffer.getOldestTimeSeconds(),
+		this->replayBuffer.getNewestTimeSeconds()
+	);
 
-	// 4. Root 物理坐标锁定 (核心：边界限制永远生效，Flag 仅控制是否产生 Offset)
-	FVector clampedLocation = currentPos;
-	clampedLocation.X = FMath::Clamp(clampedLocation.X, boxOrigin.X - boxExtents.X, boxOrigin.X + boxExtents.X);
-	clampedLocation.Y = FMath::Clamp(clampedLocation.Y, boxOrigin.Y - boxExtents.Y, boxOrigin.Y + boxExtents.Y);
-	
-	this->rootComponent->SetWorldLocation(clampedLocation);
+	FRTSCameraReplaySample sample;
+	if (this->replayBuffer.sampleAt(this->replayPlaybackSeconds, sample))
+	{
+		this->applyReplaySample(sample);
+	}
+	this->wakeCameraTick();
+	return true;
+}
+
+void URTSCamera::scrubReplay(const float secondsAgo)
+{
+	if (!this->bIsReplaying)
+	{
+		this->startReplay(secondsAgo, 0.0f);
+		return;
+	}
+
+	this->replayPlaybackSeconds = FMath::Clamp(
+		this->GetWorld()->GetTimeSeconds() - secondsAgo,
+		this->replayBuffer.getOldestTimeSeconds(),
+		this->replayBuffer.getNewestTimeSeconds()
+	);
+	FRTSCameraReplaySample sample;
+	if (this->replayBuffer.sampleAt(this->replayPlaybackSeconds, sample))
+	{
+		this->applyReplaySample(sample);
+	}
+	this->wakeCameraTick();
 }
 
-float URTSCamera::calculateYOffset(float worldY) const
+void URTSCamera::setReplayPlaybackRate(const float playbackRate)
 {
-	if (!this->bEnableYBoundaryConstraint || this->movementBoundaryVolume == nullptr) return 0.0f;
+	this->replayPlaybackRate = playbackRate;
+	this->wakeCameraTick();
+}
+
+void URTSCamera::stopReplay()
+{
+	if (!this->bIsReplaying)
+	{
+		return;
+	}
 
-	const AMinimapRegion* minimapRegion = Cast<AMinimapRegion>(this->movementBoundaryVolume);
-	if (!minimapRegion || !minimapRegion->BoundsComponent) return 0.0f;
+	/// 回放期间不记录，最新的采样即开始回放时的实时状态
+	FRTSCameraReplaySample sample;
+	if (this->replayBuffer.sampleAt(this->replayBuffer.getNewestTimeSeconds(), sample))
+	{
+		this->applyReplaySample(sample);
+	}
+	this->bIsReplaying = false;
+	this->replayFollowTarget = nullptr;
+	this->wakeCameraTick();
+}
 
-	const FVector boxOrigin = minimapRegion->BoundsComponent->GetComponentLocation();
-	const FVector boxExtents = minimapRegion->BoundsComponent->GetScaledBoxExtent();
-	const float mapOverflow = minimapRegion->MapOverflowUU;
+float URTSCamera::getRecordedReplaySeconds() const
+{
+	return this->replayBuffer.isEmpty() ? 0.0f : static_cast<float>(this->replayBuffer.getNewestTimeSeconds() - this->replayBuffer.getOldestTimeSeconds());
+}
 
-	const float differenceY = worldY - boxOrigin.Y;
-	const float normalizedDistanceY = FMath::Abs(differenceY) / FMath::Max(boxExtents.Y, 1.0f);
-	const float safeZoneRatio = 1.0f - this->boundaryTransitionZoneRatio;
+void URTSCamera::recordReplaySample(const FVector& committedLocation)
+{
+	FRTSCameraReplaySample sample;
+	sample.timeSeconds = this->GetWorld()->GetTimeSeconds();
+	sample.rootLocation = committedLocation;
+	sample.yaw = this->rootComponent->GetComponentRotation().Yaw;
+	sample.armLength = this->springArmComponent->TargetArmLength;
+	sample.socketOffset = this->springArmComponent->SocketOffset;
+	sample.followTargetId = this->activeCameraFollowTarget != nullptr ? this->activeCameraFollowTarget->GetUniqueID() : 0;
+	this->replayBuffer.record(sample);
+}
 
-	if (normalizedDistanceY > safeZoneRatio)
+void URTSCamera::advanceReplayPlayback(const float frameDeltaSeconds)
+{
+	/// 暂停时采样不变，不再重复应用，相机得以进入休眠；定位与改速会重新唤醒
+	if (this->replayPlaybackRate == 0.0f)
 	{
-		const float triggerAlpha = (normalizedDistanceY - safeZoneRatio) / FMath::Max(this->boundaryTransitionZoneRatio, 0.01f);
-		const float reach = this->springArmComponent->TargetArmLength * this->lateralReachFactor;
-		const float offset = triggerAlpha * (reach * this->minimumZoomBoundaryConstraint) * ((differenceY > 0.0f) ? -1.0f : 1.0f);
-		
-		UE_LOG(LogRTSCamera, VeryVerbose, TEXT("横向 (Y) 比例补偿: alpha=%.2f, reach=%.1f, offset=%.1f"), triggerAlpha, reach, offset);
-		return offset;
+		return;
 	}
 
-	return 0.0f;
+	this->replayPlaybackSeconds += frameDeltaSeconds * this->replayPlaybackRate;
+	if (this->replayPlaybackRate > 0.0f && this->replayPlaybackSeconds >= this->replayBuffer.getNewestTimeSeconds())
+	{
+		this->stopReplay();
+		return;
+	}
+
+	this->replayPlaybackSeconds = FMath::Max(this->replayPlaybackSeconds, this->replayBuffer.getOldestTimeSeconds());
+	FRTSCameraReplaySample sample;
+	if (this->replayBuffer.sampleAt(this->replayPlaybackSeconds, sample))
+	{
+		this->applyReplaySample(sample);
+	}
 }
 
-float URTSCamera::calculateXOffset(float worldX) const
+void URTSCamera::applyReplaySample(const FRTSCameraReplaySample& sample)
 {
-	if (!this->bEnableXBoundaryConstraint || this->movementBoundaryVolume == nullptr) return 0.0f;
+	/// SocketOffset 由边界求解器按根坐标与臂长重新求出，与记录时一致，这里不直接写入
+	FVector& stagedLocation = this->acquireStagedRootLocation();
+	stagedLocation = sample.rootLocation;
 
-	const AMinimapRegion* minimapRegion = Cast<AMinimapRegion>(this->movementBoundaryVolume);
-	if (!minimapRegion || !minimapRegion->BoundsComponent) return 0.0f;
+	FRotator rootRotation = this->rootComponent->GetComponentRotation();
+	rootRotation.Yaw = sample.yaw;
+	this->rootComponent->SetWorldRotation(rootRotation);
 
-	const FVector boxOrigin = minimapRegion->BoundsComponent->GetComponentLocation();
-	const FVector boxExtents = minimapRegion->BoundsComponent->GetScaledBoxExtent();
-	const float mapOverflow = minimapRegion->MapOverflowUU;
+	this->desiredZoomLength = sample.armLength;
+	this->springArmComponent->TargetArmLength = sample.armLength;
 
-	const float differenceX = worldX - boxOrigin.X;
-	const float normalizedDistanceX = FMath::Abs(differenceX) / FMath::Max(boxExtents.X, 1.0f);
-	const float safeZoneRatio = 1.0f - this->boundaryTransitionZoneRatio;
+	/// 编号只在跟随时登记过的 Actor 中解析，弱引用保证已销毁或编号被复用的对象不会被误认
+	const TWeakObjectPtr<AActor>* recordedFollowTarget = sample.followTargetId != 0 ? this->replayFollowTargetsById.Find(sample.followTargetId) : nullptr;
+	this->replayFollowTarget = recordedFollowTarget != nullptr ? *recordedFollowTarget : nullptr;
+
+	this->bMinimapFrustumRefreshRequested = true;
+	this->bSimulationTeleportPending = true;
+	this->bRegionLookupRequested = true;
+}
 
-	if (normalizedDistanceX > safeZoneRatio)
+void URTSCamera::updateStreamingPanVelocity(const FVector& committedLocation)
+{
+	const FVector2D planarLocation(committedLocation);
+	if (this->bHasStreamingVelocitySample && !this->bStreamingVelocityResetRequested && this->deltaSeconds > KINDA_SMALL_NUMBER)
 	{
-		const float triggerAlpha = (normalizedDistanceX - safeZoneRatio) / FMath::Max(this->boundaryTransitionZoneRatio, 0.01f);
-		
-		// 南北向由于 Pitch 倾角是不对称的
-		// 北端 (diff > 0) 使用前进伸展 forwardReach；南端 (diff < 0) 使用后退伸展 backwardReach
-		const float currentFactor = (differenceX > 0.0f) ? this->forwardReachFactor : this->backwardReachFactor;
-		const float reach = this->springArmComponent->TargetArmLength * currentFactor;
+		/// 指数平滑，时间常数与帧率无关
+		const FVector2D frameVelocity = (planarLocation - this->lastStreamingPlanarLocation) / this->deltaSeconds;
+		const float smoothingAlpha = 1.0f - FMath::Exp(-this->deltaSeconds / streamingVelocitySmoothingSeconds);
+		this->streamingPanVelocity = FMath::Lerp(this->streamingPanVelocity, frameVelocity, smoothingAlpha);
+	}
+	else if (this->bStreamingVelocityResetRequested)
+	{
+		this->streamingPanVelocity = FVector2D::ZeroVector;
+	}
+
+	this->lastStreamingPlanarLocation = planarLocation;
+	this->bHasStreamingVelocitySample = true;
+	this->bStreamingVelocityResetRequested = false;
+}
 
-		// 核心逻辑：
-		// 1. 在北端 (diff > 0)，我们需要向南 (Negative X) 偏移，把视口顶部的地图拉回来。
-		// 2. 在南端 (diff < 0)，我们需要向北 (Positive X) 偏移，把视口底部的地图边界拉进来。
-		const float direction = (differenceX > 0.0f) ? -1.0f : 1.0f;
-		const float offset = direction * triggerAlpha * (reach * this->minimumZoomBoundaryConstraint);
+bool URTSCamera::calculateFrustumGroundCircle(FVector& outCenter, float& outRadius) const
+{
+	if (!this->bHasBroadcastMinimapFrustum)
+	{
+		return false;
+	}
+
+	outCenter = (this->minimapFrustumPoints[0] + this->minimapFrustumPoints[1] + this->minimapFrustumPoints[2] + this->minimapFrustumPoints[3]) * 0.25f;
+	float radiusSquared = 0.0f;
+	for (int32 cornerIndex = 0; cornerIndex < 4; ++cornerIndex)
+	{
+		radiusSquared = FMath::Max(radiusSquared, FVector2D::DistSquared(FVector2D(this->minimapFrustumPoints[cornerIndex]), FVector2D(outCenter)));
+	}
+	outRadius = FMath::Min(FMath::Sqrt(radiusSquared), this->maxStreamingSourceRadius);
+	return true;
+}
+
+bool URTSCamera::GetStreamingSources(TArray<FWorldPartitionStreamingSource>& OutStreamingSources) const
+{
+	auto addSphereSource = [&OutStreamingSources](const FName name, const FVector& location, const float radius, const EStreamingSourcePriority priority, const float velocity)
+	{
+		FWorldPartitionStreamingSource& source = OutStreamingSources.AddDefaulted_GetRef();
+		source.Name = name;
+		source.Location = location;
+		source.Rotation = FRotator::ZeroRotator;
+		source.TargetState = EStreamingSourceTargetState::Activated;
+		source.bBlockOnSlowLoading = false;
+		source.Priority = priority;
+		source.Velocity = velocity;
+
+		FStreamingSourceShape& shape = source.Shapes.AddDefaulted_GetRef();
+		shape.bUseGridLoadingRange = false;
+		shape.Radius = radius;
+	};
+
+	const int32 sourceCountBefore = OutStreamingSources.Num();
 
-		UE_LOG(LogRTSCamera, VeryVerbose, TEXT("南北 (X) 修正方案: diff=%.1f, factor=%.4f, offset=%.1f"), differenceX, currentFactor, offset);
-		return offset;
+	/// 视野四角按缩放意图计算；当前视野按实际臂长与意图臂长之比缩小，外推视野则直接使用意图大小
+	FVector viewCenter;
+	float intentRadius = 0.0f;
+	if (this->calculateFrustumGroundCircle(viewCenter, intentRadius) && this->springArmComponent != nullptr)
+	{
+		const float armLengthRatio = this->desiredZoomLength > KINDA_SMALL_NUMBER
+			? this->springArmComponent->TargetArmLength / this->desiredZoomLength
+			: 1.0f;
+		const float currentRadius = FMath::Min(intentRadius * armLengthRatio, this->maxStreamingSourceRadius);
+		const float panSpeed = this->streamingPanVelocity.Size();
+		addSphereSource(this->currentViewStreamingSourceName, viewCenter, currentRadius, EStreamingSourcePriority::Normal, panSpeed);
+
+		const FVector2D extrapolation = this->streamingPanVelocity * this->streamingLookaheadSeconds;
+		if (extrapolation.SizeSquared() > FMath::Square(minimumStreamingExtrapolationDistance) || intentRadius > currentRadius)
+		{
+			addSphereSource(this->predictedViewStreamingSourceName, viewCenter + FVector(extrapolation, 0.0f), intentRadius, EStreamingSourcePriority::High, panSpeed);
+		}
 	}
 
-	return 0.0f;
+	/// 跳转目标：保持期内以最高优先级上报，覆盖范围与当前视野相同
+	const UWorld* world = this->GetWorld();
+	if (world != nullptr && this->streamingPrefetchExpireSeconds >= world->GetTimeSeconds())
+	{
+		const float prefetchRadius = intentRadius > 0.0f ? intentRadius : this->maxStreamingSourceRadius;
+		addSphereSource(this->prefetchStreamingSourceName, this->streamingPrefetchLocation, prefetchRadius, EStreamingSourcePriority::Highest, 0.0f);
+	}
+
+	return OutStreamingSources.Num() > sourceCountBefore;
+}
+
+void URTSCamera::applyBoundaryConstraints(FVector& rootLocation)
+{
+	if (!this->boundarySolver.hasRegion() || this->springArmComponent == nullptr)
+	{
+		return;
+	}
+
+	// 1. 投影参数同步与地形高度校正已在 stageCommitLocation 中完成
+
+	// 2. 计算并应用偏移
+	this->applyBoundarySocketOffset(this->boundarySolver.calculateSocketOffset(FVector2D(rootLocation), this->springArmComponent->TargetArmLength));
+
+	// 3. Root 物理坐标锁定 (核心：边界限制永远生效，Flag 仅控制是否产生 Offset)
+	// 由调用方统一写回世界变换，此处只修改暂存坐标
+	const FVector2D clampedLocation = this->boundarySolver.clampPlanarLocation(FVector2D(rootLocation));
+	rootLocation.X = clampedLocation.X;
+	rootLocation.Y = clampedLocation.Y;
+}
+
+void URTSCamera::applyBoundarySocketOffset(const FVector2D& socketOffset)
+{
+	this->currentVerticalSocketOffset = socketOffset.X;
+	this->currentLateralSocketOffset = socketOffset.Y;
+	this->springArmComponent->SocketOffset = FVector(this->currentVerticalSocketOffset, this->currentLateralSocketOffset, 0.0f);
 }
@@ -0,0 +1,171 @@
+// Copyright 2024 Jesus Bracho All Rights Reserved.
+
+#include "RTSCameraAttentionHeatmap.h"
+
+#include "HAL/FileManager.h"
+#include "Misc/Compression.h"
+#include "OpenRTSCamera.h"
+#include "Serialization/Archive.h"
+
+bool FRTSCameraAttentionHeatmap::hasSameLayout(const FRTSCameraAttentionHeatmap& other) const
+{
+	return this->sizeX == other.sizeX && this->sizeY == other.sizeY
+		&& this->origin.Equals(other.origin, 1.0) && FMath::IsNearlyEqual(this->cellSize, other.cellSize, 0.01f);
+}
+
+bool FRTSCameraAttentionHeatmap::loadFromFile(const FString& filePath, FRTSCameraAttentionHeatmap& outHeatmap)
+{
+	const TUniquePtr<FArchive> reader(IFileManager::Get().CreateFileReader(*filePath));
+	if (!reader.IsValid())
+	{
+		return false;
+	}
+
+	uint32 magic = 0;
+	uint32 version = 0;
+	*reader << magic << version;
+	if (magic != fileMagic || version != fileVersion)
+	{
+		UE_LOG(LogOpenRTSCamera, Warning, TEXT("热力图文件 [%s] 的文件头无效"), *filePath);
+		return false;
+	}
+
+	FRTSCameraAttentionHeatmap heatmap;
+	double originX = 0.0;
+	double originY = 0.0;
+	*reader << heatmap.sizeX << heatmap.sizeY << originX << originY << heatmap.cellSize;
+	if (reader->IsError() || heatmap.sizeX <= 0 || heatmap.sizeY <= 0)
+	{
+		return false;
+	}
+	heatmap.origin = FVector2D(originX, originY);
+	heatmap.seconds.SetNumZeroed(heatmap.sizeX * heatmap.sizeY);
+	heatmap.sourceCount = 1;
+
+	const int32 expectedRawBytes = heatmap.seconds.Num() * sizeof(float);
+	TArray<uint8> compressed;
+	TArray<float> chunk;
+	chunk.SetNumUninitialized(heatmap.seconds.Num());
+
+	/// 逐块累加；残缺或损坏的块之后的数据全部忽略
+	while (reader->Tell() < reader->TotalSize())
+	{
+		uint32 blockMagic = 0;
+		double sessionSeconds = 0.0;
+		double chunkSeconds = 0.0;
+		int32 rawBytes = 0;
+		int32 compressedBytes = 0;
+		*reader << blockMagic << sessionSeconds << chunkSeconds << rawBytes << compressedBytes;
+		if (reader->IsError() || blockMagic != chunkMagic || rawBytes != expectedRawBytes
+			|| compressedBytes <= 0 || reader->Tell() + compressedBytes > reader->TotalSize())
+		{
+			break;
+		}
+
+		compressed.SetNumUninitialized(compressedBytes);
+		reader->Serialize(compressed.GetData(), compressedBytes);
+		if (!FCompression::UncompressMemory(NAME_Zlib, chunk.GetData(), rawBytes, compressed.GetData(), compressedBytes))
+		{
+			break;
+		}
+
+		for (int32 cellIndex = 0; cellIndex < chunk.Num(); ++cellIndex)
+		{
+			heatmap.seconds[cellIndex] += chunk[cellIndex];
+		}
+		heatmap.totalSeconds += chunkSeconds;
+	}
+
+	outHeatmap = MoveTemp(heatmap);
+	return true;
+}
+
+bool FRTSCameraAttentionHeatmap::merge(const FRTSCameraAttentionHeatmap& other)
+{
+	if (!other.isValid())
+	{
+		return false;
+	}
+	if (!this->isValid())
+	{
+		*this = other;
+		return true;
+	}
+	if (!this->hasSameLayout(other))
+	{
+		return false;
+	}
+
+	for (int32 cellIndex = 0; cellIndex < this->seconds.Num(); ++cellIndex)
+	{
+		this->seconds[cellIndex] += other.seconds[cellIndex];
+	}
+	this->totalSeconds += other.totalSeconds;
+	this->sourceCount += other.sourceCount;
+	return true;
+}
+
+int32 FRTSCameraAttentionHeatmap::mergeFiles(const TArray<FString>& filePaths, FRTSCameraAttentionHeatmap& outHeatmap)
+{
+	outHeatmap = FRTSCameraAttentionHeatmap();
+	int32 mergedCount = 0;
+	for (const FString& filePath : filePaths)
+	{
+		FRTSCameraAttentionHeatmap heatmap;
+		if (!loadFromFile(filePath, heatmap))
+		{
+			continue;
+		}
+		if (outHeatmap.merge(heatmap))
+		{
+			++mergedCount;
+		}
+		else
+		{
+			UE_LOG(LogOpenRTSCamera, Warning, TEXT("热力图文件 [%s] 的网格布局与已合并的文件不一致，已跳过"), *filePath);
+		}
+	}
+	return mergedCount;
+}
+
+bool FRTSCameraAttentionHeatmap::appendChunk(
+	const FString& filePath,
+	const FRTSCameraAttentionHeatmap& layout,
+	const TArray<float>& deltaSeconds,
+	double sessionSeconds,
+	double chunkSeconds
+)
+{
+	int32 rawBytes = deltaSeconds.Num() * sizeof(float);
+	int32 compressedBytes = FCompression::CompressMemoryBound(NAME_Zlib, rawBytes);
+	TArray<uint8> compressed;
+	compressed.SetNumUninitialized(compressedBytes);
+	if (!FCompression::CompressMemory(NAME_Zlib, compressed.GetData(), compressedBytes, deltaSeconds.GetData(), rawBytes))
+	{
+		return false;
+	}
+
+	const bool bWriteHeader = IFileManager::Get().FileSize(*filePath) <= 0;
+	const TUniquePtr<FArchive> writer(IFileManager::Get().CreateFileWriter(*filePath, FILEWRITE_Append | FILEWRITE_AllowRead));
+	if (!writer.IsValid())
+	{
+		return false;
+	}
+
+	if (bWriteHeader)
+	{
+		uint32 magic = fileMagic;
+		uint32 version = fileVersion;
+		int32 sizeX = layout.sizeX;
+		int32 sizeY = layout.sizeY;
+		double originX = layout.origin.X;
+		double originY = layout.origin.Y;
+		float cellSize = layout.cellSize;
+		*writer << magic << version << sizeX << sizeY << originX << originY << cellSize;
+	}
+
+	uint32 magic = chunkMagic;
+	*writer << magic << sessionSeconds << chunkSeconds << rawBytes << compressedBytes;
+	writer->Serialize(compressed.GetData(), compressedBytes);
+	return writer->Close();
+}
@@ -0,0 +1,200 @@
+// Copyright 2024 Jesus Bracho All Rights Reserved.
+
+#include "RTSCameraAttentionRecorder.h"
+
+#include "Components/BoxComponent.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "HAL/FileManager.h"
+#include "MassBattleMinimapRegion.h"
+#include "Misc/DateTime.h"
+#include "Misc/Paths.h"
+#include "OpenRTSCamera.h"
+#include "RTSCamera.h"
+
+DECLARE_CYCLE_STAT(TEXT("Attention Rasterize"), STAT_RTSCameraAttentionRasterize, STATGROUP_OpenRTSCamera);
+
+URTSCameraAttentionRecorder::URTSCameraAttentionRecorder()
+{
+	PrimaryComponentTick.bCanEverTick = true;
+	PrimaryComponentTick.bStartWithTickEnabled = true;
+	PrimaryComponentTick.TickGroup = TG_PostUpdateWork;
+
+	this->gridResolution = 128;
+	this->sampleFrameInterval = 10;
+	this->flushIntervalSeconds = 30.0f;
+	this->camera = nullptr;
+	this->pendingChunkSeconds = 0.0;
+	this->framesSinceSample = 0;
+	this->secondsSinceSample = 0.0f;
+	this->secondsSinceFlush = 0.0f;
+}
+
+void URTSCameraAttentionRecorder::BeginPlay()
+{
+	Super::BeginPlay();
+
+	this->camera = this->GetOwner() != nullptr ? this->GetOwner()->FindComponentByClass<URTSCamera>() : nullptr;
+	if (this->GetNetMode() == NM_DedicatedServer || this->camera == nullptr || !this->initializeGridLayout())
+	{
+		this->SetComponentTickEnabled(false);
+		return;
+	}
+
+	const FString directory = this->outputDirectory.IsEmpty()
+		? FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("Telemetry"), TEXT("CameraAttention"))
+		: this->outputDirectory;
+	IFileManager::Get().MakeDirectory(*directory, true);
+	this->outputFilePath = FPaths::Combine(
+		directory,
+		FString::Printf(TEXT("%s_%s.rtsheat"), *FPaths::GetBaseFilename(this->GetWorld()->GetMapName()), *FDateTime::Now().ToString())
+	);
+}
+
+void URTSCameraAttentionRecorder::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	/// 写入任务只持有数据副本，组件销毁后仍可安全完成
+	this->flush();
+	Super::EndPlay(EndPlayReason);
+}
+
+bool URTSCameraAttentionRecorder::initializeGridLayout()
+{
+	FBox2D bounds(ForceInit);
+	for (TActorIterator<AMinimapRegion> iterator(this->GetWorld()); iterator; ++iterator)
+	{
+		if (iterator->BoundsComponent != nullptr)
+		{
+			const FVector origin = iterator->BoundsComponent->GetComponentLocation();
+			const FVector extent = iterator->BoundsComponent->GetScaledBoxExtent();
+			bounds = FBox2D(FVector2D(origin - extent), FVector2D(origin + extent));
+			break;
+		}
+	}
+	if (!bounds.bIsValid)
+	{
+		if (const AActor* boundaryVolume = this->camera->getMovementBoundaryVolume())
+		{
+			const FBox actorBounds = boundaryVolume->GetComponentsBoundingBox();
+			bounds = FBox2D(FVector2D(actorBounds.Min), FVector2D(actorBounds.Max));
+		}
+	}
+	if (!bounds.bIsValid || bounds.GetArea() <= 0.0)
+	{
+		UE_LOG(LogOpenRTSCamera, Warning, TEXT("注意力记录器 [%s] 找不到小地图区域，记录已禁用"), *this->GetOwner()->GetName());
+		return false;
+	}
+
+	const FVector2D size = bounds.GetSize();
+	this->layout.cellSize = FMath::Max(size.X, size.Y) / FMath::Max(this->gridResolution, 1);
+	this->layout.sizeX = FMath::Max(FMath::CeilToInt(size.X / this->layout.cellSize), 1);
+	this->layout.sizeY = FMath::Max(FMath::CeilToInt(size.Y / this->layout.cellSize), 1);
+	this->layout.origin = bounds.Min;
+	this->pendingSeconds.SetNumZeroed(this->layout.sizeX * this->layout.sizeY);
+	return true;
+}
+
+void URTSCameraAttentionRecorder::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	/// 相机休眠时视野不变，但时间仍在累计，注意力按停留时长计算
+	this->secondsSinceSample += DeltaTime;
+	this->secondsSinceFlush += DeltaTime;
+	if (++this->framesSinceSample >= this->sampleFrameInterval)
+	{
+		const FVector* corners = this->camera->minimapFrustumPoints;
+		if (!corners[0].Equals(corners[2]))
+		{
+			this->rasterizeGroundQuad(corners, this->secondsSinceSample);
+		}
+		this->pendingChunkSeconds += this->secondsSinceSample;
+		this->framesSinceSample = 0;
+		this->secondsSinceSample = 0.0f;
+	}
+
+	if (this->secondsSinceFlush >= this->flushIntervalSeconds)
+	{
+		this->flush();
+	}
+}
+
+void URTSCameraAttentionRecorder::rasterizeGroundQuad(const FVector corners[4], const float weightSeconds)
+{
+	SCOPE_CYCLE_COUNTER(STAT_RTSCameraAttentionRasterize);
+
+	/// 转换为格子坐标，格子 (x, y) 的中心位于 (x + 0.5, y + 0.5)
+	FVector2D points[4];
+	float minY = MAX_flt;
+	float maxY = -MAX_flt;
+	const float inverseCellSize = 1.0f / this->layout.cellSize;
+	for (int32 cornerIndex = 0; cornerIndex < 4; ++cornerIndex)
+	{
+		points[cornerIndex] = (FVector2D(corners[cornerIndex]) - this->layout.origin) * inverseCellSize;
+		minY = FMath::Min(minY, points[cornerIndex].Y);
+		maxY = FMath::Max(maxY, points[cornerIndex].Y);
+	}
+
+	const int32 firstRow = FMath::Max(FMath::CeilToInt(minY - 0.5f), 0);
+	const int32 lastRow = FMath::Min(FMath::FloorToInt(maxY - 0.5f), this->layout.sizeY - 1);
+	for (int32 row = firstRow; row <= lastRow; ++row)
+	{
+		/// 扫描线与四条边求交，取交点的最左与最右构成覆盖区间（四边形为凸）
+		const float scanY = row + 0.5f;
+		float spanMin = MAX_flt;
+		float spanMax = -MAX_flt;
+		for (int32 edgeIndex = 0; edgeIndex < 4; ++edgeIndex)
+		{
+			const FVector2D& a = points[edgeIndex];
+			const FVector2D& b = points[(edgeIndex + 1) % 4];
+			if ((a.Y <= scanY) == (b.Y <= scanY))
+			{
+				continue;
+			}
+			const float x = a.X + (scanY - a.Y) / (b.Y - a.Y) * (b.X - a.X);
+			spanMin = FMath::Min(spanMin, x);
+			spanMax = FMath::Max(spanMax, x);
+		}
+		if (spanMin > spanMax)
+		{
+			continue;
+		}
+
+		const int32 firstColumn = FMath::Max(FMath::CeilToInt(spanMin - 0.5f), 0);
+		const int32 lastColumn = FMath::Min(FMath::FloorToInt(spanMax - 0.5f), this->layout.sizeX - 1);
+		float* rowCells = this->pendingSeconds.GetData() + row * this->layout.sizeX;
+		for (int32 column = firstColumn; column <= lastColumn; ++column)
+		{
+			rowCells[column] += weightSeconds;
+		}
+	}
+}
+
+void URTSCameraAttentionRecorder::flush()
+{
+	this->secondsSinceFlush = 0.0f;
+	if (this->outputFilePath.IsEmpty() || this->pendingChunkSeconds <= 0.0)
+	{
+		return;
+	}
+
+	/// 交换出增量网格交给后台任务；压缩与文件追加都在任务线程执行
+	TArray<float> chunkSeconds;
+	chunkSeconds.SetNumZeroed(this->pendingSeconds.Num());
+	Swap(chunkSeconds, this->pendingSeconds);
+
+	const double chunkDuration = this->pendingChunkSeconds;
+	const double sessionSeconds = this->GetWorld() != nullptr ? this->GetWorld()->GetTimeSeconds() : 0.0;
+	this->pendingChunkSeconds = 0.0;
+
+	auto writeChunk = [filePath = this->outputFilePath, layout = this->layout, chunkSeconds = MoveTemp(chunkSeconds), sessionSeconds, chunkDuration]()
+	{
+		if (!FRTSCameraAttentionHeatmap::appendChunk(filePath, layout, chunkSeconds, sessionSeconds, chunkDuration))
+		{
+			UE_LOG(LogOpenRTSCamera, Warning, TEXT("注意力热力图写入 [%s] 失败"), *filePath);
+		}
+	};
+	this->pendingFlushTask = this->pendingFlushTask.IsValid()
+		? UE::Tasks::Launch(UE_SOURCE_LOCATION, MoveTemp(writeChunk), UE::Tasks::Prerequisites(this->pendingFlushTask), LowLevelTasks::ETaskPriority::BackgroundNormal)
+		: UE::Tasks::Launch(UE_SOURCE_LOCATION, MoveTemp(writeChunk), LowLevelTasks::ETaskPriority::BackgroundNormal);
+}
@@ -0,0 +1,179 @@
+// Copyright 2024 Jesus Bracho All Rights Reserved.
+
+#include "RTSCameraBoundaryField.h"
+
+namespace
+{
+	/// 网格在多边形包围盒外额外覆盖的节点圈数，保证越界后的拉回仍落在插值范围内
+	constexpr int32 boundaryFieldMarginCells = 4;
+
+	/// 拉回时的最大迭代次数：凹角附近双线性插值的法线有误差，第二次迭代即可收敛
+	constexpr int32 clampIterationCount = 2;
+}
+
+bool FRTSCameraBoundaryField::bake(const TArray<FVector2D>& polygon, float cellSize, const int32 maxSampleCount)
+{
+	this->signedDistances.Reset();
+	this->outwardNormals.Reset();
+	this->sampleCountX = 0;
+	this->sampleCountY = 0;
+
+	if (polygon.Num() < 3)
+	{
+		return false;
+	}
+
+	this->polygonBounds = FBox2D(polygon);
+
+	/// 采样点数超出上限时放大间距，保证烘焙耗时与内存有界
+	cellSize = FMath::Max(cellSize, 1.0f);
+	const FVector2D polygonSize = this->polygonBounds.GetSize();
+	auto countNodes = [&polygonSize](const float spacing)
+	{
+		const int64 countX = FMath::CeilToInt64(polygonSize.X / spacing) + 1 + boundaryFieldMarginCells * 2;
+		const int64 countY = FMath::CeilToInt64(polygonSize.Y / spacing) + 1 + boundaryFieldMarginCells * 2;
+		return countX * countY;
+	};
+	while (countNodes(cellSize) > maxSampleCount)
+	{
+		cellSize *= 1.5f;
+	}
+
+	this->gridCellSize = cellSize;
+	this->inverseGridCellSize = 1.0f / cellSize;
+	this->gridOrigin = this->polygonBounds.Min - FVector2D(boundaryFieldMarginCells * cellSize);
+	this->sampleCountX = FMath::CeilToInt(polygonSize.X / cellSize) + 1 + boundaryFieldMarginCells * 2;
+	this->sampleCountY = FMath::CeilToInt(polygonSize.Y / cellSize) + 1 + boundaryFieldMarginCells * 2;
+
+	const int32 nodeCount = this->sampleCountX * this->sampleCountY;
+	this->signedDistances.SetNumUninitialized(nodeCount);
+	this->outwardNormals.SetNumUninitialized(nodeCount);
+
+	for (int32 y = 0; y < this->sampleCountY; ++y)
+	{
+		for (int32 x = 0; x < this->sampleCountX; ++x)
+		{
+			const int32 nodeIndex = y * this->sampleCountX + x;
+			const FVector2D nodeLocation = this->gridOrigin + FVector2D(x, y) * cellSize;
+			evaluatePolygon(polygon, nodeLocation, this->signedDistances[nodeIndex], this->outwardNormals[nodeIndex]);
+		}
+	}
+	return true;
+}
+
+void FRTSCameraBoundaryField::sample(const FVector2D& location, float& outSignedDistance, FVector2D& outOutwardNormal) const
+{
+	if (!this->isValid())
+	{
+		outSignedDistance = 0.0f;
+		outOutwardNormal = FVector2D::ZeroVector;
+		return;
+	}
+
+	/// 网格外的坐标：在网格边缘取值，再加上到边缘的距离（网格外扩区域内的节点均位于多边形外部）
+	const FVector2D gridMax = this->gridOrigin + FVector2D(this->sampleCountX - 1, this->sampleCountY - 1) * this->gridCellSize;
+	const FVector2D clampedLocation(
+		FMath::Clamp(location.X, this->gridOrigin.X, gridMax.X),
+		FMath::Clamp(location.Y, this->gridOrigin.Y, gridMax.Y)
+	);
+	const float outsideGridDistance = FVector2D::Distance(location, clampedLocation);
+
+	const float gridX = (clampedLocation.X - this->gridOrigin.X) * this->inverseGridCellSize;
+	const float gridY = (clampedLocation.Y - this->gridOrigin.Y) * this->inverseGridCellSize;
+	const int32 x0 = FMath::Min(FMath::FloorToInt(gridX), this->sampleCountX - 2);
+	const int32 y0 = FMath::Min(FMath::FloorToInt(gridY), this->sampleCountY - 2);
+	const float alphaX = gridX - x0;
+	const float alphaY = gridY - y0;
+
+	const int32 index00 = y0 * this->sampleCountX + x0;
+	const int32 index10 = index00 + 1;
+	const int32 index01 = index00 + this->sampleCountX;
+	const int32 index11 = index01 + 1;
+
+	outSignedDistance = FMath::BiLerp(
+		this->signedDistances[index00], this->signedDistances[index10],
+		this->signedDistances[index01], this->signedDistances[index11],
+		alphaX, alphaY
+	) + outsideGridDistance;
+
+	outOutwardNormal = FMath::BiLerp(
+		this->outwardNormals[index00], this->outwardNormals[index10],
+		this->outwardNormals[index01], this->outwardNormals[index11],
+		alphaX, alphaY
+	).GetSafeNormal();
+}
+
+FVector2D FRTSCameraBoundaryField::clampInside(const FVector2D& location) const
+{
+	FVector2D clampedLocation = location;
+	for (int32 iteration = 0; iteration < clampIterationCount; ++iteration)
+	{
+		float signedDistance = 0.0f;
+		FVector2D outwardNormal = FVector2D::ZeroVector;
+		this->sample(clampedLocation, signedDistance, outwardNormal);
+		if (signedDistance <= 0.0f || outwardNormal.IsZero())
+		{
+			break;
+		}
+		clampedLocation -= outwardNormal * signedDistance;
+	}
+	return clampedLocation;
+}
+
+void FRTSCameraBoundaryField::evaluatePolygon(const TArray<FVector2D>& polygon, const FVector2D& location, float& outSignedDistance, FVector2D& outOutwardNormal)
+{
+	float nearestDistanceSquared = TNumericLimits<float>::Max();
+	FVector2D nearestPoint = location;
+	FVector2D nearestEdgeNormal = FVector2D::ZeroVector;
+	bool bInside = false;
+	float twiceSignedArea = 0.0f;
+
+	for (int32 vertexIndex = 0, previousIndex = polygon.Num() - 1; vertexIndex < polygon.Num(); previousIndex = vertexIndex++)
+	{
+		const FVector2D& edgeStart = polygon[previousIndex];
+		const FVector2D& edgeEnd = polygon[vertexIndex];
+
+		/// 奇偶规则判断内外
+		if ((edgeEnd.Y > location.Y) != (edgeStart.Y > location.Y)
+			&& location.X < (edgeStart.X - edgeEnd.X) * (location.Y - edgeEnd.Y) / (edgeStart.Y - edgeEnd.Y) + edgeEnd.X)
+		{
+			bInside = !bInside;
+		}
+
+		/// 鞋带公式累积有向面积，用于确定顶点环绕方向
+		twiceSignedArea += edgeStart.X * edgeEnd.Y - edgeEnd.X * edgeStart.Y;
+
+		const FVector2D edge = edgeEnd - edgeStart;
+		const float edgeLengthSquared = edge.SizeSquared();
+		const float t = edgeLengthSquared > KINDA_SMALL_NUMBER
+			? FMath::Clamp(FVector2D::DotProduct(location - edgeStart, edge) / edgeLengthSquared, 0.0f, 1.0f)
+			: 0.0f;
+		const FVector2D closestPoint = edgeStart + edge * t;
+		const float distanceSquared = FVector2D::DistSquared(location, closestPoint);
+		if (distanceSquared < nearestDistanceSquared)
+		{
+			nearestDistanceSquared = distanceSquared;
+			nearestPoint = closestPoint;
+			nearestEdgeNormal = FVector2D(edge.Y, -edge.X).GetSafeNormal();
+		}
+	}
+
+	const float nearestDistance = FMath::Sqrt(nearestDistanceSquared);
+	outSignedDistance = bInside ? -nearestDistance : nearestDistance;
+
+	/// 边的右手垂线只对逆时针多边形朝外，顺时针多边形需要翻转
+	if (twiceSignedArea < 0.0f)
+	{
+		nearestEdgeNormal = -nearestEdgeNormal;
+	}
+
+	/// 远离边界时法线取最近点连线方向并按内外修正朝向；贴近边界时退化为已按环绕方向修正的边垂线
+	if (nearestDistance > KINDA_SMALL_NUMBER)
+	{
+		outOutwardNormal = (location - nearestPoint) / nearestDistance * (bInside ? -1.0f : 1.0f);
+	}
+	else
+	{
+		outOutwardNormal = nearestEdgeNormal;
+	}
+}
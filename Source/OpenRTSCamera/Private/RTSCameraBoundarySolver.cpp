@@ -0,0 +1,185 @@
+// Copyright 2024 Jesus Bracho All Rights Reserved.
+
+#include "RTSCameraBoundarySolver.h"
+#include "RTSCameraBoundaryField.h"
+
+void FRTSCameraBoundarySolver::setRegion(const FVector& origin, const FVector& extents)
+{
+	if (this->bHasRegion && this->regionOrigin.Equals(origin) && this->regionExtents.Equals(extents))
+	{
+		return;
+	}
+
+	this->bHasRegion = !extents.IsZero();
+	this->regionOrigin = origin;
+	this->regionExtents = extents;
+	this->recalculateTransitionThresholds();
+}
+
+void FRTSCameraBoundarySolver::setBoundaryField(TSharedPtr<const FRTSCameraBoundaryField> field)
+{
+	this->boundaryField = field.IsValid() && field->isValid() ? field : nullptr;
+}
+
+void FRTSCameraBoundarySolver::clearRegion()
+{
+	this->bHasRegion = false;
+	this->regionOrigin = FVector::ZeroVector;
+	this->regionExtents = FVector::ZeroVector;
+	this->boundaryField.Reset();
+}
+
+void FRTSCameraBoundarySolver::setProjection(float fieldOfViewDegrees, float pitchDegrees, float aspectRatio)
+{
+	if (fieldOfViewDegrees == this->cachedFieldOfViewDegrees && pitchDegrees == this->cachedPitchDegrees && aspectRatio == this->cachedAspectRatio)
+	{
+		return;
+	}
+
+	this->cachedFieldOfViewDegrees = fieldOfViewDegrees;
+	this->cachedPitchDegrees = pitchDegrees;
+	this->cachedAspectRatio = aspectRatio;
+	this->recalculateReachFactors();
+}
+
+void FRTSCameraBoundarySolver::setConstraintSettings(float transitionZoneRatio, float constraintStrength, bool bEnableX, bool bEnableY)
+{
+	if (transitionZoneRatio == this->cachedTransitionZoneRatio && constraintStrength == this->cachedConstraintStrength
+		&& bEnableX == this->bEnableXConstraint && bEnableY == this->bEnableYConstraint)
+	{
+		return;
+	}
+
+	this->cachedTransitionZoneRatio = transitionZoneRatio;
+	this->cachedConstraintStrength = constraintStrength;
+	this->bEnableXConstraint = bEnableX;
+	this->bEnableYConstraint = bEnableY;
+	this->recalculateTransitionThresholds();
+}
+
+FVector FRTSCameraBoundarySolver::calculateReachForArmLength(float armLength) const
+{
+	const float pitchAngleInRadians = FMath::DegreesToRadians(FMath::Abs(this->cachedPitchDegrees));
+	const float horizontalFieldOfViewHalf = FMath::DegreesToRadians(this->cachedFieldOfViewDegrees) / 2.0f;
+	const float verticalFieldOfViewHalf = FMath::Atan(FMath::Tan(horizontalFieldOfViewHalf) / FMath::Max(this->cachedAspectRatio, KINDA_SMALL_NUMBER));
+
+	const float z = armLength * FMath::Sin(pitchAngleInRadians);
+	const float slant = z / FMath::Sin(pitchAngleInRadians + verticalFieldOfViewHalf);
+	const float lateralReach = slant * FMath::Tan(horizontalFieldOfViewHalf);
+	const float forwardReach = slant * FMath::Cos(pitchAngleInRadians + verticalFieldOfViewHalf);
+	return FVector(z, lateralReach, forwardReach);
+}
+
+void FRTSCameraBoundarySolver::recalculateReachFactors()
+{
+	if (this->cachedFieldOfViewDegrees <= 0.0f || this->cachedAspectRatio <= 0.0f)
+	{
+		this->lateralReachFactor = 0.0f;
+		this->forwardReachFactor = 0.0f;
+		this->backwardReachFactor = 0.0f;
+		return;
+	}
+
+	/// 各延伸量均与臂长成正比，以单位臂长求出的值即为斜率
+	const FVector unitReach = this->calculateReachForArmLength(1.0f);
+	const float pitchAngleInRadians = FMath::DegreesToRadians(FMath::Abs(this->cachedPitchDegrees));
+	const float horizontalFieldOfViewHalf = FMath::DegreesToRadians(this->cachedFieldOfViewDegrees) / 2.0f;
+	const float verticalFieldOfViewHalf = FMath::Atan(FMath::Tan(horizontalFieldOfViewHalf) / this->cachedAspectRatio);
+
+	/// 计算后向延伸 (Backward Reach)
+	const float slantBottom = unitReach.X / FMath::Sin(pitchAngleInRadians - verticalFieldOfViewHalf);
+	const float backwardReach = slantBottom * FMath::Cos(pitchAngleInRadians - verticalFieldOfViewHalf);
+
+	this->lateralReachFactor = unitReach.Y;
+	this->forwardReachFactor = unitReach.Z;
+	this->backwardReachFactor = backwardReach;
+}
+
+void FRTSCameraBoundarySolver::recalculateTransitionThresholds()
+{
+	/// normalized = |d| / E，alpha = (normalized - safe) / zone  =>  alpha = (|d| - safe * E) / (zone * E)
+	const float safeZoneRatio = 1.0f - this->cachedTransitionZoneRatio;
+	const float zoneRatio = FMath::Max(this->cachedTransitionZoneRatio, 0.01f);
+	const FVector2D extents(FMath::Max(this->regionExtents.X, 1.0f), FMath::Max(this->regionExtents.Y, 1.0f));
+
+	this->transitionStartDistance = extents * safeZoneRatio;
+	this->inverseTransitionWidth = FVector2D(1.0f / (zoneRatio * extents.X), 1.0f / (zoneRatio * extents.Y));
+
+	/// 距离场模式没有独立的轴，过渡区宽度统一按包围盒短边计算
+	this->fieldTransitionWidth = zoneRatio * FMath::Min(extents.X, extents.Y);
+	this->inverseFieldTransitionWidth = 1.0f / this->fieldTransitionWidth;
+}
+
+FVector2D FRTSCameraBoundarySolver::calculateSocketOffset(const FVector2D& rootPlanarLocation, float armLength) const
+{
+	FVector2D socketOffset = FVector2D::ZeroVector;
+	if (!this->bHasRegion)
+	{
+		return socketOffset;
+	}
+
+	const float scaledArmLength = armLength * this->cachedConstraintStrength;
+
+	/// 距离场模式：以到边界的有向距离求触发系数，偏移方向为最近边法线的反方向；
+	/// 法线的 X/Y 分量分别按原有的纵向/横向延伸系数缩放，轴对齐边界时与矩形公式一致
+	if (this->boundaryField.IsValid())
+	{
+		float signedDistance = 0.0f;
+		FVector2D outwardNormal = FVector2D::ZeroVector;
+		this->boundaryField->sample(rootPlanarLocation, signedDistance, outwardNormal);
+
+		const float excess = signedDistance + this->fieldTransitionWidth;
+		if (excess > 0.0f)
+		{
+			const float triggerAlpha = excess * this->inverseFieldTransitionWidth;
+			if (this->bEnableXConstraint)
+			{
+				const float factor = (outwardNormal.X > 0.0f) ? this->forwardReachFactor : this->backwardReachFactor;
+				socketOffset.X = -outwardNormal.X * triggerAlpha * scaledArmLength * factor;
+			}
+			if (this->bEnableYConstraint)
+			{
+				socketOffset.Y = -outwardNormal.Y * triggerAlpha * scaledArmLength * this->lateralReachFactor;
+			}
+		}
+		return socketOffset;
+	}
+
+	/// 南北向由于 Pitch 倾角是不对称的：北端使用前向延伸，南端使用后向延伸，偏移方向始终指向区域中心
+	const float differenceX = rootPlanarLocation.X - this->regionOrigin.X;
+	const float excessX = FMath::Abs(differenceX) - this->transitionStartDistance.X;
+	if (this->bEnableXConstraint && excessX > 0.0f)
+	{
+		const float triggerAlpha = excessX * this->inverseTransitionWidth.X;
+		const float factor = (differenceX > 0.0f) ? this->forwardReachFactor : this->backwardReachFactor;
+		socketOffset.X = ((differenceX > 0.0f) ? -1.0f : 1.0f) * triggerAlpha * scaledArmLength * factor;
+	}
+
+	const float differenceY = rootPlanarLocation.Y - this->regionOrigin.Y;
+	const float excessY = FMath::Abs(differenceY) - this->transitionStartDistance.Y;
+	if (this->bEnableYConstraint && excessY > 0.0f)
+	{
+		const float triggerAlpha = excessY * this->inverseTransitionWidth.Y;
+		socketOffset.Y = ((differenceY > 0.0f) ? -1.0f : 1.0f) * triggerAlpha * scaledArmLength * this->lateralReachFactor;
+	}
+
+	return socketOffset;
+}
+
+FVector2D FRTSCameraBoundarySolver::clampPlanarLocation(const FVector2D& rootPlanarLocation) const
+{
+	if (!this->bHasRegion)
+	{
+		return rootPlanarLocation;
+	}
+
+	if (this->boundaryField.IsValid())
+	{
+		return this->boundaryField->clampInside(rootPlanarLocation);
+	}
+
+	return FVector2D(
+		FMath::Clamp(rootPlanarLocation.X, this->regionOrigin.X - this->regionExtents.X, this->regionOrigin.X + this->regionExtents.X),
+		FMath::Clamp(rootPlanarLocation.Y, this->regionOrigin.Y - this->regionExtents.Y, this->regionOrigin.Y + this->regionExtents.Y)
+	);
+}
@@ -2,14 +2,107 @@
 
 #include "RTSCameraBoundsVolume.h"
 #include "Components/PrimitiveComponent.h"
+#include "Components/SplineComponent.h"
+#include "Engine/World.h"
+#include "RTSCameraBoundaryField.h"
+#include "RTSCameraRegionSubsystem.h"
 
 ARTSCameraBoundsVolume::ARTSCameraBoundsVolume()
 {
-	// Default constructor
+	this->RegionPriority = 0;
+	this->bRegionEnabled = true;
+	this->BoundaryShape = ERTSCameraBoundaryShape::Box;
+	this->BoundarySplineSampleSpacing = 500.0f;
+	this->BoundaryFieldCellSize = 200.0f;
+
+	this->BoundarySpline = CreateDefaultSubobject<USplineComponent>(TEXT("BoundarySpline"));
+	this->BoundarySpline->SetupAttachment(this->RootComponent);
+	this->BoundarySpline->SetClosedLoop(true);
 }
 
 void ARTSCameraBoundsVolume::BeginPlay()
 {
 	Super::BeginPlay();
-	Tags.AddUnique(FName("OpenRTSCamera#CameraBounds"));
+
+	/// 先烘焙距离场再登记，注册表据此计算区域范围
+	this->RebuildBoundaryField();
+
+	/// 向区域注册表登记自身，相机通过空间查询而非标签遍历找到活动区域
+	if (URTSCameraRegionSubsystem* regionSubsystem = this->GetWorld()->GetSubsystem<URTSCameraRegionSubsystem>())
+	{
+		regionSubsystem->RegisterRegion(this, this->RegionPriority, this->bRegionEnabled);
+	}
+}
+
+void ARTSCameraBoundsVolume::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (URTSCameraRegionSubsystem* regionSubsystem = this->GetWorld()->GetSubsystem<URTSCameraRegionSubsystem>())
+	{
+		regionSubsystem->UnregisterRegion(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void ARTSCameraBoundsVolume::SetRegionEnabled(const bool bEnabled)
+{
+	this->bRegionEnabled = bEnabled;
+	if (URTSCameraRegionSubsystem* regionSubsystem = this->GetWorld()->GetSubsystem<URTSCameraRegionSubsystem>())
+	{
+		regionSubsystem->SetRegionEnabled(this, bEnabled);
+	}
+}
+
+void ARTSCameraBoundsVolume::RebuildBoundaryField()
+{
+	TArray<FVector2D> polygon;
+	if (!this->CollectBoundaryPolygon(polygon))
+	{
+		this->BoundaryField.Reset();
+		return;
+	}
+
+	/// 每次重建都生成新对象，已持有旧距离场的相机在下一次区域同步前仍可安全读取
+	TSharedPtr<FRTSCameraBoundaryField> bakedField = MakeShared<FRTSCameraBoundaryField>();
+	if (!bakedField->bake(polygon, this->BoundaryFieldCellSize))
+	{
+		this->BoundaryField.Reset();
+		return;
+	}
+	this->BoundaryField = bakedField;
+}
+
+bool ARTSCameraBoundsVolume::CollectBoundaryPolygon(TArray<FVector2D>& OutPolygon) const
+{
+	OutPolygon.Reset();
+	switch (this->BoundaryShape)
+	{
+	case ERTSCameraBoundaryShape::Polygon:
+	{
+		const FTransform& actorTransform = this->GetActorTransform();
+		for (const FVector& localPoint : this->BoundaryPolygonPoints)
+		{
+			OutPolygon.Add(FVector2D(actorTransform.TransformPosition(localPoint)));
+		}
+		break;
+	}
+	case ERTSCameraBoundaryShape::Spline:
+	{
+		if (this->BoundarySpline == nullptr)
+		{
+			break;
+		}
+		const float splineLength = this->BoundarySpline->GetSplineLength();
+		const int32 sampleCount = FMath::Max(FMath::CeilToInt(splineLength / FMath::Max(this->BoundarySplineSampleSpacing, 10.0f)), 3);
+		for (int32 sampleIndex = 0; sampleIndex < sampleCount; ++sampleIndex)
+		{
+			const float distance = splineLength * sampleIndex / sampleCount;
+			OutPolygon.Add(FVector2D(this->BoundarySpline->GetLocationAtDistanceAlongSpline(distance, ESplineCoordinateSpace::World)));
+		}
+		break;
+	}
+	default:
+		break;
+	}
+	return OutPolygon.Num() >= 3;
 }
@@ -0,0 +1,330 @@
+// Copyright 2024 Jesus Bracho All Rights Reserved.
+
+#include "RTSCameraFrustumQuery.h"
+
+#include "RTSCameraSnapshot.h"
+
+void FRTSCameraFrustumQuery::build(const FRTSCameraSnapshot& snapshot, const float nearClipDistance, const float farClipDistance)
+{
+	this->origin = snapshot.Location;
+
+	/// 与 URTSCamera::projectFrustumGroundCorners 相同的约定：FieldOfView 为水平视角，垂直视角由长宽比导出
+	const float tangentHorizontal = FMath::Tan(FMath::DegreesToRadians(snapshot.FieldOfView) / 2.0f);
+	const float tangentVertical = tangentHorizontal / FMath::Max(snapshot.AspectRatio, KINDA_SMALL_NUMBER);
+
+	const FVector forwardVector = snapshot.Rotation.GetForwardVector();
+	const FVector rightVector = snapshot.Rotation.GetRightVector();
+	const FVector upVector = snapshot.Rotation.GetUpVector();
+
+	/// 侧面平面经过相机位置，法线与对应边界射线正交并朝向视锥内部
+	const FVector planeNormals[6] = {
+		(rightVector + forwardVector * tangentHorizontal).GetSafeNormal(),
+		(-rightVector + forwardVector * tangentHorizontal).GetSafeNormal(),
+		(-upVector + forwardVector * tangentVertical).GetSafeNormal(),
+		(upVector + forwardVector * tangentVertical).GetSafeNormal(),
+		forwardVector,
+		-forwardVector
+	};
+	const float planeOffsets[6] = { 0.0f, 0.0f, 0.0f, 0.0f, -nearClipDistance, farClipDistance };
+
+	for (int32 planeIndex = 0; planeIndex < 6; ++planeIndex)
+	{
+		this->planeX[planeIndex] = planeNormals[planeIndex].X;
+		this->planeY[planeIndex] = planeNormals[planeIndex].Y;
+		this->planeZ[planeIndex] = planeNormals[planeIndex].Z;
+		this->planeW[planeIndex] = planeOffsets[planeIndex];
+	}
+
+	/// 角点射线按左上、右上、右下、左下排列
+	this->cornerDirections[0] = (forwardVector - rightVector * tangentHorizontal + upVector * tangentVertical).GetSafeNormal();
+	this->cornerDirections[1] = (forwardVector + rightVector * tangentHorizontal + upVector * tangentVertical).GetSafeNormal();
+	this->cornerDirections[2] = (forwardVector + rightVector * tangentHorizontal - upVector * tangentVertical).GetSafeNormal();
+	this->cornerDirections[3] = (forwardVector - rightVector * tangentHorizontal - upVector * tangentVertical).GetSafeNormal();
+
+	/// 地面四边形：按有向面积统一绕序，使各边法线朝内
+	FVector2D relativeCorners[4];
+	float signedArea = 0.0f;
+	this->groundQuadCenter = FVector2D::ZeroVector;
+	for (int32 cornerIndex = 0; cornerIndex < 4; ++cornerIndex)
+	{
+		relativeCorners[cornerIndex] = FVector2D(snapshot.GroundCorners[cornerIndex] - this->origin);
+		this->groundQuadCenter += FVector2D(snapshot.GroundCorners[cornerIndex]) * 0.25f;
+	}
+	for (int32 cornerIndex = 0; cornerIndex < 4; ++cornerIndex)
+	{
+		signedArea += FVector2D::CrossProduct(relativeCorners[cornerIndex], relativeCorners[(cornerIndex + 1) % 4]);
+	}
+	const float winding = signedArea >= 0.0f ? 1.0f : -1.0f;
+
+	this->groundQuadRadius = 0.0f;
+	for (int32 cornerIndex = 0; cornerIndex < 4; ++cornerIndex)
+	{
+		const FVector2D& a = relativeCorners[cornerIndex];
+		const FVector2D& b = relativeCorners[(cornerIndex + 1) % 4];
+		const FVector2D normal = FVector2D(-(b.Y - a.Y), b.X - a.X).GetSafeNormal() * winding;
+		this->edgeNormalX[cornerIndex] = normal.X;
+		this->edgeNormalY[cornerIndex] = normal.Y;
+		this->edgeOffsets[cornerIndex] = -FVector2D::DotProduct(normal, a);
+		this->groundQuadRadius = FMath::Max(this->groundQuadRadius, FVector2D::Distance(FVector2D(snapshot.GroundCorners[cornerIndex]), this->groundQuadCenter));
+	}
+
+	this->bValid = true;
+}
+
+bool FRTSCameraFrustumQuery::buildFromCornerRays(const FVector& eye, const FVector (&inCornerDirections)[4], const float nearClipDistance, const float farClipDistance)
+{
+	this->bValid = false;
+	this->origin = eye;
+
+	FVector centerDirection = FVector::ZeroVector;
+	for (int32 cornerIndex = 0; cornerIndex < 4; ++cornerIndex)
+	{
+		this->cornerDirections[cornerIndex] = inCornerDirections[cornerIndex].GetSafeNormal();
+		centerDirection += this->cornerDirections[cornerIndex];
+	}
+	if (!centerDirection.Normalize(UE_SMALL_NUMBER))
+	{
+		return false;
+	}
+
+	/// 相邻射线张成侧面；以选区中心方向统一法线朝向，使调用方无需关心绕序
+	for (int32 planeIndex = 0; planeIndex < 4; ++planeIndex)
+	{
+		FVector normal = FVector::CrossProduct(this->cornerDirections[planeIndex], this->cornerDirections[(planeIndex + 1) % 4]);
+		if (!normal.Normalize(UE_SMALL_NUMBER))
+		{
+			return false;
+		}
+		if (FVector::DotProduct(normal, centerDirection) < 0.0)
+		{
+			normal = -normal;
+		}
+		this->planeX[planeIndex] = normal.X;
+		this->planeY[planeIndex] = normal.Y;
+		this->planeZ[planeIndex] = normal.Z;
+		this->planeW[planeIndex] = 0.0f;
+	}
+
+	const FVector capNormals[2] = { centerDirection, -centerDirection };
+	const float capOffsets[2] = { -nearClipDistance, farClipDistance };
+	for (int32 capIndex = 0; capIndex < 2; ++capIndex)
+	{
+		this->planeX[4 + capIndex] = capNormals[capIndex].X;
+		this->planeY[4 + capIndex] = capNormals[capIndex].Y;
+		this->planeZ[4 + capIndex] = capNormals[capIndex].Z;
+		this->planeW[4 + capIndex] = capOffsets[capIndex];
+	}
+
+	/// 没有地面四边形：清零后各边距离恒为 0
+	FMemory::Memzero(this->edgeNormalX, sizeof(this->edgeNormalX));
+	FMemory::Memzero(this->edgeNormalY, sizeof(this->edgeNormalY));
+	FMemory::Memzero(this->edgeOffsets, sizeof(this->edgeOffsets));
+	this->groundQuadCenter = FVector2D(eye);
+	this->groundQuadRadius = 0.0f;
+
+	this->bValid = true;
+	return true;
+}
+
+bool FRTSCameraFrustumQuery::getGroundBounds(const float minZ, const float maxZ, FBox2D& outGroundBox) const
+{
+	/// 视锥与高度层的交集是各射线与上下两个平面交点（以及位于层内的视点）的凸包，其水平包围盒即为所求
+	outGroundBox = FBox2D(ForceInit);
+	for (const FVector& direction : this->cornerDirections)
+	{
+		if (direction.Z > -KINDA_SMALL_NUMBER)
+		{
+			return false;
+		}
+		for (const float layerZ : { minZ, maxZ })
+		{
+			const double distance = (layerZ - this->origin.Z) / direction.Z;
+			if (distance > 0.0)
+			{
+				outGroundBox += FVector2D(this->origin + direction * distance);
+			}
+		}
+	}
+	if (this->origin.Z >= minZ && this->origin.Z <= maxZ)
+	{
+		outGroundBox += FVector2D(this->origin);
+	}
+
+	/// 视点低于整个高度层时没有交点，返回无效的包围盒，表示范围为空
+	return true;
+}
+
+bool FRTSCameraFrustumQuery::isPointVisible(const FVector& location) const
+{
+	return this->isSphereVisible(location, 0.0f);
+}
+
+bool FRTSCameraFrustumQuery::isSphereVisible(const FVector& center, const float radius) const
+{
+	const FVector3f relative(center - this->origin);
+	for (int32 planeIndex = 0; planeIndex < 6; ++planeIndex)
+	{
+		if (this->planeX[planeIndex] * relative.X + this->planeY[planeIndex] * relative.Y + this->planeZ[planeIndex] * relative.Z + this->planeW[planeIndex] < -radius)
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+bool FRTSCameraFrustumQuery::isPointInGroundQuad(const FVector& location, const float margin) const
+{
+	const FVector2f relative(FVector2D(location - this->origin));
+	for (int32 edgeIndex = 0; edgeIndex < 4; ++edgeIndex)
+	{
+		if (this->edgeNormalX[edgeIndex] * relative.X + this->edgeNormalY[edgeIndex] * relative.Y + this->edgeOffsets[edgeIndex] < -margin)
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+VectorRegister4Float FRTSCameraFrustumQuery::frustumDistance4(const VectorRegister4Float relativeX, const VectorRegister4Float relativeY, const VectorRegister4Float relativeZ) const
+{
+	VectorRegister4Float minDistance;
+	for (int32 planeIndex = 0; planeIndex < 6; ++planeIndex)
+	{
+		const VectorRegister4Float distance = VectorMultiplyAdd(VectorSetFloat1(this->planeX[planeIndex]), relativeX,
+			VectorMultiplyAdd(VectorSetFloat1(this->planeY[planeIndex]), relativeY,
+				VectorMultiplyAdd(VectorSetFloat1(this->planeZ[planeIndex]), relativeZ, VectorSetFloat1(this->planeW[planeIndex]))));
+		minDistance = planeIndex == 0 ? distance : VectorMin(minDistance, distance);
+	}
+	return minDistance;
+}
+
+VectorRegister4Float FRTSCameraFrustumQuery::frustumBoxDistance4(
+	const VectorRegister4Float relativeX,
+	const VectorRegister4Float relativeY,
+	const VectorRegister4Float relativeZ,
+	const VectorRegister4Float extentX,
+	const VectorRegister4Float extentY,
+	const VectorRegister4Float extentZ
+) const
+{
+	/// 正顶点到平面的距离 = 中心距离 + |n|·extent
+	VectorRegister4Float minDistance;
+	for (int32 planeIndex = 0; planeIndex < 6; ++planeIndex)
+	{
+		const VectorRegister4Float centerDistance = VectorMultiplyAdd(VectorSetFloat1(this->planeX[planeIndex]), relativeX,
+			VectorMultiplyAdd(VectorSetFloat1(this->planeY[planeIndex]), relativeY,
+				VectorMultiplyAdd(VectorSetFloat1(this->planeZ[planeIndex]), relativeZ, VectorSetFloat1(this->planeW[planeIndex]))));
+		const VectorRegister4Float projectedExtent = VectorMultiplyAdd(VectorSetFloat1(FMath::Abs(this->planeX[planeIndex])), extentX,
+			VectorMultiplyAdd(VectorSetFloat1(FMath::Abs(this->planeY[planeIndex])), extentY,
+				VectorMultiply(VectorSetFloat1(FMath::Abs(this->planeZ[planeIndex])), extentZ)));
+		const VectorRegister4Float distance = VectorAdd(centerDistance, projectedExtent);
+		minDistance = planeIndex == 0 ? distance : VectorMin(minDistance, distance);
+	}
+	return minDistance;
+}
+
+void FRTSCameraFrustumQuery::loadRelative4(TConstArrayView<FVector> locations, const int32 firstIndex, VectorRegister4Float& outX, VectorRegister4Float& outY, VectorRegister4Float& outZ) const
+{
+	/// 位置为双精度 AoS，先在双精度下减去原点再转置为单精度 SoA
+	MS_ALIGN(16) float laneX[4] GCC_ALIGN(16);
+	MS_ALIGN(16) float laneY[4] GCC_ALIGN(16);
+	MS_ALIGN(16) float laneZ[4] GCC_ALIGN(16);
+	const int32 lastIndex = locations.Num() - 1;
+	for (int32 lane = 0; lane < 4; ++lane)
+	{
+		const FVector relative = locations[FMath::Min(firstIndex + lane, lastIndex)] - this->origin;
+		laneX[lane] = relative.X;
+		laneY[lane] = relative.Y;
+		laneZ[lane] = relative.Z;
+	}
+	outX = VectorLoadAligned(laneX);
+	outY = VectorLoadAligned(laneY);
+	outZ = VectorLoadAligned(laneZ);
+}
+
+void FRTSCameraFrustumQuery::testPointsVisible(TConstArrayView<FVector> locations, TArrayView<uint32> outMask) const
+{
+	const int32 num = locations.Num();
+	check(outMask.Num() >= getMaskWordCount(num));
+	FMemory::Memzero(outMask.GetData(), getMaskWordCount(num) * sizeof(uint32));
+
+	for (int32 firstIndex = 0; firstIndex < num; firstIndex += 4)
+	{
+		VectorRegister4Float relativeX, relativeY, relativeZ;
+		this->loadRelative4(locations, firstIndex, relativeX, relativeY, relativeZ);
+
+		const VectorRegister4Float distance = this->frustumDistance4(relativeX, relativeY, relativeZ);
+		const uint32 laneMask = (uint32)VectorMaskBits(VectorCompareGE(distance, GlobalVectorConstants::FloatZero)) & ((1u << FMath::Min(4, num - firstIndex)) - 1u);
+		outMask[firstIndex >> 5] |= laneMask << (firstIndex & 31);
+	}
+}
+
+void FRTSCameraFrustumQuery::testSpheresVisible(TConstArrayView<FVector> centers, TConstArrayView<float> radii, TArrayView<uint32> outMask) const
+{
+	const int32 num = centers.Num();
+	check(radii.Num() == num && outMask.Num() >= getMaskWordCount(num));
+	FMemory::Memzero(outMask.GetData(), getMaskWordCount(num) * sizeof(uint32));
+
+	for (int32 firstIndex = 0; firstIndex < num; firstIndex += 4)
+	{
+		VectorRegister4Float relativeX, relativeY, relativeZ;
+		this->loadRelative4(centers, firstIndex, relativeX, relativeY, relativeZ);
+
+		const int32 laneCount = FMath::Min(4, num - firstIndex);
+		const VectorRegister4Float radius = laneCount == 4
+			? VectorLoad(&radii[firstIndex])
+			: MakeVectorRegisterFloat(radii[firstIndex], radii[firstIndex + FMath::Min(1, laneCount - 1)], radii[firstIndex + FMath::Min(2, laneCount - 1)], radii[firstIndex + laneCount - 1]);
+
+		const VectorRegister4Float distance = this->frustumDistance4(relativeX, relativeY, relativeZ);
+		const uint32 laneMask = (uint32)VectorMaskBits(VectorCompareGE(VectorAdd(distance, radius), GlobalVectorConstants::FloatZero)) & ((1u << laneCount) - 1u);
+		outMask[firstIndex >> 5] |= laneMask << (firstIndex & 31);
+	}
+}
+
+void FRTSCameraFrustumQuery::testBoxesVisible(TConstArrayView<FVector> centers, TConstArrayView<FVector3f> extents, TArrayView<uint32> outMask) const
+{
+	const int32 num = centers.Num();
+	check(extents.Num() == num && outMask.Num() >= getMaskWordCount(num));
+	FMemory::Memzero(outMask.GetData(), getMaskWordCount(num) * sizeof(uint32));
+
+	MS_ALIGN(16) float laneExtentX[4] GCC_ALIGN(16);
+	MS_ALIGN(16) float laneExtentY[4] GCC_ALIGN(16);
+	MS_ALIGN(16) float laneExtentZ[4] GCC_ALIGN(16);
+	for (int32 firstIndex = 0; firstIndex < num; firstIndex += 4)
+	{
+		VectorRegister4Float relativeX, relativeY, relativeZ;
+		this->loadRelative4(centers, firstIndex, relativeX, relativeY, relativeZ);
+
+		const int32 laneCount = FMath::Min(4, num - firstIndex);
+		for (int32 lane = 0; lane < 4; ++lane)
+		{
+			const FVector3f& extent = extents[firstIndex + FMath::Min(lane, laneCount - 1)];
+			laneExtentX[lane] = extent.X;
+			laneExtentY[lane] = extent.Y;
+			laneExtentZ[lane] = extent.Z;
+		}
+
+		const VectorRegister4Float distance = this->frustumBoxDistance4(relativeX, relativeY, relativeZ,
+			VectorLoadAligned(laneExtentX), VectorLoadAligned(laneExtentY), VectorLoadAligned(laneExtentZ));
+		const uint32 laneMask = (uint32)VectorMaskBits(VectorCompareGE(distance, GlobalVectorConstants::FloatZero)) & ((1u << laneCount) - 1u);
+		outMask[firstIndex >> 5] |= laneMask << (firstIndex & 31);
+	}
+}
+
+void FRTSCameraFrustumQuery::testPointsInGroundQuad(TConstArrayView<FVector> locations, const float margin, TArrayView<uint32> outMask) const
+{
+	const int32 num = locations.Num();
+	check(outMask.Num() >= getMaskWordCount(num));
+	FMemory::Memzero(outMask.GetData(), getMaskWordCount(num) * sizeof(uint32));
+
+	const VectorRegister4Float negativeMargin = VectorSetFloat1(-margin);
+	for (int32 firstIndex = 0; firstIndex < num; firstIndex += 4)
+	{
+		VectorRegister4Float relativeX, relativeY, relativeZ;
+		this->loadRelative4(locations, firstIndex, relativeX, relativeY, relativeZ);
+
+		const VectorRegister4Float distance = this->groundQuadDistance4(relativeX, relativeY);
+		const uint32 laneMask = (uint32)VectorMaskBits(VectorCompareGE(distance, negativeMargin)) & ((1u << FMath::Min(4, num - firstIndex)) - 1u);
+		outMask[firstIndex >> 5] |= laneMask << (firstIndex & 31);
+	}
+}
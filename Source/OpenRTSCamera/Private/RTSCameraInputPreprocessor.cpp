@@ -0,0 +1,60 @@
+// Copyright 2024 Jesus Bracho All Rights Reserved.
+
+#include "RTSCameraInputPreprocessor.h"
+#include "Input/Events.h"
+
+namespace
+{
+	/// 定点位置的缩放系数：1/16 像素
+	constexpr double positionFixedPointScale = 16.0;
+
+	int64 packPosition(const FVector2D& screenPosition)
+	{
+		const uint32 fixedX = static_cast<uint32>(FMath::RoundToInt32(screenPosition.X * positionFixedPointScale));
+		const uint32 fixedY = static_cast<uint32>(FMath::RoundToInt32(screenPosition.Y * positionFixedPointScale));
+		return static_cast<int64>((static_cast<uint64>(fixedX) << 32) | fixedY);
+	}
+
+	FVector2D unpackPosition(const int64 packedPosition)
+	{
+		const int32 fixedX = static_cast<int32>(static_cast<uint64>(packedPosition) >> 32);
+		const int32 fixedY = static_cast<int32>(static_cast<uint64>(packedPosition) & 0xFFFFFFFFull);
+		return FVector2D(fixedX, fixedY) / positionFixedPointScale;
+	}
+}
+
+FRTSCameraInputPreprocessor::FRTSCameraInputPreprocessor()
+	: latestPackedPosition(0)
+	, bHasPosition(false)
+{
+}
+
+void FRTSCameraInputPreprocessor::Tick(const float, FSlateApplication&, TSharedRef<ICursor>)
+{
+}
+
+bool FRTSCameraInputPreprocessor::HandleMouseMoveEvent(FSlateApplication&, const FPointerEvent& MouseEvent)
+{
+	/// 先写位置再置位，读取侧看到标记时位置必然已就绪
+	this->latestPackedPosition.store(packPosition(MouseEvent.GetScreenSpacePosition()));
+	this->bHasPosition.store(true);
+
+	/// 仅观察，不消费事件
+	return false;
+}
+
+bool FRTSCameraInputPreprocessor::drain(FVector2D& outScreenPosition) const
+{
+	if (!this->bHasPosition.load())
+	{
+		return false;
+	}
+
+	outScreenPosition = unpackPosition(this->latestPackedPosition.load());
+	return true;
+}
+
+void FRTSCameraInputPreprocessor::resetSampleWindow()
+{
+	this->bHasPosition.store(false);
+}
@@ -0,0 +1,321 @@
+// Copyright 2024 Jesus Bracho All Rights Reserved.
+
+#include "RTSCameraManagerSubsystem.h"
+
+#include "Async/ParallelFor.h"
+#include "Engine/Level.h"
+#include "Engine/World.h"
+#include "OpenRTSCamera.h"
+#include "RTSCamera.h"
+#include "RTSCameraScreenBins.h"
+
+DECLARE_CYCLE_STAT(TEXT("Camera Manager Gather"), STAT_RTSCameraManagerGather, STATGROUP_OpenRTSCamera);
+DECLARE_CYCLE_STAT(TEXT("Camera Manager Solve"), STAT_RTSCameraManagerSolve, STATGROUP_OpenRTSCamera);
+DECLARE_CYCLE_STAT(TEXT("Camera Manager Apply"), STAT_RTSCameraManagerApply, STATGROUP_OpenRTSCamera);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Batched Cameras"), STAT_RTSCameraManagerBatchedCameras, STATGROUP_OpenRTSCamera);
+
+void FRTSCameraManagerTickFunction::ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent)
+{
+	if (this->Manager != nullptr)
+	{
+		this->Manager->TickCameras(DeltaTime);
+	}
+}
+
+FString FRTSCameraManagerTickFunction::DiagnosticMessage()
+{
+	return TEXT("URTSCameraManagerSubsystem::TickCameras");
+}
+
+FName FRTSCameraManagerTickFunction::DiagnosticContext(bool bDetailed)
+{
+	return FName(TEXT("RTSCameraManager"));
+}
+
+void URTSCameraManagerSubsystem::FFrameState::Reset(const int32 Capacity)
+{
+	Cameras.Reset(Capacity);
+	Flags.Reset(Capacity);
+	RootLocations.Reset(Capacity);
+	ArmLengths.Reset(Capacity);
+	DesiredArmLengths.Reset(Capacity);
+	ArmCatchupSpeeds.Reset(Capacity);
+	Solvers.Reset(Capacity);
+	SocketOffsets.Reset(Capacity);
+	ArmOriginOffsets.Reset(Capacity);
+	ArmRotations.Reset(Capacity);
+	CameraRelativeRotations.Reset(Capacity);
+	FieldOfViews.Reset(Capacity);
+	AspectRatios.Reset(Capacity);
+	CornerAltitudes.Reset(Capacity * 4);
+	FrustumCorners.Reset(Capacity * 4);
+}
+
+bool URTSCameraManagerSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void URTSCameraManagerSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+	this->PrimarySnapshotChannel = MakeShared<FRTSCameraSnapshotChannel, ESPMode::ThreadSafe>();
+	this->PrimaryScreenBins = MakeShared<FRTSCameraScreenBins, ESPMode::ThreadSafe>();
+}
+
+void URTSCameraManagerSubsystem::Deinitialize()
+{
+	if (this->TickFunction.IsTickFunctionRegistered())
+	{
+		this->TickFunction.UnRegisterTickFunction();
+	}
+	this->TickFunction.Manager = nullptr;
+	this->Cameras.Reset();
+	this->FrameState.Reset(0);
+
+	Super::Deinitialize();
+}
+
+void URTSCameraManagerSubsystem::RegisterCamera(URTSCamera* Camera)
+{
+	if (Camera == nullptr || this->Cameras.Contains(Camera))
+	{
+		return;
+	}
+
+	this->EnsureTickFunctionRegistered();
+	this->Cameras.Add(Camera);
+	this->RefreshTickGroup();
+
+	/// 弹簧臂在管理器写回臂长与 SocketOffset 之后才求解本帧位姿
+	if (Camera->springArmComponent != nullptr)
+	{
+		Camera->springArmComponent->PrimaryComponentTick.AddPrerequisite(this, this->TickFunction);
+	}
+	this->TickFunction.SetTickFunctionEnable(true);
+}
+
+void URTSCameraManagerSubsystem::UnregisterCamera(URTSCamera* Camera)
+{
+	if (this->Cameras.Remove(Camera) == 0)
+	{
+		return;
+	}
+
+	if (Camera->springArmComponent != nullptr)
+	{
+		Camera->springArmComponent->PrimaryComponentTick.RemovePrerequisite(this, this->TickFunction);
+	}
+	this->RefreshTickGroup();
+	if (this->Cameras.Num() == 0 && this->TickFunction.IsTickFunctionRegistered())
+	{
+		this->TickFunction.SetTickFunctionEnable(false);
+	}
+}
+
+void URTSCameraManagerSubsystem::NotifyCameraAwake(URTSCamera* Camera)
+{
+	if (this->TickFunction.IsTickFunctionRegistered())
+	{
+		this->TickFunction.SetTickFunctionEnable(true);
+	}
+}
+
+void URTSCameraManagerSubsystem::PublishPrimarySnapshot(const FRTSCameraSnapshot& Snapshot)
+{
+	this->PrimarySnapshotChannel->publish(Snapshot);
+}
+
+void URTSCameraManagerSubsystem::EnsureTickFunctionRegistered()
+{
+	if (this->TickFunction.IsTickFunctionRegistered())
+	{
+		return;
+	}
+
+	UWorld* world = this->GetWorld();
+	if (world == nullptr || world->PersistentLevel == nullptr)
+	{
+		return;
+	}
+
+	this->TickFunction.Manager = this;
+	this->TickFunction.bCanEverTick = true;
+	this->TickFunction.bStartWithTickEnabled = true;
+	this->TickFunction.bAllowTickOnDedicatedServer = false;
+	this->TickFunction.TickGroup = TG_PrePhysics;
+	this->TickFunction.RegisterTickFunction(world->PersistentLevel);
+}
+
+void URTSCameraManagerSubsystem::RefreshTickGroup()
+{
+	/// 同一批次只能处于一个 Tick 组；延迟更新只会缩短其他相机的输入延迟，不会改变其行为
+	bool bAnyLateUpdate = false;
+	for (const URTSCamera* camera : this->Cameras)
+	{
+		bAnyLateUpdate |= IsValid(camera) && camera->enableLateUpdate;
+	}
+	this->TickFunction.TickGroup = bAnyLateUpdate ? TG_LastDemotable : TG_PrePhysics;
+	this->TickFunction.EndTickGroup = this->TickFunction.TickGroup;
+}
+
+void URTSCameraManagerSubsystem::TickCameras(const float DeltaTime)
+{
+	this->GatherFrameState(DeltaTime);
+	SET_DWORD_STAT(STAT_RTSCameraManagerBatchedCameras, this->FrameState.Num());
+
+	if (this->FrameState.Num() > 0)
+	{
+		this->SolveFrameState(DeltaTime);
+		this->ApplyFrameState();
+	}
+
+	/// 全部相机休眠后关闭管理器 Tick，任一相机唤醒时重新开启
+	bool bAnyCameraAwake = false;
+	for (const URTSCamera* camera : this->Cameras)
+	{
+		if (IsValid(camera) && !camera->bIsTickSleeping)
+		{
+			bAnyCameraAwake = true;
+			break;
+		}
+	}
+	if (!bAnyCameraAwake)
+	{
+		this->TickFunction.SetTickFunctionEnable(false);
+	}
+}
+
+void URTSCameraManagerSubsystem::GatherFrameState(const float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_RTSCameraManagerGather);
+
+	FFrameState& state = this->FrameState;
+	state.Reset(this->Cameras.Num());
+
+	for (URTSCamera* camera : this->Cameras)
+	{
+		if (!IsValid(camera) || camera->bIsTickSleeping || camera->rootComponent == nullptr || camera->springArmComponent == nullptr)
+		{
+			continue;
+		}
+
+		/// 固定步长模式在模拟步内自行插值臂长，其余相机的缩放插值留到求解阶段
+		const bool bInterpolateArmLength = !camera->enableFixedTimestepSimulation;
+		if (!camera->advanceCameraFrame(DeltaTime, bInterpolateArmLength))
+		{
+			continue;
+		}
+
+		const FVector rootLocation = camera->stageCommitLocation();
+		const USpringArmComponent* springArm = camera->springArmComponent;
+		const UCameraComponent* cameraComponent = camera->cameraComponent;
+
+		uint8 flags = 0;
+		flags |= bInterpolateArmLength ? FFrameState::InterpolateArmLength : 0;
+		flags |= (camera->bMinimapFrustumRefreshRequested && cameraComponent != nullptr) ? FFrameState::ResolveFrustum : 0;
+
+		state.Cameras.Add(camera);
+		state.Flags.Add(flags);
+		state.RootLocations.Add(rootLocation);
+		state.ArmLengths.Add(springArm->TargetArmLength);
+		state.DesiredArmLengths.Add(camera->desiredZoomLength);
+		state.ArmCatchupSpeeds.Add(camera->zoomCatchupSpeed);
+		state.Solvers.Add(camera->boundarySolver.hasRegion() ? &camera->boundarySolver : nullptr);
+		state.SocketOffsets.Add(springArm->SocketOffset);
+		state.ArmOriginOffsets.Add(springArm->GetComponentLocation() - camera->rootComponent->GetComponentLocation() + springArm->TargetOffset);
+		state.ArmRotations.Add(springArm->GetComponentQuat());
+		state.CameraRelativeRotations.Add(cameraComponent != nullptr ? cameraComponent->GetRelativeRotation().Quaternion() : FQuat::Identity);
+		state.FieldOfViews.Add(cameraComponent != nullptr ? cameraComponent->FieldOfView : 0.0f);
+		state.AspectRatios.Add(cameraComponent != nullptr ? camera->calculateFrustumAspectRatio() : 1.0f);
+
+		const int32 firstCorner = state.CornerAltitudes.AddUninitialized(4);
+		camera->resolveFrustumCornerAltitudes(rootLocation.Z, &state.CornerAltitudes[firstCorner]);
+	}
+
+	state.FrustumCorners.SetNumUninitialized(state.Num() * 4);
+}
+
+void URTSCameraManagerSubsystem::SolveFrameState(const float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_RTSCameraManagerSolve);
+
+	FFrameState& state = this->FrameState;
+	const int32 cameraCount = state.Num();
+
+	/// 每个相机的求解只读写自身下标的元素，求解器与投影均为无副作用的纯计算
+	ParallelFor(
+		cameraCount,
+		[&state, DeltaTime](const int32 index)
+		{
+			const uint8 flags = state.Flags[index];
+			float& armLength = state.ArmLengths[index];
+			if (flags & FFrameState::InterpolateArmLength)
+			{
+				armLength = FMath::FInterpTo(armLength, state.DesiredArmLengths[index], DeltaTime, state.ArmCatchupSpeeds[index]);
+			}
+
+			FVector& rootLocation = state.RootLocations[index];
+			FVector& socketOffset = state.SocketOffsets[index];
+			if (const FRTSCameraBoundarySolver* solver = state.Solvers[index])
+			{
+				const FVector2D boundaryOffset = solver->calculateSocketOffset(FVector2D(rootLocation), armLength);
+				socketOffset.X = boundaryOffset.X;
+				socketOffset.Y = boundaryOffset.Y;
+
+				const FVector2D clampedLocation = solver->clampPlanarLocation(FVector2D(rootLocation));
+				rootLocation.X = clampedLocation.X;
+				rootLocation.Y = clampedLocation.Y;
+			}
+
+			if (flags & FFrameState::ResolveFrustum)
+			{
+				/// 与 URTSCamera::resolveMinimapFrustumPoints 相同的弹簧臂求解公式，根坐标使用本帧的最终提交值
+				const float desiredArmLength = state.DesiredArmLengths[index];
+				const float frustumArmLength = desiredArmLength > 0.0f ? desiredArmLength : armLength;
+				const FQuat& armRotation = state.ArmRotations[index];
+				const FVector cameraLocation = rootLocation + state.ArmOriginOffsets[index]
+					- armRotation.GetForwardVector() * frustumArmLength
+					+ armRotation.RotateVector(socketOffset);
+
+				URTSCamera::projectFrustumGroundCorners(
+					cameraLocation,
+					armRotation * state.CameraRelativeRotations[index],
+					state.FieldOfViews[index],
+					state.AspectRatios[index],
+					&state.CornerAltitudes[index * 4],
+					&state.FrustumCorners[index * 4]
+				);
+			}
+		},
+		cameraCount < this->ParallelSolveThreshold ? EParallelForFlags::ForceSingleThread : EParallelForFlags::None
+	);
+}
+
+void URTSCameraManagerSubsystem::ApplyFrameState()
+{
+	SCOPE_CYCLE_COUNTER(STAT_RTSCameraManagerApply);
+
+	FFrameState& state = this->FrameState;
+	for (int32 index = 0; index < state.Num(); ++index)
+	{
+		URTSCamera* camera = state.Cameras[index];
+		if (!IsValid(camera) || camera->springArmComponent == nullptr)
+		{
+			continue;
+		}
+
+		const uint8 flags = state.Flags[index];
+		if (flags & FFrameState::InterpolateArmLength)
+		{
+			camera->springArmComponent->TargetArmLength = state.ArmLengths[index];
+		}
+		if (state.Solvers[index] != nullptr)
+		{
+			camera->applyBoundarySocketOffset(FVector2D(state.SocketOffsets[index]));
+		}
+
+		camera->finishStagedCommit(state.RootLocations[index], (flags & FFrameState::ResolveFrustum) ? &state.FrustumCorners[index * 4] : nullptr);
+		camera->finishCameraFrame();
+	}
+}
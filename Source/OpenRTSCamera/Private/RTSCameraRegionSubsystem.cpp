@@ -0,0 +1,409 @@
+// Copyright 2024 Jesus Bracho All Rights Reserved.
+
+#include "RTSCameraRegionSubsystem.h"
+
+#include "Components/BoxComponent.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "GameFramework/Actor.h"
+#include "MassBattleMinimapRegion.h"
+#include "RTSCameraBoundaryField.h"
+#include "RTSCameraBoundsVolume.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogRTSCameraRegions, Log, All);
+
+bool URTSCameraRegionSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void URTSCameraRegionSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	/// AMinimapRegion 属于外部插件，无法自行登记：世界开始时统一收编一次，之后的生成通过回调接入
+	for (TActorIterator<AMinimapRegion> iterator(&InWorld); iterator; ++iterator)
+	{
+		this->AdoptMinimapRegion(*iterator);
+	}
+	this->ActorSpawnedHandle = InWorld.AddOnActorSpawnedHandler(FOnActorSpawned::FDelegate::CreateUObject(this, &URTSCameraRegionSubsystem::HandleActorSpawned));
+}
+
+void URTSCameraRegionSubsystem::Deinitialize()
+{
+	if (UWorld* world = this->GetWorld())
+	{
+		world->RemoveOnActorSpawnedHandler(this->ActorSpawnedHandle);
+	}
+
+	for (const FRTSCameraRegion& region : this->Regions)
+	{
+		if (AActor* regionActor = region.RegionActor.Get())
+		{
+			regionActor->OnEndPlay.RemoveDynamic(this, &URTSCameraRegionSubsystem::HandleAdoptedRegionEndPlay);
+			if (USceneComponent* boundsComponent = GetRegionBoundsComponent(regionActor))
+			{
+				boundsComponent->TransformUpdated.RemoveAll(this);
+			}
+		}
+	}
+	this->Regions.Reset();
+	this->RegionIndexByActor.Reset();
+	this->IntervalNodes.Reset();
+	this->IntervalRoot = INDEX_NONE;
+
+	Super::Deinitialize();
+}
+
+void URTSCameraRegionSubsystem::RegisterRegion(AActor* RegionActor, const int32 Priority, const bool bEnabled)
+{
+	if (RegionActor == nullptr)
+	{
+		return;
+	}
+
+	if (const int32* existingIndex = this->RegionIndexByActor.Find(RegionActor))
+	{
+		FRTSCameraRegion& region = this->Regions[*existingIndex];
+		region.Priority = Priority;
+		region.bEnabled = bEnabled;
+		this->OnRegionsChanged.Broadcast();
+		return;
+	}
+
+	FRTSCameraRegion region;
+	if (!CalculateRegionBounds(RegionActor, region))
+	{
+		UE_LOG(LogRTSCameraRegions, Warning, TEXT("区域 [%s] 没有有效的包围盒，忽略登记"), *RegionActor->GetName());
+		return;
+	}
+	region.RegionActor = RegionActor;
+	region.TieBreakKey = RegionActor->GetPathName();
+	region.Priority = Priority;
+	region.bEnabled = bEnabled;
+
+	this->RegionIndexByActor.Add(RegionActor, this->Regions.Add(region));
+	if (USceneComponent* boundsComponent = GetRegionBoundsComponent(RegionActor))
+	{
+		boundsComponent->TransformUpdated.AddUObject(this, &URTSCameraRegionSubsystem::HandleRegionTransformUpdated);
+	}
+
+	this->bIntervalTreeDirty = true;
+	this->OnRegionsChanged.Broadcast();
+}
+
+void URTSCameraRegionSubsystem::UnregisterRegion(AActor* RegionActor)
+{
+	int32 regionIndex = INDEX_NONE;
+	if (!this->RegionIndexByActor.RemoveAndCopyValue(RegionActor, regionIndex))
+	{
+		return;
+	}
+
+	if (USceneComponent* boundsComponent = GetRegionBoundsComponent(RegionActor))
+	{
+		boundsComponent->TransformUpdated.RemoveAll(this);
+	}
+
+	/// 交换删除后修正被移动元素的下标
+	this->Regions.RemoveAtSwap(regionIndex, 1, EAllowShrinking::No);
+	if (this->Regions.IsValidIndex(regionIndex))
+	{
+		this->RegionIndexByActor.Add(this->Regions[regionIndex].RegionActor, regionIndex);
+	}
+
+	this->bIntervalTreeDirty = true;
+	this->OnRegionsChanged.Broadcast();
+}
+
+void URTSCameraRegionSubsystem::SetRegionEnabled(AActor* RegionActor, const bool bEnabled)
+{
+	const int32* regionIndex = this->RegionIndexByActor.Find(RegionActor);
+	if (regionIndex == nullptr || this->Regions[*regionIndex].bEnabled == bEnabled)
+	{
+		return;
+	}
+
+	/// 启用状态在查询时过滤，不需要重建区间树
+	this->Regions[*regionIndex].bEnabled = bEnabled;
+	this->OnRegionsChanged.Broadcast();
+}
+
+AActor* URTSCameraRegionSubsystem::FindRegionActorAt(const FVector2D Location) const
+{
+	const FRTSCameraRegion* region = this->FindRegionAt(Location);
+	return region != nullptr ? region->RegionActor.Get() : nullptr;
+}
+
+const FRTSCameraRegion* URTSCameraRegionSubsystem::FindRegionAt(const FVector2D& Location, const bool bFallbackToNearest) const
+{
+	this->RebuildIntervalTreeIfDirty();
+
+	const FRTSCameraRegion* bestRegion = nullptr;
+	auto considerCandidate = [&](const int32 regionIndex)
+	{
+		const FRTSCameraRegion& region = this->Regions[regionIndex];
+		if (!region.bEnabled || FMath::Abs(Location.Y - region.Origin.Y) > region.Extents.Y)
+		{
+			return;
+		}
+
+		/// 多边形区域的包围盒只是候选条件，再用距离场确认坐标位于边界内部
+		if (region.BoundaryField.IsValid())
+		{
+			float signedDistance = 0.0f;
+			FVector2D outwardNormal;
+			region.BoundaryField->sample(Location, signedDistance, outwardNormal);
+			if (signedDistance > 0.0f)
+			{
+				return;
+			}
+		}
+		if (bestRegion == nullptr || region.IsPreferredOver(*bestRegion))
+		{
+			bestRegion = &region;
+		}
+	};
+
+	/// 沿树下行：每个节点只扫描确实覆盖查询点 X 的前缀
+	int32 nodeIndex = this->IntervalRoot;
+	while (nodeIndex != INDEX_NONE)
+	{
+		const FIntervalNode& node = this->IntervalNodes[nodeIndex];
+		if (Location.X < node.Center)
+		{
+			for (const int32 regionIndex : node.RegionsByMinX)
+			{
+				const FRTSCameraRegion& region = this->Regions[regionIndex];
+				if (region.Origin.X - region.Extents.X > Location.X)
+				{
+					break;
+				}
+				considerCandidate(regionIndex);
+			}
+			nodeIndex = node.LeftChild;
+		}
+		else
+		{
+			for (const int32 regionIndex : node.RegionsByMaxX)
+			{
+				const FRTSCameraRegion& region = this->Regions[regionIndex];
+				if (region.Origin.X + region.Extents.X < Location.X)
+				{
+					break;
+				}
+				considerCandidate(regionIndex);
+			}
+			nodeIndex = node.RightChild;
+		}
+	}
+
+	if (bestRegion != nullptr || !bFallbackToNearest)
+	{
+		return bestRegion;
+	}
+
+	/// 不在任何区域内时退化为线性查找最近的已启用区域（仅发生在跳转越界等少见情况）
+	float bestDistanceSquared = TNumericLimits<float>::Max();
+	for (const FRTSCameraRegion& region : this->Regions)
+	{
+		if (!region.bEnabled)
+		{
+			continue;
+		}
+		float distanceSquared = region.GetPlanarBounds().ComputeSquaredDistanceToPoint(Location);
+		if (region.BoundaryField.IsValid())
+		{
+			float signedDistance = 0.0f;
+			FVector2D outwardNormal;
+			region.BoundaryField->sample(Location, signedDistance, outwardNormal);
+			distanceSquared = FMath::Square(FMath::Max(signedDistance, 0.0f));
+		}
+		if (distanceSquared < bestDistanceSquared || (distanceSquared == bestDistanceSquared && bestRegion != nullptr && region.IsPreferredOver(*bestRegion)))
+		{
+			bestDistanceSquared = distanceSquared;
+			bestRegion = &region;
+		}
+	}
+	return bestRegion;
+}
+
+const FRTSCameraRegion* URTSCameraRegionSubsystem::FindRegion(const AActor* RegionActor) const
+{
+	const int32* regionIndex = this->RegionIndexByActor.Find(RegionActor);
+	return regionIndex != nullptr ? &this->Regions[*regionIndex] : nullptr;
+}
+
+void URTSCameraRegionSubsystem::RebuildIntervalTreeIfDirty() const
+{
+	if (!this->bIntervalTreeDirty)
+	{
+		return;
+	}
+
+	this->IntervalNodes.Reset();
+	TArray<int32> regionIndices;
+	regionIndices.Reserve(this->Regions.Num());
+	for (int32 regionIndex = 0; regionIndex < this->Regions.Num(); ++regionIndex)
+	{
+		regionIndices.Add(regionIndex);
+	}
+	this->IntervalRoot = this->BuildIntervalNode(regionIndices);
+	this->bIntervalTreeDirty = false;
+}
+
+int32 URTSCameraRegionSubsystem::BuildIntervalNode(TArray<int32>& RegionIndices) const
+{
+	if (RegionIndices.Num() == 0)
+	{
+		return INDEX_NONE;
+	}
+
+	/// 以全部端点的中位数为中心，保证左右子树规模至多为一半
+	TArray<float> endpoints;
+	endpoints.Reserve(RegionIndices.Num() * 2);
+	for (const int32 regionIndex : RegionIndices)
+	{
+		const FRTSCameraRegion& region = this->Regions[regionIndex];
+		endpoints.Add(region.Origin.X - region.Extents.X);
+		endpoints.Add(region.Origin.X + region.Extents.X);
+	}
+	endpoints.Sort();
+	const float center = endpoints[endpoints.Num() / 2];
+
+	TArray<int32> leftIndices;
+	TArray<int32> rightIndices;
+	TArray<int32> spanningIndices;
+	for (const int32 regionIndex : RegionIndices)
+	{
+		const FRTSCameraRegion& region = this->Regions[regionIndex];
+		if (region.Origin.X + region.Extents.X < center)
+		{
+			leftIndices.Add(regionIndex);
+		}
+		else if (region.Origin.X - region.Extents.X > center)
+		{
+			rightIndices.Add(regionIndex);
+		}
+		else
+		{
+			spanningIndices.Add(regionIndex);
+		}
+	}
+
+	const int32 nodeIndex = this->IntervalNodes.AddDefaulted();
+	{
+		FIntervalNode& node = this->IntervalNodes[nodeIndex];
+		node.Center = center;
+		node.RegionsByMinX = spanningIndices;
+		node.RegionsByMinX.Sort([this](const int32 a, const int32 b)
+		{
+			return this->Regions[a].Origin.X - this->Regions[a].Extents.X < this->Regions[b].Origin.X - this->Regions[b].Extents.X;
+		});
+		node.RegionsByMaxX = MoveTemp(spanningIndices);
+		node.RegionsByMaxX.Sort([this](const int32 a, const int32 b)
+		{
+			return this->Regions[a].Origin.X + this->Regions[a].Extents.X > this->Regions[b].Origin.X + this->Regions[b].Extents.X;
+		});
+	}
+
+	/// 子节点构建会扩容节点池，回写时重新取引用
+	const int32 leftChild = this->BuildIntervalNode(leftIndices);
+	const int32 rightChild = this->BuildIntervalNode(rightIndices);
+	this->IntervalNodes[nodeIndex].LeftChild = leftChild;
+	this->IntervalNodes[nodeIndex].RightChild = rightChild;
+	return nodeIndex;
+}
+
+bool URTSCameraRegionSubsystem::CalculateRegionBounds(AActor* RegionActor, FRTSCameraRegion& OutRegion)
+{
+	OutRegion.OverflowDistance = 0.0f;
+	OutRegion.BoundaryField.Reset();
+	if (const AMinimapRegion* minimapRegion = Cast<AMinimapRegion>(RegionActor))
+	{
+		if (minimapRegion->BoundsComponent == nullptr)
+		{
+			return false;
+		}
+		OutRegion.Origin = minimapRegion->BoundsComponent->GetComponentLocation();
+		OutRegion.Extents = minimapRegion->BoundsComponent->GetScaledBoxExtent();
+		OutRegion.OverflowDistance = minimapRegion->MapOverflowUU;
+		return !OutRegion.Extents.IsNearlyZero();
+	}
+
+	RegionActor->GetActorBounds(false, OutRegion.Origin, OutRegion.Extents);
+
+	/// 非矩形体积：水平范围取多边形的包围盒，竖直范围沿用体积自身
+	if (const ARTSCameraBoundsVolume* boundsVolume = Cast<ARTSCameraBoundsVolume>(RegionActor))
+	{
+		OutRegion.BoundaryField = boundsVolume->GetBoundaryField();
+		if (OutRegion.BoundaryField.IsValid())
+		{
+			const FBox2D& polygonBounds = OutRegion.BoundaryField->getPolygonBounds();
+			OutRegion.Origin = FVector(polygonBounds.GetCenter(), OutRegion.Origin.Z);
+			OutRegion.Extents = FVector(polygonBounds.GetExtent(), OutRegion.Extents.Z);
+		}
+	}
+	return !OutRegion.Extents.IsNearlyZero();
+}
+
+USceneComponent* URTSCameraRegionSubsystem::GetRegionBoundsComponent(const AActor* RegionActor)
+{
+	if (const AMinimapRegion* minimapRegion = Cast<AMinimapRegion>(RegionActor))
+	{
+		return minimapRegion->BoundsComponent;
+	}
+	return RegionActor != nullptr ? RegionActor->GetRootComponent() : nullptr;
+}
+
+void URTSCameraRegionSubsystem::HandleRegionTransformUpdated(USceneComponent* UpdatedComponent, EUpdateTransformFlags, ETeleportType)
+{
+	AActor* regionActor = UpdatedComponent != nullptr ? UpdatedComponent->GetOwner() : nullptr;
+	const int32* regionIndex = this->RegionIndexByActor.Find(regionActor);
+	if (regionIndex == nullptr)
+	{
+		return;
+	}
+
+	/// 多边形体积的距离场以世界坐标烘焙，移动后需要重新烘焙
+	if (ARTSCameraBoundsVolume* boundsVolume = Cast<ARTSCameraBoundsVolume>(regionActor))
+	{
+		boundsVolume->RebuildBoundaryField();
+	}
+
+	FRTSCameraRegion& region = this->Regions[*regionIndex];
+	CalculateRegionBounds(regionActor, region);
+	this->bIntervalTreeDirty = true;
+	this->OnRegionsChanged.Broadcast();
+}
+
+void URTSCameraRegionSubsystem::HandleAdoptedRegionEndPlay(AActor* Actor, EEndPlayReason::Type)
+{
+	if (Actor != nullptr)
+	{
+		Actor->OnEndPlay.RemoveDynamic(this, &URTSCameraRegionSubsystem::HandleAdoptedRegionEndPlay);
+	}
+	this->UnregisterRegion(Actor);
+}
+
+void URTSCameraRegionSubsystem::HandleActorSpawned(AActor* SpawnedActor)
+{
+	if (SpawnedActor != nullptr && SpawnedActor->IsA<AMinimapRegion>())
+	{
+		this->AdoptMinimapRegion(SpawnedActor);
+	}
+}
+
+void URTSCameraRegionSubsystem::AdoptMinimapRegion(AActor* RegionActor)
+{
+	if (RegionActor == nullptr || this->RegionIndexByActor.Contains(RegionActor))
+	{
+		return;
+	}
+
+	this->RegisterRegion(RegionActor, 0, true);
+	if (this->RegionIndexByActor.Contains(RegionActor))
+	{
+		RegionActor->OnEndPlay.AddDynamic(this, &URTSCameraRegionSubsystem::HandleAdoptedRegionEndPlay);
+	}
+}
@@ -0,0 +1,320 @@
+// Copyright 2024 Jesus Bracho All Rights Reserved.
+
+#include "RTSCameraReplayBuffer.h"
+
+namespace
+{
+	/// 长度量化步长（UU）
+	constexpr float positionQuantizationStep = 0.5f;
+	constexpr float inversePositionQuantizationStep = 1.0f / positionQuantizationStep;
+
+	/// 增量记录首字节中表示字段发生变化的标志位
+	enum EReplayDeltaFlags : uint8
+	{
+		ReplayDeltaRootX = 1 << 0,
+		ReplayDeltaRootY = 1 << 1,
+		ReplayDeltaRootZ = 1 << 2,
+		ReplayDeltaYaw = 1 << 3,
+		ReplayDeltaArmLength = 1 << 4,
+		ReplayDeltaSocketOffset = 1 << 5,
+		ReplayDeltaFollowTarget = 1 << 6
+	};
+
+	FORCEINLINE uint64 encodeZigZag(const int64 value)
+	{
+		return (static_cast<uint64>(value) << 1) ^ static_cast<uint64>(value >> 63);
+	}
+
+	FORCEINLINE int64 decodeZigZag(const uint64 value)
+	{
+		return static_cast<int64>(value >> 1) ^ -static_cast<int64>(value & 1);
+	}
+
+	FORCEINLINE uint8* writeVarInt(uint8* cursor, uint64 value)
+	{
+		while (value >= 0x80)
+		{
+			*cursor++ = static_cast<uint8>(value) | 0x80;
+			value >>= 7;
+		}
+		*cursor++ = static_cast<uint8>(value);
+		return cursor;
+	}
+
+	FORCEINLINE const uint8* readVarInt(const uint8* cursor, uint64& outValue)
+	{
+		outValue = 0;
+		for (int32 shift = 0; ; shift += 7)
+		{
+			const uint8 byte = *cursor++;
+			outValue |= static_cast<uint64>(byte & 0x7F) << shift;
+			if ((byte & 0x80) == 0)
+			{
+				return cursor;
+			}
+		}
+	}
+
+	FORCEINLINE int32 quantizeLength(const double value)
+	{
+		return static_cast<int32>(FMath::RoundToDouble(value * inversePositionQuantizationStep));
+	}
+}
+
+void FRTSCameraReplayBuffer::initialize(const int32 capacityBytes, const int32 inBlockBytes)
+{
+	this->blockBytes = FMath::Max(inBlockBytes, maxDeltaRecordBytes * 4);
+	const int32 blockCount = FMath::Max(capacityBytes / this->blockBytes, 2);
+
+	this->storage.SetNumZeroed(blockCount * this->blockBytes);
+	this->blocks.SetNum(blockCount);
+	this->reset();
+}
+
+void FRTSCameraReplayBuffer::reset()
+{
+	this->oldestBlock = 0;
+	this->activeBlockCount = 0;
+	this->lastSample = FQuantizedSample();
+}
+
+FRTSCameraReplayBuffer::FQuantizedSample FRTSCameraReplayBuffer::quantize(const FRTSCameraReplaySample& sample)
+{
+	FQuantizedSample quantized;
+	quantized.timeMilliseconds = static_cast<int64>(FMath::RoundToDouble(sample.timeSeconds * 1000.0));
+	for (int32 axis = 0; axis < 3; ++axis)
+	{
+		quantized.rootLocation[axis] = quantizeLength(sample.rootLocation[axis]);
+		quantized.socketOffset[axis] = quantizeLength(sample.socketOffset[axis]);
+	}
+	quantized.yaw = static_cast<uint16>(FMath::RoundToInt(FRotator::ClampAxis(sample.yaw) * (65536.0f / 360.0f)) & 0xFFFF);
+	quantized.armLength = quantizeLength(sample.armLength);
+	quantized.followTargetId = sample.followTargetId;
+	return quantized;
+}
+
+FRTSCameraReplaySample FRTSCameraReplayBuffer::dequantize(const FQuantizedSample& sample)
+{
+	FRTSCameraReplaySample decoded;
+	decoded.timeSeconds = sample.timeMilliseconds / 1000.0;
+	for (int32 axis = 0; axis < 3; ++axis)
+	{
+		decoded.rootLocation[axis] = sample.rootLocation[axis] * positionQuantizationStep;
+		decoded.socketOffset[axis] = sample.socketOffset[axis] * positionQuantizationStep;
+	}
+	decoded.yaw = FRotator::NormalizeAxis(sample.yaw * (360.0f / 65536.0f));
+	decoded.armLength = sample.armLength * positionQuantizationStep;
+	decoded.followTargetId = sample.followTargetId;
+	return decoded;
+}
+
+void FRTSCameraReplayBuffer::record(const FRTSCameraReplaySample& sample)
+{
+	if (!this->isInitialized())
+	{
+		return;
+	}
+
+	const FQuantizedSample quantized = quantize(sample);
+	if (this->activeBlockCount > 0 && quantized.timeMilliseconds < this->lastSample.timeMilliseconds)
+	{
+		this->reset();
+	}
+
+	const bool bNeedsNewBlock = this->activeBlockCount == 0
+		|| this->blocks[this->getBlockIndex(this->activeBlockCount - 1)].usedBytes + maxDeltaRecordBytes > this->blockBytes;
+	if (bNeedsNewBlock)
+	{
+		this->beginBlock(quantized);
+	}
+	else
+	{
+		this->writeDelta(quantized);
+	}
+	this->lastSample = quantized;
+}
+
+void FRTSCameraReplayBuffer::beginBlock(const FQuantizedSample& keyframe)
+{
+	/// 全部块都在使用时覆盖最旧的块
+	if (this->activeBlockCount == this->blocks.Num())
+	{
+		this->oldestBlock = (this->oldestBlock + 1) % this->blocks.Num();
+	}
+	else
+	{
+		++this->activeBlockCount;
+	}
+
+	FBlock& block = this->blocks[this->getBlockIndex(this->activeBlockCount - 1)];
+	block.keyframe = keyframe;
+	block.usedBytes = 0;
+}
+
+void FRTSCameraReplayBuffer::writeDelta(const FQuantizedSample& sample)
+{
+	FBlock& block = this->blocks[this->getBlockIndex(this->activeBlockCount - 1)];
+	uint8* const recordStart = this->storage.GetData() + this->getBlockIndex(this->activeBlockCount - 1) * this->blockBytes + block.usedBytes;
+	const FQuantizedSample& previous = this->lastSample;
+
+	uint8 flags = 0;
+	flags |= sample.rootLocation[0] != previous.rootLocation[0] ? ReplayDeltaRootX : 0;
+	flags |= sample.rootLocation[1] != previous.rootLocation[1] ? ReplayDeltaRootY : 0;
+	flags |= sample.rootLocation[2] != previous.rootLocation[2] ? ReplayDeltaRootZ : 0;
+	flags |= sample.yaw != previous.yaw ? ReplayDeltaYaw : 0;
+	flags |= sample.armLength != previous.armLength ? ReplayDeltaArmLength : 0;
+	flags |= (sample.socketOffset[0] != previous.socketOffset[0] || sample.socketOffset[1] != previous.socketOffset[1] || sample.socketOffset[2] != previous.socketOffset[2]) ? ReplayDeltaSocketOffset : 0;
+	flags |= sample.followTargetId != previous.followTargetId ? ReplayDeltaFollowTarget : 0;
+
+	uint8* cursor = recordStart;
+	*cursor++ = flags;
+	cursor = writeVarInt(cursor, static_cast<uint64>(sample.timeMilliseconds - previous.timeMilliseconds));
+	for (int32 axis = 0; axis < 3; ++axis)
+	{
+		if (flags & (ReplayDeltaRootX << axis))
+		{
+			cursor = writeVarInt(cursor, encodeZigZag(static_cast<int64>(sample.rootLocation[axis]) - previous.rootLocation[axis]));
+		}
+	}
+	if (flags & ReplayDeltaYaw)
+	{
+		/// 按 16 位回绕取最短方向的差值
+		cursor = writeVarInt(cursor, encodeZigZag(static_cast<int16>(static_cast<uint16>(sample.yaw - previous.yaw))));
+	}
+	if (flags & ReplayDeltaArmLength)
+	{
+		cursor = writeVarInt(cursor, encodeZigZag(static_cast<int64>(sample.armLength) - previous.armLength));
+	}
+	if (flags & ReplayDeltaSocketOffset)
+	{
+		for (int32 axis = 0; axis < 3; ++axis)
+		{
+			cursor = writeVarInt(cursor, encodeZigZag(static_cast<int64>(sample.socketOffset[axis]) - previous.socketOffset[axis]));
+		}
+	}
+	if (flags & ReplayDeltaFollowTarget)
+	{
+		cursor = writeVarInt(cursor, sample.followTargetId);
+	}
+
+	block.usedBytes += static_cast<int32>(cursor - recordStart);
+}
+
+double FRTSCameraReplayBuffer::getOldestTimeSeconds() const
+{
+	return this->isEmpty() ? 0.0 : this->blocks[this->oldestBlock].keyframe.timeMilliseconds / 1000.0;
+}
+
+double FRTSCameraReplayBuffer::getNewestTimeSeconds() const
+{
+	return this->isEmpty() ? 0.0 : this->lastSample.timeMilliseconds / 1000.0;
+}
+
+bool FRTSCameraReplayBuffer::sampleAt(const double timeSeconds, FRTSCameraReplaySample& outSample) const
+{
+	if (this->isEmpty())
+	{
+		return false;
+	}
+
+	const int64 queryMilliseconds = FMath::Clamp(
+		static_cast<int64>(FMath::RoundToDouble(timeSeconds * 1000.0)),
+		this->blocks[this->oldestBlock].keyframe.timeMilliseconds,
+		this->lastSample.timeMilliseconds
+	);
+
+	/// 二分查找关键帧时间不晚于查询时间的最后一个数据块
+	int32 low = 0;
+	int32 high = this->activeBlockCount - 1;
+	while (low < high)
+	{
+		const int32 middle = (low + high + 1) / 2;
+		if (this->blocks[this->getBlockIndex(middle)].keyframe.timeMilliseconds <= queryMilliseconds)
+		{
+			low = middle;
+		}
+		else
+		{
+			high = middle - 1;
+		}
+	}
+
+	/// 从关键帧顺序解码，直到越过查询时间
+	const int32 blockIndex = this->getBlockIndex(low);
+	const FBlock& block = this->blocks[blockIndex];
+	const uint8* cursor = this->storage.GetData() + blockIndex * this->blockBytes;
+	const uint8* const blockEnd = cursor + block.usedBytes;
+
+	FQuantizedSample previous = block.keyframe;
+	FQuantizedSample next;
+	bool bHasNext = false;
+	while (cursor < blockEnd)
+	{
+		next = previous;
+		const uint8 flags = *cursor++;
+		uint64 value = 0;
+		cursor = readVarInt(cursor, value);
+		next.timeMilliseconds += static_cast<int64>(value);
+		for (int32 axis = 0; axis < 3; ++axis)
+		{
+			if (flags & (ReplayDeltaRootX << axis))
+			{
+				cursor = readVarInt(cursor, value);
+				next.rootLocation[axis] += static_cast<int32>(decodeZigZag(value));
+			}
+		}
+		if (flags & ReplayDeltaYaw)
+		{
+			cursor = readVarInt(cursor, value);
+			next.yaw = static_cast<uint16>(next.yaw + decodeZigZag(value));
+		}
+		if (flags & ReplayDeltaArmLength)
+		{
+			cursor = readVarInt(cursor, value);
+			next.armLength += static_cast<int32>(decodeZigZag(value));
+		}
+		if (flags & ReplayDeltaSocketOffset)
+		{
+			for (int32 axis = 0; axis < 3; ++axis)
+			{
+				cursor = readVarInt(cursor, value);
+				next.socketOffset[axis] += static_cast<int32>(decodeZigZag(value));
+			}
+		}
+		if (flags & ReplayDeltaFollowTarget)
+		{
+			cursor = readVarInt(cursor, value);
+			next.followTargetId = static_cast<uint32>(value);
+		}
+
+		if (next.timeMilliseconds > queryMilliseconds)
+		{
+			bHasNext = true;
+			break;
+		}
+		previous = next;
+	}
+
+	/// 块内没有更晚的采样时，下一个采样是下一块的关键帧
+	if (!bHasNext && low + 1 < this->activeBlockCount)
+	{
+		next = this->blocks[this->getBlockIndex(low + 1)].keyframe;
+		bHasNext = true;
+	}
+
+	outSample = dequantize(previous);
+	if (!bHasNext || next.timeMilliseconds - previous.timeMilliseconds > maxInterpolationGapMilliseconds)
+	{
+		outSample.timeSeconds = queryMilliseconds / 1000.0;
+		return true;
+	}
+
+	const FRTSCameraReplaySample nextSample = dequantize(next);
+	const float alpha = static_cast<float>(queryMilliseconds - previous.timeMilliseconds) / static_cast<float>(FMath::Max<int64>(next.timeMilliseconds - previous.timeMilliseconds, 1));
+	outSample.timeSeconds = queryMilliseconds / 1000.0;
+	outSample.rootLocation = FMath::Lerp(outSample.rootLocation, nextSample.rootLocation, alpha);
+	outSample.yaw = FRotator::NormalizeAxis(outSample.yaw + FRotator::NormalizeAxis(nextSample.yaw - outSample.yaw) * alpha);
+	outSample.armLength = FMath::Lerp(outSample.armLength, nextSample.armLength, alpha);
+	outSample.socketOffset = FMath::Lerp(outSample.socketOffset, nextSample.socketOffset, alpha);
+	return true;
+}
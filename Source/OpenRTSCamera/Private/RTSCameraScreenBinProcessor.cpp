@@ -0,0 +1,247 @@
+// Copyright 2024 Jesus Bracho All Rights Reserved.
+
+#include "RTSCameraScreenBinProcessor.h"
+
+#include "Async/ParallelFor.h"
+#include "Engine/World.h"
+#include "MassCommonFragments.h"
+#include "MassCommonTypes.h"
+#include "MassExecutionContext.h"
+#include "OpenRTSCamera.h"
+#include "RTSCameraFrustumQuery.h"
+#include "RTSCameraManagerSubsystem.h"
+#include "RTSCameraScreenBins.h"
+#include "RTSCameraSnapshot.h"
+#include "Fragments/SubType.h"
+
+DECLARE_CYCLE_STAT(TEXT("Camera Screen Bins"), STAT_RTSCameraScreenBins, STATGROUP_OpenRTSCamera);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Screen Binned Entities"), STAT_RTSCameraScreenBinnedEntities, STATGROUP_OpenRTSCamera);
+
+URTSCameraScreenBinProcessor::URTSCameraScreenBinProcessor()
+	: DefaultAgentRadius(50.0f)
+	, EntitiesPerBlock(4096)
+	, EntityQuery(*this)
+	, UntaggedAgentQuery(*this)
+	, bHasWarnedUntaggedAgents(false)
+{
+	bAutoRegisterWithProcessingPhases = true;
+	bRequiresGameThreadExecution = false;
+	ExecutionFlags = (int32)(EProcessorExecutionFlags::Client | EProcessorExecutionFlags::Standalone);
+	ExecutionOrder.ExecuteInGroup = UE::Mass::ProcessorGroupNames::LOD;
+}
+
+void URTSCameraScreenBinProcessor::Initialize(UObject& Owner)
+{
+	Super::Initialize(Owner);
+
+	const UWorld* world = Owner.GetWorld();
+	const URTSCameraManagerSubsystem* manager = world != nullptr ? world->GetSubsystem<URTSCameraManagerSubsystem>() : nullptr;
+	if (manager != nullptr)
+	{
+		this->SnapshotChannel = manager->GetPrimarySnapshotChannel();
+		this->ScreenBins = manager->GetPrimaryScreenBins();
+	}
+}
+
+void URTSCameraScreenBinProcessor::ConfigureQueries()
+{
+	EntityQuery.AddRequirement<FTransformFragment>(EMassFragmentAccess::ReadOnly);
+	EntityQuery.AddRequirement<FAgentRadiusFragment>(EMassFragmentAccess::ReadOnly, EMassFragmentPresence::Optional);
+	EntityQuery.AddRequirement<FSubType>(EMassFragmentAccess::ReadOnly, EMassFragmentPresence::Optional);
+	EntityQuery.AddTagRequirement<FRTSCameraScreenBinTag>(EMassFragmentPresence::All);
+
+	UntaggedAgentQuery.AddRequirement<FAgentRadiusFragment>(EMassFragmentAccess::ReadOnly);
+	UntaggedAgentQuery.AddTagRequirement<FRTSCameraScreenBinTag>(EMassFragmentPresence::None);
+}
+
+void URTSCameraScreenBinProcessor::Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context)
+{
+	FRTSCameraSnapshot snapshot;
+	if (!this->ScreenBins.IsValid() || !this->SnapshotChannel.IsValid() || !this->SnapshotChannel->read(snapshot))
+	{
+		return;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_RTSCameraScreenBins);
+
+	/// 分箱看不到未加标记的代理，此时不发布，已发布的结果随之过期，HUD 回退到完整的射线检测
+	const int32 untaggedAgentCount = UntaggedAgentQuery.GetNumMatchingEntities(EntityManager);
+	if (untaggedAgentCount > 0)
+	{
+		if (!this->bHasWarnedUntaggedAgents)
+		{
+			this->bHasWarnedUntaggedAgents = true;
+			UE_LOG(LogOpenRTSCamera, Warning, TEXT("%d 个代理没有 RTS Camera Screen Bins 特征，屏幕分箱已停用，框选回退到 ViewTraceForAgents"), untaggedAgentCount);
+		}
+		return;
+	}
+
+	/// 1. 收集：逐块复制句柄、位置、半径与类型桶，之后的投影与散列不再访问实体管理器
+	this->GatheredEntities.Reset();
+	this->GatheredLocations.Reset();
+	this->GatheredRadii.Reset();
+	this->GatheredBuckets.Reset();
+	this->TypeKeys.Reset();
+	this->BucketByTypeKey.Reset();
+	const float defaultRadius = this->DefaultAgentRadius;
+	EntityQuery.ForEachEntityChunk(EntityManager, Context, [this, defaultRadius](FMassExecutionContext& ChunkContext)
+	{
+		const int32 numEntities = ChunkContext.GetNumEntities();
+		const TConstArrayView<FTransformFragment> transforms = ChunkContext.GetFragmentView<FTransformFragment>();
+		const TConstArrayView<FAgentRadiusFragment> radii = ChunkContext.GetFragmentView<FAgentRadiusFragment>();
+		const TConstArrayView<FSubType> subTypes = ChunkContext.GetFragmentView<FSubType>();
+
+		/// 同一块内的实体通常同类，缓存上一个类型键以省去大部分映射查找
+		int32 lastTypeKey = INDEX_NONE;
+		int32 lastBucket = INDEX_NONE;
+
+		this->GatheredEntities.Append(ChunkContext.GetEntities().GetData(), numEntities);
+		for (int32 index = 0; index < numEntities; ++index)
+		{
+			this->GatheredLocations.Add(transforms[index].GetTransform().GetLocation());
+			this->GatheredRadii.Add(radii.IsEmpty() ? defaultRadius : radii[index].Radius);
+
+			const int32 typeKey = subTypes.IsEmpty() ? INDEX_NONE : subTypes[index].Index;
+			if (lastBucket == INDEX_NONE || typeKey != lastTypeKey)
+			{
+				lastTypeKey = typeKey;
+				if (const int32* bucket = this->BucketByTypeKey.Find(typeKey))
+				{
+					lastBucket = *bucket;
+				}
+				else
+				{
+					lastBucket = this->TypeKeys.Add(typeKey);
+					this->BucketByTypeKey.Add(typeKey, lastBucket);
+				}
+			}
+			this->GatheredBuckets.Add(lastBucket);
+		}
+	});
+
+	const int32 entityCount = this->GatheredEntities.Num();
+	const int32 blockSize = FMath::Max(this->EntitiesPerBlock, 256);
+	const int32 blockCount = FMath::DivideAndRoundUp(entityCount, blockSize);
+	constexpr int32 tileCount = FRTSCameraScreenBins::tileCount;
+
+	/// 排序键 = 类型桶 × tileCount + 瓦片
+	const int32 keyCount = this->TypeKeys.Num() * tileCount;
+
+	this->EntityTileRects.SetNumUninitialized(entityCount);
+	this->BlockTileCounts.SetNumZeroed(blockCount * keyCount);
+
+	/// 与 FRTSCameraFrustumQuery 相同的约定：FieldOfView 为水平视角
+	const FVector eye = snapshot.Location;
+	const FVector3f forwardVector(snapshot.Rotation.GetForwardVector());
+	const FVector3f rightVector(snapshot.Rotation.GetRightVector());
+	const FVector3f upVector(snapshot.Rotation.GetUpVector());
+	const float inverseTangent = 1.0f / FMath::Max(FMath::Tan(FMath::DegreesToRadians(snapshot.FieldOfView) / 2.0f), KINDA_SMALL_NUMBER);
+
+	/// 瓦片范围按 (最小列, 最小行, 最大列, 最大行) 各占 8 位打包；瓦片编号不超过 255，全 1 不会是合法范围
+	constexpr uint32 notBinned = MAX_uint32;
+	static_assert(FRTSCameraScreenBins::tileCountX <= 256 && FRTSCameraScreenBins::tileCountY <= 256, "Tile coordinates are packed into 8 bits");
+
+	/// 2. 投影并统计：投影圆覆盖的每个瓦片计数一次，瓦片坐标钳制到网格内，单个实体最多写入 tileCount 次；
+	///    每块只写自身的计数，块内顺序即最终顺序
+	ParallelFor(
+		blockCount,
+		[&](const int32 block)
+		{
+			const int32 first = block * blockSize;
+			const int32 last = FMath::Min(first + blockSize, entityCount);
+			int32* counts = this->BlockTileCounts.GetData() + block * keyCount;
+			for (int32 index = first; index < last; ++index)
+			{
+				const FVector3f relative(this->GatheredLocations[index] - eye);
+				const float depth = FVector3f::DotProduct(relative, forwardVector);
+				uint32 tileRect = notBinned;
+				if (depth > FRTSCameraFrustumQuery::defaultNearClipDistance)
+				{
+					const float scale = inverseTangent / depth;
+					const float screenX = FVector3f::DotProduct(relative, rightVector) * scale;
+					const float screenY = FVector3f::DotProduct(relative, upVector) * scale;
+					const float screenRadius = this->GatheredRadii[index] * scale;
+					if (FMath::Abs(screenX) <= 1.0f + screenRadius && FMath::Abs(screenY) <= 1.0f + screenRadius)
+					{
+						const int32 minTileX = FRTSCameraScreenBins::getTileX(screenX - screenRadius);
+						const int32 maxTileX = FRTSCameraScreenBins::getTileX(screenX + screenRadius);
+						const int32 minTileY = FRTSCameraScreenBins::getTileY(screenY - screenRadius);
+						const int32 maxTileY = FRTSCameraScreenBins::getTileY(screenY + screenRadius);
+						tileRect = uint32(minTileX) | (uint32(minTileY) << 8) | (uint32(maxTileX) << 16) | (uint32(maxTileY) << 24);
+
+						int32* bucketCounts = counts + this->GatheredBuckets[index] * tileCount;
+						for (int32 tileY = minTileY; tileY <= maxTileY; ++tileY)
+						{
+							for (int32 tileX = minTileX; tileX <= maxTileX; ++tileX)
+							{
+								++bucketCounts[tileY * FRTSCameraScreenBins::tileCountX + tileX];
+							}
+						}
+					}
+				}
+				this->EntityTileRects[index] = tileRect;
+			}
+		},
+		blockCount < 2 ? EParallelForFlags::ForceSingleThread : EParallelForFlags::None
+	);
+
+	/// 3. 前缀和：按排序键、再按块排列，计数数组原地改写为各块在各键中的写入起点
+	this->TileStarts.SetNumUninitialized(keyCount + 1);
+	int32 offset = 0;
+	for (int32 key = 0; key < keyCount; ++key)
+	{
+		this->TileStarts[key] = offset;
+		for (int32 block = 0; block < blockCount; ++block)
+		{
+			int32& count = this->BlockTileCounts[block * keyCount + key];
+			const int32 blockKeyCount = count;
+			count = offset;
+			offset += blockKeyCount;
+		}
+	}
+	this->TileStarts[keyCount] = offset;
+
+	/// 4. 散列：各块写入互不重叠的区间，同时记下实体覆盖范围的首瓦片供查询去重
+	this->BinnedEntities.SetNumUninitialized(offset);
+	this->BinnedFirstTiles.SetNumUninitialized(offset);
+	ParallelFor(
+		blockCount,
+		[&](const int32 block)
+		{
+			const int32 first = block * blockSize;
+			const int32 last = FMath::Min(first + blockSize, entityCount);
+			int32* cursors = this->BlockTileCounts.GetData() + block * keyCount;
+			for (int32 index = first; index < last; ++index)
+			{
+				const uint32 tileRect = this->EntityTileRects[index];
+				if (tileRect == notBinned)
+				{
+					continue;
+				}
+
+				const int32 minTileX = tileRect & 0xFF;
+				const int32 minTileY = (tileRect >> 8) & 0xFF;
+				const int32 maxTileX = (tileRect >> 16) & 0xFF;
+				const int32 maxTileY = tileRect >> 24;
+				const uint16 firstTile = FRTSCameraScreenBins::packTile(minTileX, minTileY);
+				int32* bucketCursors = cursors + this->GatheredBuckets[index] * tileCount;
+				for (int32 tileY = minTileY; tileY <= maxTileY; ++tileY)
+				{
+					for (int32 tileX = minTileX; tileX <= maxTileX; ++tileX)
+					{
+						const int32 slot = bucketCursors[tileY * FRTSCameraScreenBins::tileCountX + tileX]++;
+						this->BinnedEntities[slot] = this->GatheredEntities[index];
+						this->BinnedFirstTiles[slot] = firstTile;
+					}
+				}
+			}
+		},
+		blockCount < 2 ? EParallelForFlags::ForceSingleThread : EParallelForFlags::None
+	);
+
+	SET_DWORD_STAT(STAT_RTSCameraScreenBinnedEntities, offset);
+
+	/// 交换回来的是上一帧的缓冲，容量足够时下一帧无需重新分配。
+	/// 以本帧而非快照的帧号标记：相机休眠时快照停在旧帧，但其中的视角仍然有效
+	this->ScreenBins->publish(this->TypeKeys, this->TileStarts, this->BinnedEntities, this->BinnedFirstTiles, GFrameCounter);
+}
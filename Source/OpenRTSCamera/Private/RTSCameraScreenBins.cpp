@@ -0,0 +1,84 @@
+// Copyright 2024 Jesus Bracho All Rights Reserved.
+
+#include "RTSCameraScreenBins.h"
+
+#include "MassCommonFragments.h"
+#include "MassEntityTemplateRegistry.h"
+
+void FRTSCameraScreenBins::publish(TArray<int32>& inOutTypeKeys, TArray<int32>& inOutTileStarts, TArray<FMassEntityHandle>& inOutEntities, TArray<uint16>& inOutFirstTiles, const uint64 inPublishFrame)
+{
+	check(inOutTileStarts.Num() == inOutTypeKeys.Num() * tileCount + 1);
+	check(inOutFirstTiles.Num() == inOutEntities.Num());
+	{
+		FScopeLock scopeLock(&this->lock);
+		Swap(this->typeKeys, inOutTypeKeys);
+		Swap(this->tileStarts, inOutTileStarts);
+		Swap(this->entities, inOutEntities);
+		Swap(this->firstTiles, inOutFirstTiles);
+	}
+	this->publishFrame.store(inPublishFrame, std::memory_order_release);
+}
+
+bool FRTSCameraScreenBins::gatherEntities(const FVector2f& screenMin, const FVector2f& screenMax, TArray<FMassEntityHandle>& outEntities) const
+{
+	FScopeLock scopeLock(&this->lock);
+	if (this->tileStarts.IsEmpty())
+	{
+		return false;
+	}
+
+	for (int32 bucket = 0; bucket < this->typeKeys.Num(); ++bucket)
+	{
+		this->gatherBucket(bucket, screenMin, screenMax, outEntities);
+	}
+	return true;
+}
+
+bool FRTSCameraScreenBins::gatherEntitiesOfType(const int32 typeKey, const FVector2f& screenMin, const FVector2f& screenMax, TArray<FMassEntityHandle>& outEntities) const
+{
+	FScopeLock scopeLock(&this->lock);
+	if (this->tileStarts.IsEmpty())
+	{
+		return false;
+	}
+
+	/// 类型桶只有几个到几十个，线性查找即可
+	const int32 bucket = this->typeKeys.Find(typeKey);
+	if (bucket != INDEX_NONE)
+	{
+		this->gatherBucket(bucket, screenMin, screenMax, outEntities);
+	}
+	return true;
+}
+
+void FRTSCameraScreenBins::gatherBucket(const int32 bucket, const FVector2f& screenMin, const FVector2f& screenMax, TArray<FMassEntityHandle>& outEntities) const
+{
+	/// 实体已写入其覆盖的每个瓦片，矩形无需扩展
+	const int32 minTileX = getTileX(screenMin.X);
+	const int32 maxTileX = getTileX(screenMax.X);
+	const int32 minTileY = getTileY(screenMin.Y);
+	const int32 maxTileY = getTileY(screenMax.Y);
+	const int32 bucketStart = bucket * tileCount;
+	for (int32 tileY = minTileY; tileY <= maxTileY; ++tileY)
+	{
+		for (int32 tileX = minTileX; tileX <= maxTileX; ++tileX)
+		{
+			/// 覆盖范围与矩形交集的首个瓦片才返回该实体，只占一个瓦片的实体总是通过
+			const int32 tile = bucketStart + tileY * tileCountX + tileX;
+			for (int32 entry = this->tileStarts[tile]; entry < this->tileStarts[tile + 1]; ++entry)
+			{
+				const uint16 firstTile = this->firstTiles[entry];
+				if (FMath::Max(int32(firstTile & 0xFF), minTileX) == tileX && FMath::Max(int32(firstTile >> 8), minTileY) == tileY)
+				{
+					outEntities.Add(this->entities[entry]);
+				}
+			}
+		}
+	}
+}
+
+void URTSCameraScreenBinTrait::BuildTemplate(FMassEntityTemplateBuildContext& BuildContext, const UWorld& World) const
+{
+	BuildContext.RequireFragment<FTransformFragment>();
+	BuildContext.AddTag<FRTSCameraScreenBinTag>();
+}
@@ -0,0 +1,12 @@
+// Copyright 2024 Jesus Bracho All Rights Reserved.
+
+#include "RTSCameraSignificance.h"
+
+#include "MassCommonFragments.h"
+#include "MassEntityTemplateRegistry.h"
+
+void URTSCameraSignificanceTrait::BuildTemplate(FMassEntityTemplateBuildContext& BuildContext, const UWorld& World) const
+{
+	BuildContext.RequireFragment<FTransformFragment>();
+	BuildContext.AddFragment<FRTSCameraSignificanceFragment>();
+}
@@ -0,0 +1,121 @@
+// Copyright 2024 Jesus Bracho All Rights Reserved.
+
+#include "RTSCameraSignificanceProcessor.h"
+
+#include "Engine/World.h"
+#include "MassCommonFragments.h"
+#include "MassCommonTypes.h"
+#include "MassExecutionContext.h"
+#include "OpenRTSCamera.h"
+#include "RTSCameraFrustumQuery.h"
+#include "RTSCameraManagerSubsystem.h"
+#include "RTSCameraSignificance.h"
+#include "RTSCameraSnapshot.h"
+
+DECLARE_CYCLE_STAT(TEXT("Camera Significance"), STAT_RTSCameraSignificance, STATGROUP_OpenRTSCamera);
+
+URTSCameraSignificanceProcessor::URTSCameraSignificanceProcessor()
+	: NearDistanceArmLengthScale(1.0f)
+	, MaxNearDistance(6000.0f)
+	, OffScreenMarginScale(0.5f)
+	, EntityQuery(*this)
+{
+	bAutoRegisterWithProcessingPhases = true;
+	bRequiresGameThreadExecution = false;
+	ExecutionFlags = (int32)(EProcessorExecutionFlags::Client | EProcessorExecutionFlags::Standalone);
+	ExecutionOrder.ExecuteInGroup = UE::Mass::ProcessorGroupNames::LOD;
+}
+
+void URTSCameraSignificanceProcessor::Initialize(UObject& Owner)
+{
+	Super::Initialize(Owner);
+
+	const UWorld* world = Owner.GetWorld();
+	const URTSCameraManagerSubsystem* manager = world != nullptr ? world->GetSubsystem<URTSCameraManagerSubsystem>() : nullptr;
+	if (manager != nullptr)
+	{
+		this->SnapshotChannel = manager->GetPrimarySnapshotChannel();
+	}
+}
+
+void URTSCameraSignificanceProcessor::ConfigureQueries()
+{
+	EntityQuery.AddRequirement<FTransformFragment>(EMassFragmentAccess::ReadOnly);
+	EntityQuery.AddRequirement<FRTSCameraSignificanceFragment>(EMassFragmentAccess::ReadWrite);
+}
+
+void URTSCameraSignificanceProcessor::Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context)
+{
+	FRTSCameraSnapshot snapshot;
+	if (!this->SnapshotChannel.IsValid() || !this->SnapshotChannel->read(snapshot))
+	{
+		return;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_RTSCameraSignificance);
+
+	FRTSCameraFrustumQuery frustumQuery;
+	frustumQuery.build(snapshot);
+
+	/// 查询以相机位置为原点，相对坐标的长度即到相机的距离
+	const FVector origin = frustumQuery.getOrigin();
+	const float nearDistance = FMath::Min(snapshot.ArmLength * this->NearDistanceArmLengthScale, this->MaxNearDistance);
+	const VectorRegister4Float nearDistanceSquared = VectorSetFloat1(nearDistance * nearDistance);
+	const VectorRegister4Float offScreenMargin = VectorSetFloat1(-frustumQuery.getGroundQuadRadius() * this->OffScreenMarginScale);
+
+	EntityQuery.ForEachEntityChunk(EntityManager, Context, [&](FMassExecutionContext& ChunkContext)
+	{
+		const int32 numEntities = ChunkContext.GetNumEntities();
+		const TConstArrayView<FTransformFragment> transforms = ChunkContext.GetFragmentView<FTransformFragment>();
+		const TArrayView<FRTSCameraSignificanceFragment> significances = ChunkContext.GetMutableFragmentView<FRTSCameraSignificanceFragment>();
+
+		for (int32 firstIndex = 0; firstIndex < numEntities; firstIndex += 4)
+		{
+			const int32 laneCount = FMath::Min(4, numEntities - firstIndex);
+
+			/// 变换片段为 AoS 布局，先在双精度下减去原点，再转置为四个实体一组的相对 X/Y/Z；不足四个时重复最后一个实体
+			MS_ALIGN(16) float laneX[4] GCC_ALIGN(16);
+			MS_ALIGN(16) float laneY[4] GCC_ALIGN(16);
+			MS_ALIGN(16) float laneZ[4] GCC_ALIGN(16);
+			for (int32 lane = 0; lane < 4; ++lane)
+			{
+				const FVector relative = transforms[firstIndex + FMath::Min(lane, laneCount - 1)].GetTransform().GetLocation() - origin;
+				laneX[lane] = relative.X;
+				laneY[lane] = relative.Y;
+				laneZ[lane] = relative.Z;
+			}
+			const VectorRegister4Float deltaX = VectorLoadAligned(laneX);
+			const VectorRegister4Float deltaY = VectorLoadAligned(laneY);
+			const VectorRegister4Float deltaZ = VectorLoadAligned(laneZ);
+
+			/// 到四条边的最小有符号距离：>= 0 在屏幕内，>= -margin 在扩展带内
+			const VectorRegister4Float minEdgeDistance = frustumQuery.groundQuadDistance4(deltaX, deltaY);
+			const VectorRegister4Float distanceSquared = VectorMultiplyAdd(deltaX, deltaX, VectorMultiplyAdd(deltaY, deltaY, VectorMultiply(deltaZ, deltaZ)));
+
+			const int32 onScreenMask = VectorMaskBits(VectorCompareGE(minEdgeDistance, GlobalVectorConstants::FloatZero));
+			const int32 nearOffScreenMask = VectorMaskBits(VectorCompareGE(minEdgeDistance, offScreenMargin));
+			const int32 nearMask = VectorMaskBits(VectorCompareLT(distanceSquared, nearDistanceSquared));
+
+			MS_ALIGN(16) float laneDistance[4] GCC_ALIGN(16);
+			VectorStoreAligned(VectorSqrt(distanceSquared), laneDistance);
+
+			for (int32 lane = 0; lane < laneCount; ++lane)
+			{
+				const int32 laneBit = 1 << lane;
+				ERTSCameraSignificance significance = ERTSCameraSignificance::FarOffScreen;
+				if (onScreenMask & laneBit)
+				{
+					significance = (nearMask & laneBit) ? ERTSCameraSignificance::OnScreenNear : ERTSCameraSignificance::OnScreenFar;
+				}
+				else if (nearOffScreenMask & laneBit)
+				{
+					significance = ERTSCameraSignificance::NearOffScreen;
+				}
+
+				FRTSCameraSignificanceFragment& fragment = significances[firstIndex + lane];
+				fragment.Significance = significance;
+				fragment.DistanceToCamera = laneDistance[lane];
+			}
+		}
+	});
+}
@@ -0,0 +1,53 @@
+// Copyright 2024 Jesus Bracho All Rights Reserved.
+
+#include "RTSCameraSnapshot.h"
+
+void FRTSCameraSnapshotChannel::publish(const FRTSCameraSnapshot& snapshot)
+{
+	uint64 words[snapshotWordCount] = {};
+	FMemory::Memcpy(words, &snapshot, sizeof(FRTSCameraSnapshot));
+
+	/// 先把序号置为奇数，再写数据，最后置回偶数；release 保证读取方看到偶数序号时数据已完整
+	const uint64 sequenceBefore = this->sequence.load(std::memory_order_relaxed);
+	this->sequence.store(sequenceBefore + 1, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+
+	for (int32 wordIndex = 0; wordIndex < snapshotWordCount; ++wordIndex)
+	{
+		this->snapshotWords[wordIndex].store(words[wordIndex], std::memory_order_relaxed);
+	}
+
+	this->sequence.store(sequenceBefore + 2, std::memory_order_release);
+}
+
+bool FRTSCameraSnapshotChannel::read(FRTSCameraSnapshot& outSnapshot) const
+{
+	uint64 words[snapshotWordCount];
+	for (;;)
+	{
+		const uint64 sequenceBefore = this->sequence.load(std::memory_order_acquire);
+		if (sequenceBefore == 0)
+		{
+			return false;
+		}
+		if (sequenceBefore & 1)
+		{
+			/// 写入方只复制几百字节，让出时间片后重试即可
+			FPlatformProcess::Yield();
+			continue;
+		}
+
+		for (int32 wordIndex = 0; wordIndex < snapshotWordCount; ++wordIndex)
+		{
+			words[wordIndex] = this->snapshotWords[wordIndex].load(std::memory_order_relaxed);
+		}
+
+		/// 数据读取完成后再确认序号未变化，否则说明读到了两次发布之间的混合数据
+		std::atomic_thread_fence(std::memory_order_acquire);
+		if (this->sequence.load(std::memory_order_relaxed) == sequenceBefore)
+		{
+			FMemory::Memcpy(&outSnapshot, words, sizeof(FRTSCameraSnapshot));
+			return true;
+		}
+	}
+}
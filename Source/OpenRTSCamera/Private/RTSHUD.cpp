@@ -1,6 +1,14 @@
 #include "RTSHUD.h"
 #include "RTSSelectionSubsystem.h"
 #include "RTSSelectable.h"
+#include "RTSSelectableRegistrySubsystem.h"
+#include "RTSCameraFrustumQuery.h"
+#include "RTSCameraManagerSubsystem.h"
+#include "RTSCameraScreenBinProcessor.h"
+#include "RTSCameraScreenBins.h"
+#include "MassCommonFragments.h"
+#include "MassEntitySubsystem.h"
+#include "Fragments/SubType.h"
 #include "MassBattleFuncLib.h"
 #include "RTSSelector.h"
 #include "Engine/Canvas.h"
@@ -18,6 +26,8 @@ ARTSHUD::ARTSHUD()
 	SelectionBoxFillColor = FLinearColor(0.0f, 1.0f, 0.0f, 0.15f);
 	SelectionBoxThickness = 1.0f;
 	MinSelectionSizeSq = 1.0f; // 1 pixel threshold as requested
+	bPreviewSelection = true;
+	SelectionPreviewColor = FLinearColor(0.5f, 1.0f, 0.5f, 0.8f);
 	bIsDrawingSelectionBox = false;
 	bIsPerformingSelection = false;
 }
@@ -33,6 +43,20 @@ void ARTSHUD::DrawHUD()
 		if (FVector2D::DistSquared(SelectionStart, SelectionEnd) > MinSelectionSizeSq)
 		{
 			DrawSelectionBox(SelectionStart, SelectionEnd);
+
+			if (bPreviewSelection)
+			{
+				SelectionPreviewActors.Reset();
+				GetSelectablesInSelectionRectangle(SelectionStart, SelectionEnd, SelectionPreviewActors);
+
+				// Mass preview reads the screen bins only; the ViewTraceForAgents fallback is too costly to run every frame
+				SelectionPreviewEntities.Reset();
+				const FVector2D Min(FMath::Min(SelectionStart.X, SelectionEnd.X), FMath::Min(SelectionStart.Y, SelectionEnd.Y));
+				const FVector2D Max(FMath::Max(SelectionStart.X, SelectionEnd.X), FMath::Max(SelectionStart.Y, SelectionEnd.Y));
+				PerformBinnedMassSelection(Min, Max, false, SelectionPreviewEntities);
+
+				DrawSelectionPreview(SelectionPreviewActors, SelectionPreviewEntities);
+			}
 		}
 	}
 
@@ -147,6 +171,81 @@ void ARTSHUD::DrawSelectionBox_Implementation(const FVector2D& StartPoint, const
 	}
 }
 
+// Default implementation of DrawSelectionPreview. Outlines the screen bounds of each actor and agent under the box.
+void ARTSHUD::DrawSelectionPreview_Implementation(const TArray<AActor*>& PreviewActors, const TArray<FEntityHandle>& PreviewEntities)
+{
+	if (!Canvas)
+	{
+		return;
+	}
+
+	for (const AActor* Actor : PreviewActors)
+	{
+		const FBox ActorBox = Actor ? Actor->GetComponentsBoundingBox(false) : FBox(ForceInit);
+		FBox2D ScreenBox;
+		if (ActorBox.IsValid && ProjectBoundsToScreen(ActorBox, ScreenBox))
+		{
+			DrawPreviewOutline(ScreenBox);
+		}
+	}
+
+	UMassEntitySubsystem* MassSubsystem = PreviewEntities.Num() > 0 && GetWorld() ? GetWorld()->GetSubsystem<UMassEntitySubsystem>() : nullptr;
+	if (!MassSubsystem)
+	{
+		return;
+	}
+
+	// Agents are outlined by the box around their selection sphere
+	const FMassEntityManager& EntityManager = MassSubsystem->GetEntityManager();
+	const float DefaultRadius = GetDefault<URTSCameraScreenBinProcessor>()->DefaultAgentRadius;
+	for (const FEntityHandle& Handle : PreviewEntities)
+	{
+		const FMassEntityHandle Entity(Handle.Index, Handle.Serial);
+		const FTransformFragment* Transform = EntityManager.IsEntityActive(Entity) ? EntityManager.GetFragmentDataPtr<FTransformFragment>(Entity) : nullptr;
+		if (!Transform)
+		{
+			continue;
+		}
+
+		const FAgentRadiusFragment* Radius = EntityManager.GetFragmentDataPtr<FAgentRadiusFragment>(Entity);
+		const FVector Center = Transform->GetTransform().GetLocation();
+		const FVector Extent(Radius ? Radius->Radius : DefaultRadius);
+		FBox2D ScreenBox;
+		if (ProjectBoundsToScreen(FBox(Center - Extent, Center + Extent), ScreenBox))
+		{
+			DrawPreviewOutline(ScreenBox);
+		}
+	}
+}
+
+void ARTSHUD::DrawPreviewOutline(const FBox2D& ScreenBox)
+{
+	const FVector2D TopRight(ScreenBox.Max.X, ScreenBox.Min.Y);
+	const FVector2D BottomLeft(ScreenBox.Min.X, ScreenBox.Max.Y);
+	Canvas->K2_DrawLine(ScreenBox.Min, TopRight, SelectionBoxThickness, SelectionPreviewColor);
+	Canvas->K2_DrawLine(TopRight, ScreenBox.Max, SelectionBoxThickness, SelectionPreviewColor);
+	Canvas->K2_DrawLine(ScreenBox.Max, BottomLeft, SelectionBoxThickness, SelectionPreviewColor);
+	Canvas->K2_DrawLine(BottomLeft, ScreenBox.Min, SelectionBoxThickness, SelectionPreviewColor);
+}
+
+// Same guard as GetActorsInSelectionRectangle: corners behind the camera project mirrored, so they are skipped
+bool ARTSHUD::ProjectBoundsToScreen(const FBox& Bounds, FBox2D& OutScreenBox) const
+{
+	FVector Corners[8];
+	Bounds.GetVertices(Corners);
+
+	OutScreenBox = FBox2D(ForceInit);
+	for (const FVector& Corner : Corners)
+	{
+		const FVector Projected = Project(Corner, true);
+		if (Projected.Z > 0.0f)
+		{
+			OutScreenBox += FVector2D(Projected.X, Projected.Y);
+		}
+	}
+	return OutScreenBox.bIsValid;
+}
+
 #include "RTSSelectionSubsystem.h"
 
 // Default implementation of PerformSelection. Selects actors within the selection box.
@@ -180,15 +279,7 @@ void ARTSHUD::PerformSelection_Implementation()
     // 2. SEARCH (Direct & Concurrent)
     
     // A. Actor Path (The primary way to select anything, including Cities now)
-    TArray<AActor*> RawActors;
-    GetActorsInSelectionRectangle<AActor>(SelectionStart, SelectionEnd, RawActors, false, false);
-    for (AActor* Actor : RawActors)
-    {
-        if (Actor && Actor->FindComponentByClass<URTSSelectable>())
-        {
-            FinalActorSelection.AddUnique(Actor);
-        }
-    }
+    GetSelectablesInSelectionRectangle(SelectionStart, SelectionEnd, FinalActorSelection);
 
     // B. Entity Path (Soldiers - Mass Battle Standard)
     PerformMassSelection(FinalMassSelection);
@@ -250,19 +341,9 @@ void ARTSHUD::PerformSelection_Implementation()
 					int32 ViewportX, ViewportY;
 					PC->GetViewportSize(ViewportX, ViewportY);
 					
-					// Select All in Viewport
-					TArray<AActor*> AllScreenActors;
-					GetActorsInSelectionRectangle<AActor>(FVector2D(0,0), FVector2D(ViewportX, ViewportY), AllScreenActors, false, false);
-					
-					// Filter by Class
+					// Select All of the same class in Viewport
 					FinalActorSelection.Reset();
-					for(AActor* Act : AllScreenActors)
-					{
-						if (Act && Act->GetClass() == MatchClass && Act->FindComponentByClass<URTSSelectable>())
-						{
-							FinalActorSelection.Add(Act);
-						}
-					}
+					GetSelectablesInSelectionRectangle(FVector2D(0,0), FVector2D(ViewportX, ViewportY), FinalActorSelection, MatchClass);
 					
 					// Force Replace Mode for Group Select
 					Modifier = ERTSSelectionModifier::Replace;
@@ -270,15 +351,23 @@ void ARTSHUD::PerformSelection_Implementation()
 					FinalMassSelection.Reset();
 				}
 			}
-			// 2. Mass Entity Group Selection (Future TODO if specific Mass types needed)
+			// 2. Mass Entity Group Selection: same FSubType (or landmark type) on screen, from the per-type screen bins or a filtered trace
 			else if (FinalMassSelection.Num() > 0)
 			{
-				// For Mass, we might need to check Archetype or Entity Config traits.
-				// For now, if we Ctrl+Click a Mass unit, we might select ALL Mass units on screen?
-				// Simplistic implementation: Select ALL valid Mass implementation if we clicked one.
-				
-				// Re-run PerformMassSelection with Full Screen?
-				// Note: Mass selection is expensive. Let's stick to Actor logic first as requested.
+				TArray<FEntityHandle> SameTypeEntities;
+				if (GatherOnScreenEntitiesOfSameType(FinalMassSelection[0], SameTypeEntities) && SameTypeEntities.Num() > 0)
+				{
+					FinalMassSelection = MoveTemp(SameTypeEntities);
+					FinalActorSelection.Reset();
+					Modifier = ERTSSelectionModifier::Replace;
+
+					// The click itself was already applied above; replace it with the whole group
+					if (SelectionSubsystem)
+					{
+						SelectionSubsystem->SetSelectedUnits(FinalActorSelection, FinalMassSelection, Modifier);
+					}
+					UE_LOG(LogTemp, Log, TEXT("RTSHUD: Ctrl+Click selected %d Mass Entities of the same type."), FinalMassSelection.Num());
+				}
 			}
 		}
 	}
@@ -312,9 +401,338 @@ void ARTSHUD::PerformSelection_Implementation()
 	bIsPerformingSelection = false;
 }
 
+void ARTSHUD::GetSelectablesInSelectionRectangle(const FVector2D& FirstPoint, const FVector2D& SecondPoint, TArray<AActor*>& OutActors, const UClass* MatchClass) const
+{
+	URTSSelectableRegistrySubsystem* Registry = GetWorld() ? GetWorld()->GetSubsystem<URTSSelectableRegistrySubsystem>() : nullptr;
+	FRTSCameraFrustumQuery Volume;
+	if (!Registry || Registry->Num() == 0 || !BuildSelectionVolume(FirstPoint, SecondPoint, Volume))
+	{
+		return;
+	}
+
+	// Broad phase: only selectables under the volume's ground footprint reach the SIMD test.
+	// Tests every registered selectable when the footprint is unbounded (e.g. looking at the horizon).
+	Registry->FlushMovedSelectables();
+	const TConstArrayView<FVector> Centers = Registry->GetSelectableBoundsCenters();
+	const TConstArrayView<FVector3f> Extents = Registry->GetSelectableBoundsExtents();
+
+	TArray<int32> HitSlots;
+	float MinZ, MaxZ;
+	FBox2D GroundBox;
+	if (Registry->GetSelectableHeightRange(MinZ, MaxZ) && Volume.getGroundBounds(MinZ, MaxZ, GroundBox))
+	{
+		TArray<int32> CandidateSlots;
+		Registry->QuerySelectablesInGroundBox(GroundBox, CandidateSlots);
+
+		// Pack the candidates' boxes so the kernel reads them contiguously
+		TArray<FVector> CandidateCenters;
+		TArray<FVector3f> CandidateExtents;
+		CandidateCenters.Reserve(CandidateSlots.Num());
+		CandidateExtents.Reserve(CandidateSlots.Num());
+		for (const int32 Slot : CandidateSlots)
+		{
+			CandidateCenters.Add(Centers[Slot]);
+			CandidateExtents.Add(Extents[Slot]);
+		}
+
+		TArray<uint32> Mask;
+		Mask.SetNumUninitialized(FRTSCameraFrustumQuery::getMaskWordCount(CandidateSlots.Num()));
+		Volume.testBoxesVisible(CandidateCenters, CandidateExtents, Mask);
+		for (int32 Candidate = 0; Candidate < CandidateSlots.Num(); ++Candidate)
+		{
+			if (FRTSCameraFrustumQuery::isMaskBitSet(Mask, Candidate))
+			{
+				HitSlots.Add(CandidateSlots[Candidate]);
+			}
+		}
+	}
+	else
+	{
+		TArray<uint32> Mask;
+		Mask.SetNumUninitialized(FRTSCameraFrustumQuery::getMaskWordCount(Centers.Num()));
+		Volume.testBoxesVisible(Centers, Extents, Mask);
+		for (int32 Slot = 0; Slot < Centers.Num(); ++Slot)
+		{
+			if (FRTSCameraFrustumQuery::isMaskBitSet(Mask, Slot))
+			{
+				HitSlots.Add(Slot);
+			}
+		}
+	}
+
+	// Registry slots are unique, so no AddUnique scan is needed
+	const TConstArrayView<TObjectPtr<AActor>> SelectableActors = Registry->GetSelectableActors();
+	OutActors.Reserve(OutActors.Num() + HitSlots.Num());
+	for (const int32 Slot : HitSlots)
+	{
+		AActor* Actor = SelectableActors[Slot];
+		if (Actor && (!MatchClass || Actor->GetClass() == MatchClass))
+		{
+			OutActors.Add(Actor);
+		}
+	}
+}
+
+bool ARTSHUD::BuildSelectionVolume(const FVector2D& FirstPoint, const FVector2D& SecondPoint, FRTSCameraFrustumQuery& OutVolume) const
+{
+	const APlayerController* PC = GetOwningPlayerController();
+	if (!PC || !PC->PlayerCameraManager)
+	{
+		return false;
+	}
+
+	// A click has no area; widen it like PerformMassSelection does so the side planes stay well defined
+	FVector2D Min(FMath::Min(FirstPoint.X, SecondPoint.X), FMath::Min(FirstPoint.Y, SecondPoint.Y));
+	FVector2D Max(FMath::Max(FirstPoint.X, SecondPoint.X), FMath::Max(FirstPoint.Y, SecondPoint.Y));
+	if (Max.X - Min.X < 2.0f)
+	{
+		Min.X -= 1.0f;
+		Max.X += 1.0f;
+	}
+	if (Max.Y - Min.Y < 2.0f)
+	{
+		Min.Y -= 1.0f;
+		Max.Y += 1.0f;
+	}
+
+	const FVector2D ScreenCorners[4] = { Min, FVector2D(Max.X, Min.Y), Max, FVector2D(Min.X, Max.Y) };
+	FVector CornerDirections[4];
+	for (int32 Corner = 0; Corner < 4; ++Corner)
+	{
+		FVector WorldPos;
+		if (!PC->DeprojectScreenPositionToWorld(ScreenCorners[Corner].X, ScreenCorners[Corner].Y, WorldPos, CornerDirections[Corner]))
+		{
+			return false;
+		}
+	}
+	return OutVolume.buildFromCornerRays(PC->PlayerCameraManager->GetCameraLocation(), CornerDirections);
+}
+
 #include "MassBattleFuncLib.h"
 #include "MassBattleStructs.h"
 
+TSharedPtr<FRTSCameraScreenBins, ESPMode::ThreadSafe> ARTSHUD::GetFreshScreenBins() const
+{
+	// The bins follow the primary player's camera only; split-screen guests use the trace
+	const APlayerController* PC = GetOwningPlayerController();
+	const URTSCameraManagerSubsystem* CameraManager = GetWorld() ? GetWorld()->GetSubsystem<URTSCameraManagerSubsystem>() : nullptr;
+	if (!PC || !PC->IsPrimaryPlayer() || !CameraManager)
+	{
+		return nullptr;
+	}
+
+	// The processor stamps its own frame even while the camera sleeps, so bins older than a couple of frames
+	// mean it has stopped publishing (no agents carry the trait, or some agents lack it)
+	TSharedRef<FRTSCameraScreenBins, ESPMode::ThreadSafe> ScreenBins = CameraManager->GetPrimaryScreenBins();
+	const uint64 PublishFrame = ScreenBins->getPublishFrame();
+	if (PublishFrame == 0 || GFrameCounter - PublishFrame > 2)
+	{
+		return nullptr;
+	}
+	return ScreenBins;
+}
+
+bool ARTSHUD::PixelRectToScreenBinRect(const FVector2D& Min, const FVector2D& Max, FVector2f& OutScreenMin, FVector2f& OutScreenMax) const
+{
+	const APlayerController* PC = GetOwningPlayerController();
+	int32 ViewportX = 0, ViewportY = 0;
+	if (PC)
+	{
+		PC->GetViewportSize(ViewportX, ViewportY);
+	}
+	if (ViewportX <= 0 || ViewportY <= 0)
+	{
+		return false;
+	}
+
+	// Pixels to the bins' aspect-independent camera-plane coordinates (horizontal FOV kept, Y up).
+	// Widened by half a tile to cover agents that moved since the bins were built.
+	const float HalfTile = 1.0f / FRTSCameraScreenBins::tileCountX;
+	const float InvAspect = float(ViewportY) / float(ViewportX);
+	OutScreenMin = FVector2f(2.0f * Min.X / ViewportX - 1.0f - HalfTile, (1.0f - 2.0f * Max.Y / ViewportY) * InvAspect - HalfTile);
+	OutScreenMax = FVector2f(2.0f * Max.X / ViewportX - 1.0f + HalfTile, (1.0f - 2.0f * Min.Y / ViewportY) * InvAspect + HalfTile);
+	return true;
+}
+
+void ARTSHUD::SelectMassCandidates(const TArray<FMassEntityHandle>& Candidates, const FRTSCameraFrustumQuery& Volume, TArray<FMassEntityHandle>& OutEntities, TArray<FVector>& OutLocations) const
+{
+	UMassEntitySubsystem* MassSubsystem = GetWorld() ? GetWorld()->GetSubsystem<UMassEntitySubsystem>() : nullptr;
+	if (!MassSubsystem)
+	{
+		return;
+	}
+
+	// Exact test on current positions, packed for the SIMD kernel
+	const FMassEntityManager& EntityManager = MassSubsystem->GetEntityManager();
+	const float DefaultRadius = GetDefault<URTSCameraScreenBinProcessor>()->DefaultAgentRadius;
+	TArray<FMassEntityHandle> Entities;
+	TArray<FVector> Centers;
+	TArray<float> Radii;
+	Entities.Reserve(Candidates.Num());
+	Centers.Reserve(Candidates.Num());
+	Radii.Reserve(Candidates.Num());
+	for (const FMassEntityHandle& Entity : Candidates)
+	{
+		if (!EntityManager.IsEntityActive(Entity))
+		{
+			continue;
+		}
+		if (const FTransformFragment* Transform = EntityManager.GetFragmentDataPtr<FTransformFragment>(Entity))
+		{
+			const FAgentRadiusFragment* Radius = EntityManager.GetFragmentDataPtr<FAgentRadiusFragment>(Entity);
+			Entities.Add(Entity);
+			Centers.Add(Transform->GetTransform().GetLocation());
+			Radii.Add(Radius ? Radius->Radius : DefaultRadius);
+		}
+	}
+
+	TArray<uint32> Mask;
+	Mask.SetNumUninitialized(FRTSCameraFrustumQuery::getMaskWordCount(Centers.Num()));
+	Volume.testSpheresVisible(Centers, Radii, Mask);
+	for (int32 Candidate = 0; Candidate < Centers.Num(); ++Candidate)
+	{
+		if (FRTSCameraFrustumQuery::isMaskBitSet(Mask, Candidate))
+		{
+			OutEntities.Add(Entities[Candidate]);
+			OutLocations.Add(Centers[Candidate]);
+		}
+	}
+}
+
+static FEntityHandle ToEntityHandle(const FMassEntityHandle& Entity)
+{
+	FEntityHandle Handle;
+	Handle.Index = Entity.Index;
+	Handle.Serial = Entity.SerialNumber;
+	return Handle;
+}
+
+bool ARTSHUD::PerformBinnedMassSelection(const FVector2D& Min, const FVector2D& Max, const bool bIsClick, TArray<FEntityHandle>& OutEntities) const
+{
+	const TSharedPtr<FRTSCameraScreenBins, ESPMode::ThreadSafe> ScreenBins = GetFreshScreenBins();
+	FVector2f ScreenMin, ScreenMax;
+	TArray<FMassEntityHandle> Candidates;
+	FRTSCameraFrustumQuery Volume;
+	if (!ScreenBins.IsValid()
+		|| !PixelRectToScreenBinRect(Min, Max, ScreenMin, ScreenMax)
+		|| !ScreenBins->gatherEntities(ScreenMin, ScreenMax, Candidates)
+		|| !BuildSelectionVolume(Min, Max, Volume))
+	{
+		return false;
+	}
+
+	TArray<FMassEntityHandle> Hits;
+	TArray<FVector> HitLocations;
+	SelectMassCandidates(Candidates, Volume, Hits, HitLocations);
+
+	OutEntities.Reset();
+	if (bIsClick)
+	{
+		// Same result as the trace's NearToFar with a keep count of 1
+		int32 Nearest = INDEX_NONE;
+		double NearestDistSq = TNumericLimits<double>::Max();
+		for (int32 Hit = 0; Hit < Hits.Num(); ++Hit)
+		{
+			const double DistSq = FVector::DistSquared(HitLocations[Hit], Volume.getOrigin());
+			if (DistSq < NearestDistSq)
+			{
+				NearestDistSq = DistSq;
+				Nearest = Hit;
+			}
+		}
+		if (Nearest != INDEX_NONE)
+		{
+			OutEntities.Add(ToEntityHandle(Hits[Nearest]));
+		}
+	}
+	else
+	{
+		OutEntities.Reserve(Hits.Num());
+		for (const FMassEntityHandle& Hit : Hits)
+		{
+			OutEntities.Add(ToEntityHandle(Hit));
+		}
+	}
+	return true;
+}
+
+bool ARTSHUD::GatherOnScreenEntitiesOfSameType(const FEntityHandle& TemplateEntity, TArray<FEntityHandle>& OutEntities) const
+{
+	UWorld* World = GetWorld();
+	UMassEntitySubsystem* MassSubsystem = World ? World->GetSubsystem<UMassEntitySubsystem>() : nullptr;
+	const APlayerController* PC = GetOwningPlayerController();
+	if (!MassSubsystem || !PC)
+	{
+		return false;
+	}
+
+	const FMassEntityHandle NativeTemplate(TemplateEntity.Index, TemplateEntity.Serial);
+	const FMassEntityManager& EntityManager = MassSubsystem->GetEntityManager();
+	if (!EntityManager.IsEntityActive(NativeTemplate))
+	{
+		return false;
+	}
+
+	int32 ViewportX, ViewportY;
+	PC->GetViewportSize(ViewportX, ViewportY);
+	const FVector2D ViewportMin(0, 0);
+	const FVector2D ViewportMax(ViewportX, ViewportY);
+
+	// Landmarks of one type are spawned from one config and share its FSubType, so the FSubType bucket
+	// narrows both kinds of grouping; the landmark type is only matched within it
+	const FSubType* TemplateSubType = EntityManager.GetFragmentDataPtr<FSubType>(NativeTemplate);
+	const int32 TypeKey = TemplateSubType ? TemplateSubType->Index : INDEX_NONE;
+
+	TArray<FMassEntityHandle> Hits;
+	const TSharedPtr<FRTSCameraScreenBins, ESPMode::ThreadSafe> ScreenBins = GetFreshScreenBins();
+	FVector2f ScreenMin, ScreenMax;
+	FRTSCameraFrustumQuery Volume;
+	if (ScreenBins.IsValid()
+		&& PixelRectToScreenBinRect(ViewportMin, ViewportMax, ScreenMin, ScreenMax)
+		&& BuildSelectionVolume(ViewportMin, ViewportMax, Volume))
+	{
+		TArray<FMassEntityHandle> Candidates;
+		ScreenBins->gatherEntitiesOfType(TypeKey, ScreenMin, ScreenMax, Candidates);
+
+		TArray<FVector> HitLocations;
+		SelectMassCandidates(Candidates, Volume, Hits, HitLocations);
+	}
+	else
+	{
+		// No bins for this view: trace the whole viewport and keep the template's FSubType
+		TArray<FEntityHandle> Traced;
+		TraceMassSelection(ViewportMin, ViewportMax, false, Traced);
+		for (const FEntityHandle& Entity : Traced)
+		{
+			const FMassEntityHandle NativeEntity(Entity.Index, Entity.Serial);
+			if (!EntityManager.IsEntityActive(NativeEntity))
+			{
+				continue;
+			}
+			const FSubType* SubType = EntityManager.GetFragmentDataPtr<FSubType>(NativeEntity);
+			if ((SubType ? SubType->Index : INDEX_NONE) == TypeKey)
+			{
+				Hits.Add(NativeEntity);
+			}
+		}
+	}
+
+	// Same type key as URTSSelectionSubsystem's grouping: landmark type first, then FSubType
+	ULandmarkSubsystem* LandmarkSub = World->GetSubsystem<ULandmarkSubsystem>();
+	const FString LandmarkType = LandmarkSub ? LandmarkSub->FindTypeByEntity(TemplateEntity) : FString();
+
+	OutEntities.Reset(Hits.Num());
+	for (const FMassEntityHandle& Hit : Hits)
+	{
+		const FEntityHandle Handle = ToEntityHandle(Hit);
+		if (LandmarkType.IsEmpty() || LandmarkSub->FindTypeByEntity(Handle) == LandmarkType)
+		{
+			OutEntities.Add(Handle);
+		}
+	}
+	return true;
+}
+
 void ARTSHUD::PerformMassSelection(TArray<FEntityHandle>& OutEntities)
 {
 	OutEntities.Reset();
@@ -346,13 +764,27 @@ void ARTSHUD::PerformMassSelection(TArray<FEntityHandle>& OutEntities)
         MaxY += 1.0f;
     }
 
+	// 优先读取主相机维护的屏幕瓦片，代价只取决于选区下的实体数量
+	if (PerformBinnedMassSelection(FVector2D(MinX, MinY), FVector2D(MaxX, MaxY), bIsClick, OutEntities))
+	{
+		return;
+	}
+
+	TraceMassSelection(FVector2D(MinX, MinY), FVector2D(MaxX, MaxY), bIsClick, OutEntities);
+}
+
+void ARTSHUD::TraceMassSelection(const FVector2D& Min, const FVector2D& Max, const bool bIsClick, TArray<FEntityHandle>& OutEntities) const
+{
+	APlayerController* PC = GetOwningPlayerController();
+	if (!PC || !PC->PlayerCameraManager) return;
+
 	// 关键：逆时针排列（左上→左下→右下→右上）确保视锥体平面法线朝内
 	// 顺时针排列会使法线朝外，导致 PlaneDot 过滤掉框内所有实体
 	TArray<FVector2D> ScreenPoints = {
-		FVector2D(MinX, MinY),  // 左上
-		FVector2D(MinX, MaxY),  // 左下
-		FVector2D(MaxX, MaxY),  // 右下
-		FVector2D(MaxX, MinY),  // 右上
+		FVector2D(Min.X, Min.Y),  // 左上
+		FVector2D(Min.X, Max.Y),  // 左下
+		FVector2D(Max.X, Max.Y),  // 右下
+		FVector2D(Max.X, Min.Y),  // 右上
 	};
 
 	FViewTracePoints TracePoints;
@@ -385,7 +817,7 @@ void ARTSHUD::PerformMassSelection(TArray<FEntityHandle>& OutEntities)
 		UMassBattleFuncLib::ViewTraceForAgents(this, bHit, Results, LocalKeepCount, TracePoints, false, FVector::ZeroVector, 1.0f, SortMode);
 #endif
 
-		UE_LOG(LogTemp, Warning, TEXT("PerformMassSelection: bHit=%d Results=%d IsClick=%d"), bHit ? 1:0, Results.Num(), bIsClick?1:0);
+		UE_LOG(LogTemp, Warning, TEXT("TraceMassSelection: bHit=%d Results=%d IsClick=%d"), bHit ? 1:0, Results.Num(), bIsClick?1:0);
 
 		if (bHit)
 		{
@@ -1 +1,25 @@
 #include "RTSSelectable.h"
+
+#include "RTSSelectableRegistrySubsystem.h"
+
+void URTSSelectable::OnRegister()
+{
+	Super::OnRegister();
+
+	const UWorld* World = GetWorld();
+	if (URTSSelectableRegistrySubsystem* Registry = World ? World->GetSubsystem<URTSSelectableRegistrySubsystem>() : nullptr)
+	{
+		Registry->RegisterSelectable(this);
+	}
+}
+
+void URTSSelectable::OnUnregister()
+{
+	const UWorld* World = GetWorld();
+	if (URTSSelectableRegistrySubsystem* Registry = World ? World->GetSubsystem<URTSSelectableRegistrySubsystem>() : nullptr)
+	{
+		Registry->UnregisterSelectable(this);
+	}
+
+	Super::OnUnregister();
+}
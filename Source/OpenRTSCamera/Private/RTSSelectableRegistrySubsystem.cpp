@@ -0,0 +1,301 @@
+// Copyright 2024 Jesus Bracho All Rights Reserved.
+
+#include "RTSSelectableRegistrySubsystem.h"
+
+#include "Components/MassBattleAgentComponent.h"
+#include "Components/SceneComponent.h"
+#include "GameFramework/Actor.h"
+#include "RTSSelectable.h"
+
+bool URTSSelectableRegistrySubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void URTSSelectableRegistrySubsystem::Deinitialize()
+{
+	for (URTSSelectable* selectable : this->Selectables)
+	{
+		if (selectable != nullptr)
+		{
+			selectable->RegistrySlot = INDEX_NONE;
+		}
+	}
+	for (const FSpatialEntry& entry : this->SpatialEntries)
+	{
+		if (USceneComponent* root = entry.TrackedRoot.Get())
+		{
+			root->TransformUpdated.RemoveAll(this);
+		}
+	}
+	this->Selectables.Reset();
+	this->Owners.Reset();
+	this->MassAgents.Reset();
+	this->SlotByActor.Reset();
+	this->SpatialEntries.Reset();
+	this->BoundsCenters.Reset();
+	this->BoundsExtents.Reset();
+	this->Cells.Reset();
+	this->MovedSlots.Reset();
+
+	Super::Deinitialize();
+}
+
+void URTSSelectableRegistrySubsystem::RegisterSelectable(URTSSelectable* Selectable)
+{
+	AActor* owner = Selectable != nullptr ? Selectable->GetOwner() : nullptr;
+	if (owner == nullptr || Selectable->RegistrySlot != INDEX_NONE || this->SlotByActor.Contains(owner))
+	{
+		return;
+	}
+
+	/// Mass 代理组件在登记时查找并缓存，之后选择时的代理转换无需再遍历组件；登记时尚不存在的由 FindMassAgent 补查
+	const int32 slot = this->Selectables.Add(Selectable);
+	this->Owners.Add(owner);
+	this->MassAgents.Add(owner->FindComponentByClass<UMassBattleAgentComponent>());
+	this->SlotByActor.Add(owner, slot);
+	Selectable->RegistrySlot = slot;
+
+	/// 登记时其余组件可能尚未注册，包围盒留到首次查询前再计算
+	FSpatialEntry& entry = this->SpatialEntries.AddDefaulted_GetRef();
+	this->BoundsCenters.Add(owner->GetActorLocation());
+	this->BoundsExtents.Add(FVector3f::ZeroVector);
+	USceneComponent* root = owner->GetRootComponent();
+	if (root != nullptr && root->Mobility != EComponentMobility::Static)
+	{
+		root->TransformUpdated.AddUObject(this, &URTSSelectableRegistrySubsystem::HandleRootTransformUpdated);
+		entry.TrackedRoot = root;
+	}
+	this->MarkMoved(slot);
+}
+
+void URTSSelectableRegistrySubsystem::UnregisterSelectable(URTSSelectable* Selectable)
+{
+	const int32 slot = Selectable != nullptr ? Selectable->RegistrySlot : INDEX_NONE;
+	if (!this->Selectables.IsValidIndex(slot) || this->Selectables[slot] != Selectable)
+	{
+		return;
+	}
+
+	if (USceneComponent* root = this->SpatialEntries[slot].TrackedRoot.Get())
+	{
+		root->TransformUpdated.RemoveAll(this);
+	}
+	this->RemoveFromCell(slot);
+
+	/// 交换删除：末尾元素移入空出的下标，并更新其回指下标、映射与网格单元中的记录
+	this->SlotByActor.Remove(this->Owners[slot]);
+	const int32 lastSlot = this->Selectables.Num() - 1;
+	if (slot != lastSlot)
+	{
+		URTSSelectable* moved = this->Selectables[lastSlot];
+		moved->RegistrySlot = slot;
+		this->SlotByActor.Add(this->Owners[lastSlot], slot);
+
+		const FSpatialEntry& movedEntry = this->SpatialEntries[lastSlot];
+		if (movedEntry.CellEntry != INDEX_NONE)
+		{
+			this->Cells[movedEntry.Cell][movedEntry.CellEntry] = slot;
+		}
+		if (movedEntry.bMoved)
+		{
+			this->MovedSlots.Add(slot);
+		}
+	}
+	this->Selectables.RemoveAtSwap(slot, 1, EAllowShrinking::No);
+	this->Owners.RemoveAtSwap(slot, 1, EAllowShrinking::No);
+	this->MassAgents.RemoveAtSwap(slot, 1, EAllowShrinking::No);
+	this->SpatialEntries.RemoveAtSwap(slot, 1, EAllowShrinking::No);
+	this->BoundsCenters.RemoveAtSwap(slot, 1, EAllowShrinking::No);
+	this->BoundsExtents.RemoveAtSwap(slot, 1, EAllowShrinking::No);
+	Selectable->RegistrySlot = INDEX_NONE;
+}
+
+URTSSelectable* URTSSelectableRegistrySubsystem::FindSelectable(const AActor* Actor) const
+{
+	const int32* slot = this->SlotByActor.Find(Actor);
+	return slot != nullptr ? this->Selectables[*slot].Get() : nullptr;
+}
+
+UMassBattleAgentComponent* URTSSelectableRegistrySubsystem::FindMassAgent(const AActor* Actor)
+{
+	const int32* slot = this->SlotByActor.Find(Actor);
+	if (slot == nullptr)
+	{
+		return nullptr;
+	}
+
+	/// 蓝图构造脚本中可选择组件可能先于代理组件注册，登记时查不到的代理在此补查
+	TObjectPtr<UMassBattleAgentComponent>& massAgent = this->MassAgents[*slot];
+	if (massAgent == nullptr)
+	{
+		massAgent = Actor->FindComponentByClass<UMassBattleAgentComponent>();
+	}
+	return massAgent.Get();
+}
+
+void URTSSelectableRegistrySubsystem::QuerySelectablesInGroundBox(const FBox2D& GroundBox, TArray<int32>& OutSlots)
+{
+	this->FlushMovedSelectables();
+	if (!GroundBox.bIsValid || this->Cells.IsEmpty())
+	{
+		return;
+	}
+
+	/// 单位只登记在中心所在的单元，查询范围按最大半径扩展后再逐个做圆与矩形的精确测试
+	const FBox2D expandedBox = GroundBox.ExpandBy(this->MaxGroundRadius);
+	const FIntPoint minCell = this->GetCellCoord(expandedBox.Min);
+	const FIntPoint maxCell = this->GetCellCoord(expandedBox.Max);
+	const int64 cellRangeCount = int64(maxCell.X - minCell.X + 1) * int64(maxCell.Y - minCell.Y + 1);
+
+	auto testCell = [this, &GroundBox, &OutSlots](const TArray<int32>& cellSlots)
+	{
+		for (const int32 slot : cellSlots)
+		{
+			const FSpatialEntry& entry = this->SpatialEntries[slot];
+			if (GroundBox.ComputeSquaredDistanceToPoint(entry.Center) <= FMath::Square(entry.Radius))
+			{
+				OutSlots.Add(slot);
+			}
+		}
+	};
+
+	/// 范围覆盖的单元数多于非空单元数时（如俯视整张地图），直接遍历非空单元
+	if (cellRangeCount > this->Cells.Num())
+	{
+		for (const TPair<FIntPoint, TArray<int32>>& cell : this->Cells)
+		{
+			if (cell.Key.X >= minCell.X && cell.Key.X <= maxCell.X && cell.Key.Y >= minCell.Y && cell.Key.Y <= maxCell.Y)
+			{
+				testCell(cell.Value);
+			}
+		}
+		return;
+	}
+
+	for (int32 cellY = minCell.Y; cellY <= maxCell.Y; ++cellY)
+	{
+		for (int32 cellX = minCell.X; cellX <= maxCell.X; ++cellX)
+		{
+			if (const TArray<int32>* cellSlots = this->Cells.Find(FIntPoint(cellX, cellY)))
+			{
+				testCell(*cellSlots);
+			}
+		}
+	}
+}
+
+bool URTSSelectableRegistrySubsystem::GetSelectableHeightRange(float& OutMinZ, float& OutMaxZ)
+{
+	this->FlushMovedSelectables();
+	if (this->MinBoundsZ > this->MaxBoundsZ)
+	{
+		return false;
+	}
+	OutMinZ = this->MinBoundsZ;
+	OutMaxZ = this->MaxBoundsZ;
+	return true;
+}
+
+void URTSSelectableRegistrySubsystem::HandleRootTransformUpdated(USceneComponent* UpdatedComponent, EUpdateTransformFlags, ETeleportType)
+{
+	const AActor* owner = UpdatedComponent != nullptr ? UpdatedComponent->GetOwner() : nullptr;
+	if (const int32* slot = this->SlotByActor.Find(owner))
+	{
+		this->MarkMoved(*slot);
+	}
+}
+
+void URTSSelectableRegistrySubsystem::MarkMoved(const int32 Slot)
+{
+	FSpatialEntry& entry = this->SpatialEntries[Slot];
+	if (!entry.bMoved)
+	{
+		entry.bMoved = true;
+		this->MovedSlots.Add(Slot);
+	}
+}
+
+void URTSSelectableRegistrySubsystem::FlushMovedSelectables()
+{
+	for (const int32 slot : this->MovedSlots)
+	{
+		if (this->SpatialEntries.IsValidIndex(slot) && this->SpatialEntries[slot].bMoved)
+		{
+			this->SpatialEntries[slot].bMoved = false;
+			this->UpdateSpatialEntry(slot);
+		}
+	}
+	this->MovedSlots.Reset();
+}
+
+void URTSSelectableRegistrySubsystem::UpdateSpatialEntry(const int32 Slot)
+{
+	const AActor* owner = this->Owners[Slot];
+	FSpatialEntry& entry = this->SpatialEntries[Slot];
+
+	/// 与框选的精确测试一致，只统计有碰撞的组件
+	const FBox bounds = owner != nullptr ? owner->GetComponentsBoundingBox(false) : FBox(ForceInit);
+	if (bounds.IsValid)
+	{
+		const FVector center = bounds.GetCenter();
+		const FVector extent = bounds.GetExtent();
+		entry.Center = FVector2D(center.X, center.Y);
+		entry.Radius = FVector2D(extent.X, extent.Y).Size();
+		this->BoundsCenters[Slot] = center;
+		this->BoundsExtents[Slot] = FVector3f(extent);
+		this->MinBoundsZ = FMath::Min(this->MinBoundsZ, float(bounds.Min.Z));
+		this->MaxBoundsZ = FMath::Max(this->MaxBoundsZ, float(bounds.Max.Z));
+	}
+	else if (owner != nullptr)
+	{
+		const FVector location = owner->GetActorLocation();
+		entry.Center = FVector2D(location.X, location.Y);
+		entry.Radius = 0.0f;
+		this->BoundsCenters[Slot] = location;
+		this->BoundsExtents[Slot] = FVector3f::ZeroVector;
+		this->MinBoundsZ = FMath::Min(this->MinBoundsZ, float(location.Z));
+		this->MaxBoundsZ = FMath::Max(this->MaxBoundsZ, float(location.Z));
+	}
+	this->MaxGroundRadius = FMath::Max(this->MaxGroundRadius, entry.Radius);
+
+	/// 仍在原单元内时只更新圆，不改动网格
+	const FIntPoint cell = this->GetCellCoord(entry.Center);
+	if (entry.CellEntry != INDEX_NONE && entry.Cell == cell)
+	{
+		return;
+	}
+	this->RemoveFromCell(Slot);
+	TArray<int32>& cellSlots = this->Cells.FindOrAdd(cell);
+	entry.Cell = cell;
+	entry.CellEntry = cellSlots.Add(Slot);
+}
+
+void URTSSelectableRegistrySubsystem::RemoveFromCell(const int32 Slot)
+{
+	FSpatialEntry& entry = this->SpatialEntries[Slot];
+	if (entry.CellEntry == INDEX_NONE)
+	{
+		return;
+	}
+
+	TArray<int32>& cellSlots = this->Cells.FindChecked(entry.Cell);
+	cellSlots.RemoveAtSwap(entry.CellEntry, 1, EAllowShrinking::No);
+	if (cellSlots.IsValidIndex(entry.CellEntry))
+	{
+		this->SpatialEntries[cellSlots[entry.CellEntry]].CellEntry = entry.CellEntry;
+	}
+	if (cellSlots.IsEmpty())
+	{
+		this->Cells.Remove(entry.Cell);
+	}
+	entry.CellEntry = INDEX_NONE;
+}
+
+FIntPoint URTSSelectableRegistrySubsystem::GetCellCoord(const FVector2D& GroundLocation) const
+{
+	const double inverseCellSize = 1.0 / FMath::Max(this->SpatialCellSize, 1.0f);
+	return FIntPoint(
+		FMath::FloorToInt32(FMath::Clamp(GroundLocation.X * inverseCellSize, double(MIN_int32 / 2), double(MAX_int32 / 2))),
+		FMath::FloorToInt32(FMath::Clamp(GroundLocation.Y * inverseCellSize, double(MIN_int32 / 2), double(MAX_int32 / 2))));
+}
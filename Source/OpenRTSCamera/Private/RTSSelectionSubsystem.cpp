@@ -1,5 +1,6 @@
 #include "RTSSelectionSubsystem.h"
 #include "RTSSelectable.h"
+#include "RTSSelectableRegistrySubsystem.h"
 #include "RTSCommandSubsystem.h"
 #include "MassEntitySubsystem.h"
 #include "MassEntityManager.h"
@@ -75,12 +76,17 @@ void URTSSelectionSubsystem::SetSelectedUnits(const TArray<AActor*>& InActors, c
     TArray<FEntityHandle> FinalEntities = InEntities;
 
     // Strategic Resolution: Convert Actors to Entities if they are Proxies
+    // Registered selectables carry a cached agent; anything else falls back to a component lookup.
+    URTSSelectableRegistrySubsystem* Registry = GetWorld() ? GetWorld()->GetSubsystem<URTSSelectableRegistrySubsystem>() : nullptr;
     for (int32 i = FinalActors.Num() - 1; i >= 0; i--)
     {
         AActor* Actor = FinalActors[i];
         if (Actor)
         {
-            if (UMassBattleAgentComponent* MassAgent = Actor->FindComponentByClass<UMassBattleAgentComponent>())
+            UMassBattleAgentComponent* MassAgent = Registry && Registry->IsSelectable(Actor)
+                ? Registry->FindMassAgent(Actor)
+                : Actor->FindComponentByClass<UMassBattleAgentComponent>();
+            if (MassAgent)
             {
                 FEntityHandle ProxiedEntity = MassAgent->GetEntityHandle();
                 if (ProxiedEntity.Index != 0)
@@ -266,7 +272,8 @@ FRTSUnitData URTSSelectionSubsystem::CreateUnitDataFromActor(AActor* Actor)
 		Data.ActorPtr = Actor;
 		Data.bIsMassEntity = false;
 		
-		if (auto Selectable = Actor->FindComponentByClass<URTSSelectable>())
+		const URTSSelectableRegistrySubsystem* Registry = GetWorld() ? GetWorld()->GetSubsystem<URTSSelectableRegistrySubsystem>() : nullptr;
+		if (auto Selectable = Registry ? Registry->FindSelectable(Actor) : Actor->FindComponentByClass<URTSSelectable>())
 		{
 			Data.Icon = Selectable->Icon;
 			Data.Health = Selectable->Health;
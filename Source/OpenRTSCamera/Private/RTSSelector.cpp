@@ -5,6 +5,7 @@
 #include "EnhancedInputComponent.h"
 #include "EnhancedInputSubsystems.h"
 #include "RTSSelectable.h"
+#include "RTSSelectableRegistrySubsystem.h"
 #include "Kismet/GameplayStatics.h"
 
 // Sets default values for this component's properties
@@ -66,9 +67,10 @@ void URTSSelector::HandleSelectedActors_Implementation(const TArray<AActor*>& Ne
 	ClearSelectedActors();
     
 	// Add new selected actors and call OnSelected
+	const URTSSelectableRegistrySubsystem* Registry = GetWorld() ? GetWorld()->GetSubsystem<URTSSelectableRegistrySubsystem>() : nullptr;
 	for (const auto& Actor : NewSelectedActors)
 	{
-		if (URTSSelectable* SelectableComponent = Actor->FindComponentByClass<URTSSelectable>())
+		if (URTSSelectable* SelectableComponent = Registry ? Registry->FindSelectable(Actor) : Actor->FindComponentByClass<URTSSelectable>())
 		{
 			this->SelectedActors.Add(SelectableComponent);
 			SelectableComponent->OnSelected();
@@ -0,0 +1,354 @@
+// Copyright 2024 Jesus Bracho All Rights Reserved.
+
+#include "RTSTerrainHeightfieldSubsystem.h"
+
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "Kismet/GameplayStatics.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogRTSHeightfield, Log, All);
+
+const FName URTSTerrainHeightfieldSubsystem::DynamicTerrainTag(TEXT("OpenRTSCamera#DynamicTerrain"));
+
+namespace
+{
+	/// 未命中地面的采样点使用的哨兵值
+	constexpr float InvalidHeight = -TNumericLimits<float>::Max();
+}
+
+bool URTSTerrainHeightfieldSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	/// 高度场只服务运行中的游戏世界
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void URTSTerrainHeightfieldSubsystem::Deinitialize()
+{
+	if (UWorld* world = this->GetWorld())
+	{
+		world->RemoveOnActorSpawnedHandler(this->ActorSpawnedHandle);
+	}
+
+	for (const auto& pair : this->TrackedDynamicFootprints)
+	{
+		if (AActor* actor = pair.Key.Get())
+		{
+			actor->OnDestroyed.RemoveDynamic(this, &URTSTerrainHeightfieldSubsystem::HandleDynamicTerrainDestroyed);
+			if (USceneComponent* rootComponent = actor->GetRootComponent())
+			{
+				rootComponent->TransformUpdated.RemoveAll(this);
+			}
+		}
+	}
+	this->TrackedDynamicFootprints.Reset();
+	this->HeightGrids.Reset();
+
+	Super::Deinitialize();
+}
+
+TStatId URTSTerrainHeightfieldSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(URTSTerrainHeightfieldSubsystem, STATGROUP_Tickables);
+}
+
+void URTSTerrainHeightfieldSubsystem::BuildHeightfield(
+	const AActor* Region,
+	const FBox2D& Bounds,
+	const float CellSize,
+	const ECollisionChannel Channel,
+	const float TraceTopZ,
+	const float TraceBottomZ
+)
+{
+	if (Region == nullptr || !Bounds.bIsValid || CellSize <= 0.0f)
+	{
+		return;
+	}
+
+	/// 同一区域的多个相机共享同一份网格：范围与精度一致时直接复用（包括仍在分帧构建中的网格）
+	FRTSTerrainHeightGrid* existingGrid = this->HeightGrids.Find(Region);
+	if (existingGrid != nullptr
+		&& existingGrid->RequestedBounds == Bounds
+		&& FMath::IsNearlyEqual(existingGrid->RequestedCellSize, CellSize)
+		&& existingGrid->TraceChannel == Channel)
+	{
+		return;
+	}
+
+	/// 顺带丢弃已销毁区域的网格
+	for (auto iterator = this->HeightGrids.CreateIterator(); iterator; ++iterator)
+	{
+		if (iterator->Key.ResolveObjectPtr() == nullptr)
+		{
+			iterator.RemoveCurrent();
+		}
+	}
+
+	FRTSTerrainHeightGrid& grid = this->HeightGrids.FindOrAdd(Region);
+	grid.RequestedBounds = Bounds;
+	grid.RequestedCellSize = CellSize;
+	grid.TraceChannel = Channel;
+	grid.TraceStartZ = TraceTopZ;
+	grid.TraceEndZ = TraceBottomZ;
+
+	/// 超出采样预算时等比放大间距，保证单个网格的总采样量有上限
+	const FVector2D size = Bounds.GetSize();
+	float effectiveCellSize = CellSize;
+	const double requestedSampleCount = (FMath::CeilToDouble(size.X / CellSize) + 1.0) * (FMath::CeilToDouble(size.Y / CellSize) + 1.0);
+	if (requestedSampleCount > this->MaxSampleCount)
+	{
+		effectiveCellSize *= FMath::Sqrt(requestedSampleCount / this->MaxSampleCount);
+		UE_LOG(LogRTSHeightfield, Warning, TEXT("高度场采样点超出预算 (%.0f > %d)，采样间距放大至 %.1f"), requestedSampleCount, this->MaxSampleCount, effectiveCellSize);
+	}
+
+	grid.GridOrigin = Bounds.Min;
+	grid.GridCellSize = effectiveCellSize;
+	grid.InverseGridCellSize = 1.0f / effectiveCellSize;
+	/// 每个方向至少两个节点，双线性插值总能取到完整的单元
+	grid.SampleCountX = FMath::Max(FMath::CeilToInt(size.X / effectiveCellSize) + 1, 2);
+	grid.SampleCountY = FMath::Max(FMath::CeilToInt(size.Y / effectiveCellSize) + 1, 2);
+
+	/// 采样推迟到 Tick 中按预算进行，构建完成前查询返回 false
+	const int32 nodeCount = grid.SampleCountX * grid.SampleCountY;
+	grid.Heights.SetNumUninitialized(nodeCount);
+	grid.BuiltNodeCount = 0;
+	grid.DirtyNodeQueue.Reset();
+	grid.DirtyNodeFlags.Init(false, nodeCount);
+
+	UE_LOG(LogRTSHeightfield, Log, TEXT("高度场开始分帧构建: 区域 [%s], %d x %d 节点, 间距 %.1f"),
+		*Region->GetName(), grid.SampleCountX, grid.SampleCountY, effectiveCellSize);
+
+	this->BeginTrackingDynamicTerrain();
+}
+
+void URTSTerrainHeightfieldSubsystem::BeginTrackingDynamicTerrain()
+{
+	UWorld* world = this->GetWorld();
+	if (world == nullptr || this->ActorSpawnedHandle.IsValid())
+	{
+		return;
+	}
+
+	/// 登记场景中已有的动态地形，并监听之后生成的动态地形
+	TArray<AActor*> dynamicTerrainActors;
+	UGameplayStatics::GetAllActorsWithTag(world, DynamicTerrainTag, dynamicTerrainActors);
+	for (AActor* actor : dynamicTerrainActors)
+	{
+		this->RegisterDynamicTerrainActor(actor);
+	}
+
+	this->ActorSpawnedHandle = world->AddOnActorSpawnedHandler(
+		FOnActorSpawned::FDelegate::CreateUObject(this, &URTSTerrainHeightfieldSubsystem::HandleActorSpawned)
+	);
+}
+
+bool URTSTerrainHeightfieldSubsystem::IsHeightfieldValid(const AActor* Region) const
+{
+	const FRTSTerrainHeightGrid* grid = this->HeightGrids.Find(Region);
+	return grid != nullptr && grid->IsComplete();
+}
+
+bool URTSTerrainHeightfieldSubsystem::GetGroundHeightAt(const AActor* Region, const float X, const float Y, float& OutHeight) const
+{
+	const FRTSTerrainHeightGrid* grid = this->HeightGrids.Find(Region);
+	if (grid == nullptr || !grid->IsComplete())
+	{
+		return false;
+	}
+
+	/// 定位所在网格单元并计算单元内的插值权重
+	const float gridX = (X - grid->GridOrigin.X) * grid->InverseGridCellSize;
+	const float gridY = (Y - grid->GridOrigin.Y) * grid->InverseGridCellSize;
+	if (gridX < 0.0f || gridY < 0.0f || gridX > grid->SampleCountX - 1 || gridY > grid->SampleCountY - 1)
+	{
+		return false;
+	}
+
+	const int32 cellX = FMath::Min(FMath::FloorToInt(gridX), grid->SampleCountX - 2);
+	const int32 cellY = FMath::Min(FMath::FloorToInt(gridY), grid->SampleCountY - 2);
+	const float alphaX = gridX - cellX;
+	const float alphaY = gridY - cellY;
+
+	const int32 baseIndex = cellY * grid->SampleCountX + cellX;
+	const float height00 = grid->Heights[baseIndex];
+	const float height10 = grid->Heights[baseIndex + 1];
+	const float height01 = grid->Heights[baseIndex + grid->SampleCountX];
+	const float height11 = grid->Heights[baseIndex + grid->SampleCountX + 1];
+
+	/// 任一角点未命中地面时放弃插值，交由调用方回退到射线检测
+	if (height00 == InvalidHeight || height10 == InvalidHeight || height01 == InvalidHeight || height11 == InvalidHeight)
+	{
+		return false;
+	}
+
+	OutHeight = FMath::BiLerp(height00, height10, height01, height11, alphaX, alphaY);
+	return true;
+}
+
+void URTSTerrainHeightfieldSubsystem::MarkAreaDirty(const FBox2D& Area)
+{
+	if (!Area.bIsValid)
+	{
+		return;
+	}
+
+	for (auto& [region, grid] : this->HeightGrids)
+	{
+		if (grid.SampleCountX <= 0 || grid.SampleCountY <= 0)
+		{
+			continue;
+		}
+
+		/// 将范围外扩一个节点，保证双线性插值依赖的相邻节点同样被刷新
+		const int32 minX = FMath::Clamp(FMath::FloorToInt((Area.Min.X - grid.GridOrigin.X) * grid.InverseGridCellSize), 0, grid.SampleCountX - 1);
+		const int32 minY = FMath::Clamp(FMath::FloorToInt((Area.Min.Y - grid.GridOrigin.Y) * grid.InverseGridCellSize), 0, grid.SampleCountY - 1);
+		const int32 maxX = FMath::Clamp(FMath::CeilToInt((Area.Max.X - grid.GridOrigin.X) * grid.InverseGridCellSize), 0, grid.SampleCountX - 1);
+		const int32 maxY = FMath::Clamp(FMath::CeilToInt((Area.Max.Y - grid.GridOrigin.Y) * grid.InverseGridCellSize), 0, grid.SampleCountY - 1);
+
+		/// 尚未完成首次采样的节点会由分帧构建覆盖，无需入队
+		for (int32 y = minY; y <= maxY; ++y)
+		{
+			for (int32 x = minX; x <= maxX; ++x)
+			{
+				const int32 nodeIndex = y * grid.SampleCountX + x;
+				if (nodeIndex < grid.BuiltNodeCount && !grid.DirtyNodeFlags[nodeIndex])
+				{
+					grid.DirtyNodeFlags[nodeIndex] = true;
+					grid.DirtyNodeQueue.Add(nodeIndex);
+				}
+			}
+		}
+	}
+}
+
+void URTSTerrainHeightfieldSubsystem::Tick(const float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	/// 分帧构建与脏节点刷新分别使用各自的每帧预算，由所有区域网格共享；
+	/// 构建另受时间预算限制，每 16 条射线检查一次耗时
+	constexpr int32 buildTimeCheckInterval = 16;
+	const double buildDeadline = FPlatformTime::Seconds() + this->MaxBuildMillisecondsPerTick / 1000.0;
+	int32 buildBudget = this->MaxBuildSamplesPerTick;
+	int32 refreshBudget = this->MaxRefreshSamplesPerTick;
+	for (auto& [region, grid] : this->HeightGrids)
+	{
+		const int32 nodeCount = grid.SampleCountX * grid.SampleCountY;
+		if (buildBudget > 0 && grid.BuiltNodeCount < nodeCount)
+		{
+			const int32 buildStart = grid.BuiltNodeCount;
+			const int32 buildEnd = FMath::Min(buildStart + buildBudget, nodeCount);
+			while (grid.BuiltNodeCount < buildEnd)
+			{
+				this->SampleNode(grid, grid.BuiltNodeCount++);
+				if ((grid.BuiltNodeCount - buildStart) % buildTimeCheckInterval == 0 && FPlatformTime::Seconds() >= buildDeadline)
+				{
+					break;
+				}
+			}
+			buildBudget = grid.BuiltNodeCount < buildEnd ? 0 : buildBudget - (buildEnd - buildStart);
+			if (grid.IsComplete())
+			{
+				UE_LOG(LogRTSHeightfield, Log, TEXT("高度场构建完成: %d x %d 节点, 间距 %.1f"), grid.SampleCountX, grid.SampleCountY, grid.GridCellSize);
+			}
+		}
+
+		/// 按预算从队首消化脏节点，剩余部分留待后续帧
+		if (refreshBudget > 0 && grid.DirtyNodeQueue.Num() > 0)
+		{
+			const int32 refreshCount = FMath::Min(grid.DirtyNodeQueue.Num(), refreshBudget);
+			for (int32 i = 0; i < refreshCount; ++i)
+			{
+				const int32 nodeIndex = grid.DirtyNodeQueue[i];
+				grid.DirtyNodeFlags[nodeIndex] = false;
+				this->SampleNode(grid, nodeIndex);
+			}
+			grid.DirtyNodeQueue.RemoveAt(0, refreshCount, EAllowShrinking::No);
+			refreshBudget -= refreshCount;
+		}
+	}
+}
+
+void URTSTerrainHeightfieldSubsystem::RegisterDynamicTerrainActor(AActor* Actor)
+{
+	if (Actor == nullptr || this->TrackedDynamicFootprints.Contains(Actor))
+	{
+		return;
+	}
+
+	USceneComponent* rootComponent = Actor->GetRootComponent();
+	if (rootComponent == nullptr)
+	{
+		return;
+	}
+
+	this->TrackedDynamicFootprints.Add(Actor, CalculateActorFootprint(Actor));
+	rootComponent->TransformUpdated.AddUObject(this, &URTSTerrainHeightfieldSubsystem::HandleDynamicTerrainTransformUpdated);
+	Actor->OnDestroyed.AddDynamic(this, &URTSTerrainHeightfieldSubsystem::HandleDynamicTerrainDestroyed);
+}
+
+void URTSTerrainHeightfieldSubsystem::SampleNode(FRTSTerrainHeightGrid& Grid, const int32 NodeIndex) const
+{
+	const int32 x = NodeIndex % Grid.SampleCountX;
+	const int32 y = NodeIndex / Grid.SampleCountX;
+	const float worldX = Grid.GridOrigin.X + x * Grid.GridCellSize;
+	const float worldY = Grid.GridOrigin.Y + y * Grid.GridCellSize;
+
+	FHitResult floorHit;
+	FCollisionQueryParams queryParams(SCENE_QUERY_STAT(RTSTerrainHeightfieldSample), true);
+	const bool bValidFloor = this->GetWorld()->LineTraceSingleByChannel(
+		floorHit,
+		FVector(worldX, worldY, Grid.TraceStartZ),
+		FVector(worldX, worldY, Grid.TraceEndZ),
+		Grid.TraceChannel,
+		queryParams
+	);
+
+	Grid.Heights[NodeIndex] = bValidFloor ? floorHit.Location.Z : InvalidHeight;
+}
+
+void URTSTerrainHeightfieldSubsystem::HandleDynamicTerrainTransformUpdated(
+	USceneComponent* UpdatedComponent,
+	EUpdateTransformFlags,
+	ETeleportType
+)
+{
+	AActor* actor = UpdatedComponent ? UpdatedComponent->GetOwner() : nullptr;
+	FBox2D* lastFootprint = this->TrackedDynamicFootprints.Find(actor);
+	if (lastFootprint == nullptr)
+	{
+		return;
+	}
+
+	/// 旧位置与新位置都需要重采样：前者地面被移走，后者地面被覆盖
+	const FBox2D newFootprint = CalculateActorFootprint(actor);
+	this->MarkAreaDirty(*lastFootprint);
+	this->MarkAreaDirty(newFootprint);
+	*lastFootprint = newFootprint;
+}
+
+void URTSTerrainHeightfieldSubsystem::HandleDynamicTerrainDestroyed(AActor* DestroyedActor)
+{
+	FBox2D lastFootprint;
+	if (this->TrackedDynamicFootprints.RemoveAndCopyValue(DestroyedActor, lastFootprint))
+	{
+		this->MarkAreaDirty(lastFootprint);
+	}
+}
+
+void URTSTerrainHeightfieldSubsystem::HandleActorSpawned(AActor* SpawnedActor)
+{
+	if (SpawnedActor && SpawnedActor->ActorHasTag(DynamicTerrainTag))
+	{
+		this->RegisterDynamicTerrainActor(SpawnedActor);
+		this->MarkAreaDirty(CalculateActorFootprint(SpawnedActor));
+	}
+}
+
+FBox2D URTSTerrainHeightfieldSubsystem::CalculateActorFootprint(const AActor* Actor)
+{
+	FVector origin;
+	FVector extent;
+	Actor->GetActorBounds(true, origin, extent);
+	return FBox2D(FVector2D(origin.X - extent.X, origin.Y - extent.Y), FVector2D(origin.X + extent.X, origin.Y + extent.Y));
+}
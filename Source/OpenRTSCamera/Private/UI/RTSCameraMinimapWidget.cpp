@@ -63,6 +63,8 @@ void URTSCameraMinimapWidget::findRTSCamera()
 		/// 绑定视野更新委托：由相机的“主动推送”驱动 UI 的“局部失效”
 		this->cachedRTSCamera->onMinimapFrustumUpdated.RemoveAll(this);
 		this->cachedRTSCamera->onMinimapFrustumUpdated.AddUObject(this, &URTSCameraMinimapWidget::handleMinimapFrustumUpdated);
+		this->cachedRTSCamera->onMovementBoundaryChanged.RemoveAll(this);
+		this->cachedRTSCamera->onMovementBoundaryChanged.AddUObject(this, &URTSCameraMinimapWidget::handleMovementBoundaryChanged);
 
 		AActor* cameraOwner = this->cachedRTSCamera->GetOwner();
 		if (cameraOwner)
@@ -93,10 +95,22 @@ void URTSCameraMinimapWidget::findRTSCamera()
 	}
 }
 
+void URTSCameraMinimapWidget::handleMovementBoundaryChanged()
+{
+	/// 相机切换到另一个区域：下一次绘制时重新同步地图边界
+	this->bHasValidBounds = false;
+	this->Invalidate(EInvalidateWidgetReason::Paint);
+}
+
 void URTSCameraMinimapWidget::handleMinimapFrustumUpdated()
 {
 	/// 响应式重绘核心：仅在相机通过委托告知数据变动时，才标记 Slate 渲染层失效。
 	/// 开发提示：配合 Invalidation Box 使用，可使本控件在静止状态下完全忽略 NativePaint 开销。
+	if (this->lastInvalidatedFrame == GFrameCounter)
+	{
+		return;
+	}
+	this->lastInvalidatedFrame = GFrameCounter;
 	this->Invalidate(EInvalidateWidgetReason::Paint);
 }
 
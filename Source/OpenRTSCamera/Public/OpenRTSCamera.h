@@ -13,3 +13,5 @@ public:
 };
 
 DECLARE_LOG_CATEGORY_EXTERN(LogOpenRTSCamera, Log, All);
+
+DECLARE_STATS_GROUP(TEXT("OpenRTSCamera"), STATGROUP_OpenRTSCamera, STATCAT_Advanced);
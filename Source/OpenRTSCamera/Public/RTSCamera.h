@@ -7,11 +7,25 @@
 #include "Camera/CameraComponent.h"
 #include "Components/ActorComponent.h"
 #include "GameFramework/SpringArmComponent.h"
+#include "RTSCameraBoundarySolver.h"
+#include "RTSCameraFrustumQuery.h"
+#include "RTSCameraReplayBuffer.h"
+#include "RTSCameraSnapshot.h"
+#include "WorldCollision.h"
+#include "WorldPartition/WorldPartitionStreamingSource.h"
 #include "RTSCamera.generated.h"
 
+class FRTSCameraInputPreprocessor;
+class URTSCameraManagerSubsystem;
+class FViewport;
+class UCurveFloat;
+
 /** @brief 视野框数据更新时的多播委托声明 */
 DECLARE_MULTICAST_DELEGATE(FOnMinimapFrustumUpdated);
 
+/** @brief 相机切换到另一个活动区域时的多播委托声明 */
+DECLARE_MULTICAST_DELEGATE(FOnMovementBoundaryChanged);
+
 /**
  * @brief       封装相机平移请求的指令结构
  **/
@@ -39,10 +53,13 @@ struct FMoveCameraCommand
  * 组件遵循“战略由人，战术由AI”的设计原则，旨在平衡操作的顺滑感与 UI 的即时反馈。
  **/
 UCLASS(Blueprintable, ClassGroup=(Custom), meta=(BlueprintSpawnableComponent))
-class OPENRTSCAMERA_API URTSCamera : public UActorComponent
+class OPENRTSCAMERA_API URTSCamera : public UActorComponent, public IWorldPartitionStreamingSourceProvider
 {
 	GENERATED_BODY()
 
+	/// 批量更新时由管理器读取与写回各阶段的状态
+	friend class URTSCameraManagerSubsystem;
+
 public:
 	/**
 	 * @brief       初始化相机组件的默认属性与子对象引用
@@ -90,13 +107,83 @@ public:
 	void setActiveCamera();
 	
 	/**
-	 * @brief       将相机组件瞬間移动至指定的 X/Y 地面坐标
+	 * @brief       将相机组件瞬間移动至指定的 X/Y 地面坐标。
+	 *              目标仅被暂存，实际变换与视野广播在本帧 Tick 末尾统一提交。
 	 * 
 	 * @param       参数名称: position                       数据类型:        FVector
 	 **/
 	UFUNCTION(BlueprintCallable, Category = "RTSCamera")
 	void jumpTo(FVector position);
 
+	/**
+	 * @brief       在指定地面坐标登记一个最高优先级的流送源，保持一段时间后自动撤销。
+	 *              用于相机即将抵达但尚未抵达的位置（跳转、过场镜头的落点等）。
+	 *
+	 * @param       参数名称: position                       数据类型:        FVector
+	 * @param       参数名称: holdSeconds                    数据类型:        float  小于等于零时使用 jumpStreamingHoldSeconds
+	 **/
+	UFUNCTION(BlueprintCallable, Category = "RTSCamera|Streaming")
+	void requestStreamingPrefetch(FVector position, float holdSeconds = 0.0f);
+
+	/**
+	 * @brief       从若干秒前的记录开始回放相机（击杀回放、“刚才在看哪里”等）。回放期间玩家输入与跟随被忽略，也不再记录新的采样。
+	 *
+	 * @param       参数名称: secondsAgo                     数据类型:        float  相对当前世界时间，超出记录范围时钳制到最早的记录
+	 * @param       参数名称: playbackRate                   数据类型:        float  回放速率，0 表示暂停在该时刻；正向回放到达最新记录时自动结束
+	 * @return      返回值类型:      bool  尚无任何记录时为 false
+	 **/
+	UFUNCTION(BlueprintCallable, Category = "RTSCamera|Replay")
+	bool startReplay(float secondsAgo, float playbackRate = 1.0f);
+
+	/**
+	 * @brief       将回放定位到若干秒前；未在回放时以暂停状态开始回放
+	 *
+	 * @param       参数名称: secondsAgo                     数据类型:        float
+	 **/
+	UFUNCTION(BlueprintCallable, Category = "RTSCamera|Replay")
+	void scrubReplay(float secondsAgo);
+
+	/**
+	 * @brief       修改回放速率
+	 *
+	 * @param       参数名称: playbackRate                   数据类型:        float
+	 **/
+	UFUNCTION(BlueprintCallable, Category = "RTSCamera|Replay")
+	void setReplayPlaybackRate(float playbackRate);
+
+	/**
+	 * @brief       结束回放，相机回到开始回放时的状态
+	 **/
+	UFUNCTION(BlueprintCallable, Category = "RTSCamera|Replay")
+	void stopReplay();
+
+	UFUNCTION(BlueprintPure, Category = "RTSCamera|Replay")
+	bool isReplaying() const { return this->bIsReplaying; }
+
+	/**
+	 * @brief       回放当前时刻记录中正在跟随的目标（击杀回放标注焦点单位等）
+	 *
+	 * @return      返回值类型:      AActor*  未在回放、当时未跟随或目标已销毁时为空
+	 **/
+	UFUNCTION(BlueprintPure, Category = "RTSCamera|Replay")
+	AActor* getReplayFollowTarget() const { return this->replayFollowTarget.Get(); }
+
+	/**
+	 * @brief       已记录的时长（秒）
+	 *
+	 * @return      返回值类型:      float
+	 **/
+	UFUNCTION(BlueprintPure, Category = "RTSCamera|Replay")
+	float getRecordedReplaySeconds() const;
+
+	/** @brief 回放记录，可直接按世界时间查询任意时刻的相机状态 */
+	const FRTSCameraReplayBuffer& getReplayBuffer() const { return this->replayBuffer; }
+
+	//~ Begin IWorldPartitionStreamingSourceProvider Interface
+	virtual bool GetStreamingSources(TArray<FWorldPartitionStreamingSource>& OutStreamingSources) const override;
+	virtual const UObject* GetStreamingSourceOwner() const override { return this; }
+	//~ End IWorldPartitionStreamingSourceProvider Interface
+
 	/**
 	 * @brief       获取当前用于相机移动约束的边界体积引用
 	 * 
@@ -190,6 +277,66 @@ public:
 	)
 	float findGroundTraceLength;
 
+	/// 启用地形高度场缓存：每个边界区域分帧采样一次，构建完成后的高度校正不再进行逐帧射线检测
+	UPROPERTY(
+		BlueprintReadWrite,
+		EditAnywhere,
+		Category = "RTSCamera - Dynamic Camera Height Settings",
+		meta = (EditCondition = "enableDynamicCameraHeight", DisplayName = "启用高度场缓存")
+	)
+	bool enableTerrainHeightCache;
+
+	/// 高度场缓存的采样间距（虚幻单位）
+	UPROPERTY(
+		BlueprintReadWrite,
+		EditAnywhere,
+		Category = "RTSCamera - Dynamic Camera Height Settings",
+		meta = (ClampMin = "10.0", EditCondition = "enableDynamicCameraHeight && enableTerrainHeightCache", DisplayName = "高度场采样间距")
+	)
+	float terrainHeightCacheCellSize;
+
+	/// 启用异步地面探针：根坐标、视野四角与跟随目标的地面探测合并为一批异步射线，结果在下一帧平滑消费
+	UPROPERTY(
+		BlueprintReadWrite,
+		EditAnywhere,
+		Category = "RTSCamera - Dynamic Camera Height Settings",
+		meta = (EditCondition = "enableDynamicCameraHeight", DisplayName = "启用异步地面探针", ToolTip = "游戏线程不再同步等待物理场景查询。")
+	)
+	bool enableAsyncGroundProbes;
+
+	/// 异步探针结果的高度平滑速度（0 表示直接采用）
+	UPROPERTY(
+		BlueprintReadWrite,
+		EditAnywhere,
+		Category = "RTSCamera - Dynamic Camera Height Settings",
+		meta = (ClampMin = "0.0", EditCondition = "enableDynamicCameraHeight && enableAsyncGroundProbes", DisplayName = "异步高度平滑速度")
+	)
+	float asyncGroundHeightSmoothingSpeed;
+
+	/// 启用地形避让：沿弹簧臂在高度场上取若干采样点，相机将要穿入地形时平滑抬升整条弹簧臂（不使用物理扫掠）
+	UPROPERTY(
+		BlueprintReadWrite,
+		EditAnywhere,
+		Category = "RTSCamera - Dynamic Camera Height Settings",
+		meta = (EditCondition = "enableDynamicCameraHeight && enableTerrainHeightCache", DisplayName = "启用地形避让", ToolTip = "低空缩放时避免相机穿入山崖与高地，依赖高度场缓存。")
+	)
+	bool enableTerrainArmAvoidance;
+
+	/// 弹簧臂与地形之间保持的最小垂直间隙（UU）
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "RTSCamera - Dynamic Camera Height Settings", meta = (ClampMin = "0.0", EditCondition = "enableTerrainArmAvoidance", DisplayName = "地形避让间隙"))
+	float terrainArmClearance;
+
+	/// 沿弹簧臂的采样点数量（最后一个采样点位于相机处）
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "RTSCamera - Dynamic Camera Height Settings", meta = (ClampMin = "1", ClampMax = "8", EditCondition = "enableTerrainArmAvoidance", DisplayName = "地形避让采样数"))
+	int32 terrainArmSampleCount;
+
+	/// 抬升与回落的平滑速度；抬升应明显快于回落，避免相机短暂穿入地形
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "RTSCamera - Dynamic Camera Height Settings", meta = (ClampMin = "0.0", EditCondition = "enableTerrainArmAvoidance", DisplayName = "地形避让抬升速度"))
+	float terrainArmRaiseSpeed;
+
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "RTSCamera - Dynamic Camera Height Settings", meta = (ClampMin = "0.0", EditCondition = "enableTerrainArmAvoidance", DisplayName = "地形避让回落速度"))
+	float terrainArmLowerSpeed;
+
 	/// 启用鼠标触发视口边缘后的相机滚动
 	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "RTSCamera - Edge Scroll Settings")
 	bool enableEdgeScrolling;
@@ -203,6 +350,156 @@ public:
 	)
 	float distanceFromEdgeThreshold;
 
+	/// 角落处两个边缘同时生效时，将合成推力限制在单轴推力的长度内
+	UPROPERTY(
+		BlueprintReadWrite,
+		EditAnywhere,
+		Category = "RTSCamera - Edge Scroll Settings",
+		meta = (EditCondition = "enableEdgeScrolling", DisplayName = "对角线归一化")
+	)
+	bool normalizeDiagonalEdgeScroll;
+
+	/// 可选响应曲线：将边缘侵入深度 [0, 1] 映射为推力强度
+	UPROPERTY(
+		BlueprintReadWrite,
+		EditAnywhere,
+		Category = "RTSCamera - Edge Scroll Settings",
+		meta = (EditCondition = "enableEdgeScrolling", DisplayName = "边缘响应曲线")
+	)
+	UCurveFloat* edgeScrollResponseCurve;
+
+	/// 可选加速曲线：将光标在边缘停留的秒数映射为速度倍率
+	UPROPERTY(
+		BlueprintReadWrite,
+		EditAnywhere,
+		Category = "RTSCamera - Edge Scroll Settings",
+		meta = (EditCondition = "enableEdgeScrolling", DisplayName = "边缘加速曲线")
+	)
+	UCurveFloat* edgeScrollAccelerationCurve;
+
+	/// 启用空闲休眠：相机完全静止时关闭自身 Tick，由输入、跳转、跟随或光标进入边缘区域唤醒
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "RTSCamera - Performance", meta = (DisplayName = "启用空闲休眠", ToolTip = "相机静止时关闭 Tick，稳态开销接近零。"))
+	bool enableIdleTickSleep;
+
+	/// 休眠期间检测光标是否进入边缘滚动区域的轮询间隔（秒）
+	UPROPERTY(
+		BlueprintReadWrite,
+		EditAnywhere,
+		Category = "RTSCamera - Performance",
+		meta = (ClampMin = "0.01", EditCondition = "enableIdleTickSleep", DisplayName = "休眠边缘探测间隔", ToolTip = "休眠时轮询光标位置的间隔，仅在启用边缘滚动时生效。")
+	)
+	float idleEdgeScrollProbeInterval;
+
+	/// 无人观看时探测本相机是否重新成为视角目标的轮询间隔（秒）
+	UPROPERTY(
+		BlueprintReadWrite,
+		EditAnywhere,
+		Category = "RTSCamera - Performance",
+		meta = (ClampMin = "0.01", DisplayName = "视角目标探测间隔", ToolTip = "相机不再是任何本地玩家的视角目标时进入休眠，按此间隔检查是否被重新观看。")
+	)
+	float viewTargetProbeInterval;
+
+	/// 不是视角目标时仍逐帧更新：用于通过场景捕获渲染的画中画相机，此类相机不响应边缘滚动，也不发布主快照
+	UPROPERTY(
+		BlueprintReadWrite,
+		EditAnywhere,
+		Category = "RTSCamera - Performance",
+		meta = (DisplayName = "画中画更新", ToolTip = "画中画等不作为玩家视角目标的相机勾选此项，否则无人观看时会进入休眠。")
+	)
+	bool updateWithoutViewTarget;
+
+	/// 判定缩放已收敛的弹簧臂长度容差
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "RTSCamera - Performance", meta = (ClampMin = "0.0", EditCondition = "enableIdleTickSleep", DisplayName = "缩放收敛容差"))
+	float idleZoomConvergenceTolerance;
+
+	/// 視野框任一角点移动超过该距离（UU）时才广播更新
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "RTSCamera - Performance", meta = (ClampMin = "0.0", DisplayName = "視野框广播容差", ToolTip = "四个角点的位移均小于该值时跳过本次广播，订阅者不会收到重绘请求。"))
+	float minimapFrustumBroadcastTolerance;
+
+	/// 启用延迟更新：相机 Tick 移至 TG_LastDemotable，在视图计算前的最后时刻采样拖拽/边缘滚动并提交变换
+	UPROPERTY(
+		BlueprintReadWrite,
+		EditAnywhere,
+		Category = "RTSCamera - Performance",
+		meta = (DisplayName = "启用延迟更新", ToolTip = "拖拽与边缘滚动输入在同一帧内反映到画面上，减少一帧平移延迟。需在 BeginPlay 前设置。")
+	)
+	bool enableLateUpdate;
+
+	/// 启用原始输入采样：通过 Slate 输入预处理器记录两次 Tick 之间最新的光标事件，拖拽与边缘滚动使用该位置
+	UPROPERTY(
+		BlueprintReadWrite,
+		EditAnywhere,
+		Category = "RTSCamera - Performance",
+		meta = (DisplayName = "启用原始输入采样", ToolTip = "拖拽与边缘滚动直接使用输入路径上最新的光标事件，改变默认的光标采样方式，默认关闭。需在 BeginPlay 前设置。")
+	)
+	bool enableRawInputAccumulation;
+
+	/// 启用预测流送：相机作为 World Partition 流送源，上报当前视野、按平移速度外推的视野以及跳转目标
+	UPROPERTY(
+		BlueprintReadWrite,
+		EditAnywhere,
+		Category = "RTSCamera - Streaming",
+		meta = (DisplayName = "启用预测流送", ToolTip = "快速边缘滚动与小地图跳转前提前加载目标区域，减少卡顿与物体突现。仅对 World Partition 地图生效，需在 BeginPlay 前设置。")
+	)
+	bool enablePredictiveStreaming;
+
+	/// 按平移速度外推视野的前瞻时长（秒）
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "RTSCamera - Streaming", meta = (ClampMin = "0.0", EditCondition = "enablePredictiveStreaming", DisplayName = "流送前瞻时长"))
+	float streamingLookaheadSeconds;
+
+	/// 跳转目标流送源的保持时长（秒）
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "RTSCamera - Streaming", meta = (ClampMin = "0.0", EditCondition = "enablePredictiveStreaming", DisplayName = "跳转流送保持时长"))
+	float jumpStreamingHoldSeconds;
+
+	/// 单个流送源的最大半径（UU），避免视野接近地平线时角点被推到极远处
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "RTSCamera - Streaming", meta = (ClampMin = "0.0", EditCondition = "enablePredictiveStreaming", DisplayName = "流送源最大半径"))
+	float maxStreamingSourceRadius;
+
+	/// 启用回放记录：每次提交变换后把相机状态写入定长环形缓冲，供回放与查询使用
+	UPROPERTY(
+		BlueprintReadWrite,
+		EditAnywhere,
+		Category = "RTSCamera - Replay",
+		meta = (DisplayName = "启用回放记录", ToolTip = "记录根坐标、偏航角、臂长、SocketOffset 与跟随目标。需在 BeginPlay 前设置。")
+	)
+	bool enableReplayRecording;
+
+	/// 回放缓冲的容量（KB），默认容量在 60 帧下可保存十分钟以上的记录
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "RTSCamera - Replay", meta = (ClampMin = "16", EditCondition = "enableReplayRecording", DisplayName = "回放缓冲容量 (KB)"))
+	int32 replayBufferKilobytes;
+
+	/// 启用批量更新：交由相机管理器子系统与同一世界中的其他 RTS 相机一起推进，纯数学阶段按结构数组批量求解
+	UPROPERTY(
+		BlueprintReadWrite,
+		EditAnywhere,
+		Category = "RTSCamera - Performance",
+		meta = (DisplayName = "启用批量更新", ToolTip = "分屏、画中画与观战等多相机场景下，新增相机的边际开销显著降低。需在 BeginPlay 前设置。")
+	)
+	bool enableBatchedUpdate;
+
+	/// 启用固定步长模拟：平移、边缘滚动与缩放按固定频率积分，渲染在最近两个模拟状态之间插值
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "RTSCamera - Simulation", meta = (DisplayName = "启用固定步长模拟", ToolTip = "相机手感不再随帧率变化，卡顿后的追帧开销有上限。"))
+	bool enableFixedTimestepSimulation;
+
+	/// 固定步长模拟的频率（Hz）
+	UPROPERTY(
+		BlueprintReadWrite,
+		EditAnywhere,
+		Category = "RTSCamera - Simulation",
+		meta = (ClampMin = "1.0", EditCondition = "enableFixedTimestepSimulation", DisplayName = "模拟频率", ToolTip = "低端设备可降低该值，显示仍通过插值保持平滑。")
+	)
+	float fixedSimulationRate;
+
+	/// 单帧内允许执行的最大模拟步数，超出部分的时间被丢弃
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "RTSCamera - Simulation", meta = (ClampMin = "1", EditCondition = "enableFixedTimestepSimulation", DisplayName = "单帧最大子步数"))
+	int32 maxSimulationSubSteps;
+
+	/**
+	 * @brief       唤醒处于空闲休眠中的相机 Tick。重复调用无额外开销。
+	 **/
+	UFUNCTION(BlueprintCallable, Category = "RTSCamera")
+	void wakeCameraTick();
+
 	/// 相机对应的增强输入上下文
 	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "RTSCamera - Inputs")
 	UInputMappingContext* inputMappingContext;
@@ -238,12 +535,22 @@ public:
 	/// 委托实例：当视野投影点数组被成功更新后触发
 	FOnMinimapFrustumUpdated onMinimapFrustumUpdated;
 
+	/// 委托实例：当相机的活动区域发生切换后触发
+	FOnMovementBoundaryChanged onMovementBoundaryChanged;
+
 protected:
 	/**
 	 * @brief       生命周期起始点：建立组件依赖与输入绑定
 	 **/
 	virtual void BeginPlay() override;
 
+	/**
+	 * @brief       生命周期终点：解除视口事件订阅与休眠定时器
+	 * 
+	 * @param       参数名称: EndPlayReason                 数据类型:        EEndPlayReason::Type
+	 **/
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
 	/**
 	 * @brief       响应增强输入事件。执行缩放并标记視野更新。
 	 * 
@@ -303,10 +610,55 @@ protected:
 	void requestCameraMovement(float xAxisValue, float yAxisValue, float movementScale);
 
 	/**
-	 * @brief       在一个逻辑帧内，分步执行指令队列中积压的所有平移指令
+	 * @brief       在一个逻辑帧内，将指令队列中积压的所有平移指令累加到暂存目标位置
 	 **/
 	void applyAccumulatedMovementCommands();
 
+	/**
+	 * @brief       将本帧挂起的平移指令折算为平面速度
+	 *
+	 * @return      返回值类型:      FVector2D  单位：厘米/秒
+	 **/
+	FVector2D resolveMovementCommandVelocity() const;
+
+	/**
+	 * @brief       以 deltaSeconds 积分平面速度，累加到暂存目标上
+	 *
+	 * @param       参数名称: planarVelocity                数据类型:        const FVector2D&
+	 **/
+	void applyPlanarMovementVelocity(const FVector2D& planarVelocity);
+
+	/**
+	 * @brief       获取本帧的暂存根坐标。首次调用时从根组件同步起点。
+	 * 
+	 * @return      返回值类型:      FVector&
+	 **/
+	FVector& acquireStagedRootLocation();
+
+	/**
+	 * @brief       运动提交阶段：对暂存坐标执行一次地形校正、边界约束与 SocketOffset 更新，
+	 *              写回世界变换，并按需广播一次视野更新。每帧仅在 Tick 末尾调用一次。
+	 **/
+	void commitStagedCameraMotion();
+
+	/**
+	 * @brief       推进本帧的输入与运动阶段，直到提交之前
+	 *
+	 * @param       参数名称: frameDeltaSeconds             数据类型:        float
+	 * @param       参数名称: bDeferArmLengthInterpolation  数据类型:        bool  为 true 时缩放插值留给管理器批量求解
+	 * @return      返回值类型:      bool  相机本帧不需要更新（专用服务器、未被本地玩家观看）时为 false
+	 **/
+	bool advanceCameraFrame(float frameDeltaSeconds, bool bDeferArmLengthInterpolation);
+
+	/** @brief 提交前半段：取得暂存坐标并完成探针读取、区域查询与地形校正，返回待约束的根坐标 */
+	FVector stageCommitLocation();
+
+	/** @brief 提交后半段：写回世界变换，按需广播视野框并提交探针；角点可由调用方预先求出 */
+	void finishStagedCommit(const FVector& committedLocation, const FVector* precomputedFrustumPoints);
+
+	/** @brief 帧末收尾：记录渲染状态、清除本帧输入并判断是否进入空闲休眠 */
+	void finishCameraFrame();
+
 	/// 组件所属的 Actor 引用，定义了相机的生命周期主体
 	UPROPERTY()
 	AActor* cameraOwner;
@@ -337,37 +689,138 @@ protected:
 
 private:
 	void resolveComponentDependencyPointers();
+
+	/** @brief 解析观看本相机的玩家控制器：拥有者的控制器优先，其次为以拥有者为视角目标的本地控制器 */
+	APlayerController* resolveOwningPlayerController() const;
+
+	/** @brief 相机是否正被缓存的本地玩家控制器观看 */
+	bool isViewedByLocalPlayer() const;
+
+	/** @brief 本帧是否需要推进：被观看，或为画中画相机 */
+	bool shouldAdvanceCameraFrame() const;
+
+	/** @brief 无人观看时进入休眠，并启动低频视角目标探测 */
+	void enterUnviewedSleep();
+
+	/** @brief 休眠期间的低频回调：重新解析控制器，重新被观看时唤醒相机 */
+	void probeViewTargetWhileUnviewed();
+
+	/** @brief 启用批量更新时登记到相机管理器并关闭自身 Tick */
+	void registerWithCameraManager();
 	void setupInitialSpringArmState();
 
-	void locateMapBoundaryVolumeByTag();
+	void configureLateUpdateTick();
+	void locateMovementBoundaryRegion();
+	void buildTerrainHeightCache();
+
+	/** @brief 输出当前区域下的边界溢出诊断信息 */
+	void logBoundaryDiagnostics(float mapOverflowDistance);
+
+	/** @brief 查询包含给定坐标的活动区域并同步到边界求解器，请求该区域的高度场，区域切换时广播 */
+	void resolveMovementBoundaryRegion(const FVector2D& location);
+
+	/** @brief 存在待处理的区域查询请求时，以当前暂存坐标执行一次查询 */
+	void resolvePendingRegionLookup();
+
+	/** @brief 区域注册表变化回调 */
+	void handleCameraRegionsChanged();
 	void configureInputModeForEdgeScrolling();
 	void validateEnhancedInputAvailability();
 	void registerInputMappingContext();
 	void bindActionCallbacks();
 
 	void executeEdgeScrollingEvaluation();
-	void performEdgeScrollLeft();
-	void performEdgeScrollRight();
-	void performEdgeScrollUp();
-	void performEdgeScrollDown();
+
+	/** @brief 读取当前光标位置，将拖拽偏移转换为运动指令 */
+	void sampleDragMovement();
+
+	/** @brief 拖拽是否改在 Tick 中采样（延迟更新或原始输入累积模式） */
+	bool shouldSampleDragInTick() const;
+
+	/** @brief 注册与注销 Slate 输入预处理器 */
+	void registerInputPreprocessor();
+	void unregisterInputPreprocessor();
+
+	/** @brief 每帧一次读取预处理器记录的最新光标位置，换算为视口像素坐标供本帧所有光标采样复用 */
+	void drainRawPointerInput();
+
+	/** @brief 在唤醒或开始拖拽时重置预处理器的采样窗口 */
+	void resetRawPointerInput();
+
+	/** @brief 记录本帧最早一次输入采样的时间，用于统计输入到提交的延迟 */
+	void markInputSampled();
+
+	/** @brief 由光标位置一次性求出合成的边缘推力（X 为右向，Y 为前向） */
+	FVector2D calculateEdgeScrollPush(const FVector2D& cursorPosition) const;
+
+	/** @brief 读取一次视口像素空间下的光标位置 */
+	bool sampleCursorInViewport(FVector2D& outCursorPosition) const;
+
+	/** @brief 从游戏视口读取像素尺寸写入缓存 */
+	void refreshCachedViewportSize();
+
+	/** @brief 视口尺寸变化事件回调 */
+	void handleViewportResized(FViewport* viewport, uint32 unused);
+
+	/** @brief 判断相机本帧是否已完全静止，可以进入休眠 */
+	bool isCameraMotionIdle();
+
+	/** @brief 关闭 Tick 并在需要时启动低频边缘区域探测 */
+	void enterIdleTickSleep();
+
+	/** @brief 休眠期间的低频回调：光标进入边缘区域时唤醒相机 */
+	void probeEdgeScrollZoneWhileIdle();
+
+	/** @brief 判断光标当前是否位于任一边缘滚动区域内 */
+	bool isCursorInsideEdgeScrollZone() const;
 
 	void updateFollowPositionIfTargetActive();
 	void handleTargetArmLengthInterpolation();
-	void rectifyRootHeightFromTerrain();
+
+	/** @brief 按固定步长推进模拟状态，并将插值后的渲染状态写入暂存值与弹簧臂 */
+	void runFixedTimestepSimulation(float frameDeltaSeconds);
+	void rectifyRootHeightFromTerrain(FVector& rootLocation);
+
+	/** @brief 同步射线探测地面高度，并记录单次射线耗时供统计使用 */
+	bool traceGroundHeightSynchronously(const FVector& probeLocation, float& outGroundHeight);
+
+	/** @brief 读取上一帧提交的异步探针批次结果 */
+	void consumeAsyncGroundProbes();
+
+	/** @brief 以最终变换为基准提交本帧的异步探针批次 */
+	void submitAsyncGroundProbes();
 	
-	/** @brief 计算当前坐标下的边界补偿并应用 */
-	void applyBoundaryConstraints();
+	/** @brief 计算暂存坐标下的边界补偿并就地修正该坐标 */
+	void applyBoundaryConstraints(FVector& rootLocation);
+
+	/** @brief 记录并写入弹簧臂的边界 SocketOffset */
+	void applyBoundarySocketOffset(const FVector2D& socketOffset);
 
-	/** @brief 基于 Y 坐标计算 Lateral Socket Offset */
-	float calculateYOffset(float worldY) const;
+	/** @brief 将当前 FOV、俯仰角、长宽比与约束参数同步到求解器，仅在变化时触发重算 */
+	void refreshBoundarySolverProjection();
 
-	/** @brief 基于 X 坐标计算 Vertical Socket Offset */
-	float calculateXOffset(float worldX) const;
+	/// 批量推进本相机的管理器；为空时相机在自身 Tick 中更新
+	UPROPERTY()
+	URTSCameraManagerSubsystem* cameraManager;
+
+	/// 地形高度场子系统，按当前边界区域查询其网格；未启用时为空
+	UPROPERTY()
+	class URTSTerrainHeightfieldSubsystem* terrainHeightfield;
 
 	/// 相机当前正在锁定跟随的 Actor 实测对象
 	UPROPERTY()
 	AActor* activeCameraFollowTarget;
 
+	/** @brief 沿弹簧臂采样高度场，求出避让所需的抬升量并平滑写入 TargetOffset.Z */
+	void updateTerrainArmAvoidance();
+
+	/// 弹簧臂 TargetOffset.Z 的原始值，地形避让的抬升量叠加在其上
+	float terrainAvoidanceBaseOffsetZ;
+
+	/// 地形避让的目标抬升量与当前（平滑后的）抬升量
+	float terrainAvoidanceTargetLift;
+	float terrainAvoidanceLift;
+
 	/// 缓存边界侧移量 (SocketOffset.Y)
 	float currentLateralSocketOffset;
 	/// 缓存边界纵移量 (SocketOffset.X)
@@ -376,14 +829,18 @@ private:
 	UPROPERTY()
 	float deltaSeconds;
 
-	/** @brief 预计算的横向延伸系数 (Lateral Reach / TargetArmLength) */
-	float lateralReachFactor;
+	/// 边界求解器：缓存区域数据与延伸系数，逐帧只做闭式偏移与钳制
+	FRTSCameraBoundarySolver boundarySolver;
 
-	/** @brief 预计算的纵向延伸系数 (Forward Reach / TargetArmLength) */
-	float forwardReachFactor;
+	/// 相机区域注册表
+	UPROPERTY()
+	class URTSCameraRegionSubsystem* regionSubsystem;
 
-	/** @brief 预计算的后向延伸系数 (Backward Reach / TargetArmLength) */
-	float backwardReachFactor;
+	/// 区域注册表变化的委托句柄
+	FDelegateHandle regionsChangedHandle;
+
+	/// 状态位：跳转或区域变化后需要重新查询活动区域
+	bool bRegionLookupRequested;
 
 	/// 状态位：指示是否正在进行鼠标拖拽操作
 	UPROPERTY()
@@ -401,15 +858,216 @@ private:
 	UPROPERTY()
 	float currentMovementSpeed;
 
+	/// 本帧暂存的相机根目标位置。输入、边缘滚动、跟随与跳转只修改此值，由提交阶段统一写回
+	FVector stagedRootLocation;
+
+	/// 状态位：暂存目标是否已在本帧从根组件同步
+	bool bHasStagedRootLocation;
+
+	/// 状态位：本帧提交阶段是否需要重新投射视野框
+	bool bMinimapFrustumRefreshRequested;
+
+	/// 最近一次广播时的視野框角点，用于判断位移是否超过广播容差
+	FVector broadcastMinimapFrustumPoints[4];
+
+	/// 状态位：是否已经广播过至少一次視野框
+	bool bHasBroadcastMinimapFrustum;
+
+	/// 最近一次广播所在的帧号，保证订阅者每帧至多收到一次通知
+	uint64 lastMinimapFrustumBroadcastFrame;
+
+	/// 状态位：本帧边缘滚动是否产生了推力
+	bool bEdgeScrollActiveThisTick;
+
+	/// 本帧最早一次输入采样的时间戳（秒），为 0 表示自上次提交以来没有新输入
+	double earliestPendingInputSeconds;
+
+	/// 已注册到 Slate 的输入预处理器
+	TSharedPtr<FRTSCameraInputPreprocessor> inputPreprocessor;
+
+	/// 本帧由原始输入换算出的视口光标位置（最近一次事件）
+	FVector2D drainedCursorPosition;
+
+	/// 状态位：本帧 Tick 内是否持有有效的原始输入光标位置
+	bool bHasDrainedCursorPosition;
+
+	/// 固定步长模拟中尚未消化的时间（秒）
+	float simulationTimeAccumulator;
+
+	/// 上一个与当前模拟步的根平面坐标，渲染在二者之间插值
+	FVector2D previousSimulatedPlanarLocation;
+	FVector2D currentSimulatedPlanarLocation;
+
+	/// 上一个与当前模拟步的弹簧臂长度
+	float previousSimulatedArmLength;
+	float currentSimulatedArmLength;
+
+	/// 上一帧提交的根平面坐标，用于识别外部对 Actor 的直接移动
+	FVector2D simulationRenderedPlanarLocation;
+
+	/// 状态位：模拟状态是否已从当前变换初始化
+	bool bSimulationStateInitialized;
+
+	/// 状态位：跳转请求需要让前后两个模拟状态同时瞬移，跳过插值
+	bool bSimulationTeleportPending;
+
+	/// 状态位：相机当前是否处于空闲休眠
+	bool bIsTickSleeping;
+
+	/// 休眠期间边缘区域探测的定时器句柄
+	FTimerHandle idleEdgeScrollProbeTimerHandle;
+
+	/// 无人观看期间视角目标探测的定时器句柄
+	FTimerHandle viewTargetProbeTimerHandle;
+
+	/// 游戏视口的像素尺寸缓存，仅在初始化与尺寸变化事件中刷新
+	FVector2D cachedViewportSize;
+
+	/// 视口尺寸变化事件的订阅句柄
+	FDelegateHandle viewportResizedHandle;
+
+	/// 光标连续停留在边缘区域的时长（秒），驱动加速曲线
+	float edgeScrollDwellSeconds;
+
+	/// 异步探针批次的槽位数量：[0]根坐标, [1-4]视野四角, [5]跟随目标
+	static constexpr int32 asyncGroundProbeCount = 6;
+
+	/// 已提交、待下一帧读取的异步探针句柄
+	FTraceHandle asyncGroundProbeHandles[asyncGroundProbeCount];
+
+	/// 最近一次成功返回的探针地面高度
+	float asyncGroundProbeHeights[asyncGroundProbeCount];
+
+	/// 各探针槽位当前是否持有有效高度
+	bool asyncGroundProbeValid[asyncGroundProbeCount];
+
+	/// 同步地面射线的平均耗时（秒），用于估算异步模式节省的时间；
+	/// 只在异步结果尚不可用、回退到同步射线时更新，异步模式本身从不为统计而等待射线
+	double averageSyncGroundTraceSeconds;
+
 public:
 	/// 静态数组，存储由视野投影计算出的地平面四个接地区顶点。
 	/// 顺序遵循：[0]左上, [1]右上, [2]右下, [3]左下。
+	/// 仅限游戏线程读取；其他线程请通过 getSnapshotChannel() 读取快照。
 	FVector minimapFrustumPoints[4];
 
+	/**
+	 * @brief       获取相机快照的发布通道。通道与相机组件生命周期解耦，可被任务线程长期持有。
+	 *
+	 * @return      返回值类型:      TSharedRef<const FRTSCameraSnapshotChannel, ESPMode::ThreadSafe>
+	 **/
+	TSharedRef<const FRTSCameraSnapshotChannel, ESPMode::ThreadSafe> getSnapshotChannel() const { return this->snapshotChannel.ToSharedRef(); }
+
+	/**
+	 * @brief       获取由最近一次发布的快照构建的可见性查询（游戏线程）。
+	 *              选择、血条、地标标签等逐对象的可见性判断应使用它代替逐个 ProjectWorldToScreen；
+	 *              其他线程可读取快照后自行构建。相机尚未发布快照时 isValid() 为 false。
+	 *
+	 * @return      返回值类型:      const FRTSCameraFrustumQuery&
+	 **/
+	const FRTSCameraFrustumQuery& getFrustumQuery() const { return this->frustumQuery; }
+
 	/**
 	 * @brief       强制触发視野投影计算，基于当前位置及缩放意图刷新 minimapFrustumPoint 数组数据。
 	 *              注意：仅在相机产生明确的战略意图变更（移动、缩放、跳转）时产生计算开销。
 	 **/
 	UFUNCTION(BlueprintCallable, Category = "RTSCamera|Minimap")
 	void updateMinimapFrustum();
+
+	/**
+	 * @brief       由相机位姿与投影参数求出视野四条边界射线与地面的交点（纯计算，可在任务线程调用）
+	 *
+	 * @param       参数名称: cameraLocation                数据类型:        const FVector&
+	 * @param       参数名称: cameraRotation                数据类型:        const FQuat&
+	 * @param       参数名称: fieldOfViewDegrees            数据类型:        float
+	 * @param       参数名称: aspectRatio                   数据类型:        float
+	 * @param       参数名称: cornerAltitudes               数据类型:        const float[4]  各角点所在地面的高度
+	 * @param       参数名称: outCorners                    数据类型:        FVector[4]  顺序为左上、右上、右下、左下
+	 **/
+	static void projectFrustumGroundCorners(
+		const FVector& cameraLocation,
+		const FQuat& cameraRotation,
+		float fieldOfViewDegrees,
+		float aspectRatio,
+		const float cornerAltitudes[4],
+		FVector outCorners[4]
+	);
+
+private:
+	/** @brief 由最终根坐标、弹簧臂姿态与缩放意图解析相机位姿，并求出四个接地角点 */
+	bool resolveMinimapFrustumPoints();
+
+	/** @brief 视野投影使用的长宽比：优先取缓存的视口尺寸 */
+	float calculateFrustumAspectRatio() const;
+
+	/** @brief 各角点的地面高度：异步探针有效时取探针结果，否则为给定的根坐标高度 */
+	void resolveFrustumCornerAltitudes(float groundAltitude, float outCornerAltitudes[4]) const;
+
+	/** @brief 提交阶段调用：仅在标记为脏且角点位移超过容差时广播；角点可由调用方预先求出 */
+	void resolvePendingMinimapFrustum(const FVector* precomputedFrustumPoints = nullptr);
+
+	/** @brief 广播視野框更新；同一帧内重复请求会推迟到下一帧的提交阶段 */
+	void broadcastMinimapFrustum();
+
+	/** @brief 变换提交后发布本帧快照 */
+	void publishCameraSnapshot();
+
+	/** @brief 向 World Partition 登记/注销流送源提供者 */
+	void registerStreamingSourceProvider();
+	void unregisterStreamingSourceProvider();
+
+	/** @brief 由相邻两次提交的根坐标更新平滑后的平移速度 */
+	void updateStreamingPanVelocity(const FVector& committedLocation);
+
+	/** @brief 以视野四角求出地面覆盖圆（圆心与半径） */
+	bool calculateFrustumGroundCircle(FVector& outCenter, float& outRadius) const;
+
+	/// 是否已登记为流送源提供者
+	bool bRegisteredStreamingSourceProvider;
+
+	/// 平滑后的水平平移速度（UU/s）与上一次提交的水平坐标
+	FVector2D streamingPanVelocity;
+	FVector2D lastStreamingPlanarLocation;
+	bool bHasStreamingVelocitySample;
+
+	/// 跳转造成的位移不计入速度
+	bool bStreamingVelocityResetRequested;
+
+	/// 预取流送源的位置与失效时间（世界时间秒，小于当前时间即失效）
+	FVector streamingPrefetchLocation;
+	double streamingPrefetchExpireSeconds;
+
+	/// 各流送源的名称，登记时生成一次
+	FName currentViewStreamingSourceName;
+	FName predictedViewStreamingSourceName;
+	FName prefetchStreamingSourceName;
+
+	/// 每帧发布一次的只读快照，任意线程无锁读取
+	TSharedPtr<FRTSCameraSnapshotChannel, ESPMode::ThreadSafe> snapshotChannel;
+
+	/// 与最近一次发布的快照同步的可见性查询
+	FRTSCameraFrustumQuery frustumQuery;
+
+	/** @brief 变换提交后记录本帧状态 */
+	void recordReplaySample(const FVector& committedLocation);
+
+	/** @brief 推进回放时间并应用对应的采样 */
+	void advanceReplayPlayback(float frameDeltaSeconds);
+
+	/** @brief 把采样写入暂存根坐标、偏航角与臂长，由本帧的提交阶段统一生效 */
+	void applyReplaySample(const FRTSCameraReplaySample& sample);
+
+	/// 相机状态的回放记录
+	FRTSCameraReplayBuffer replayBuffer;
+
+	/// 是否处于回放中，以及回放位置（世界时间秒）与速率
+	bool bIsReplaying;
+	double replayPlaybackSeconds;
+	float replayPlaybackRate;
+
+	/// 记录中的跟随目标编号到 Actor 的映射，在开始跟随时登记
+	TMap<uint32, TWeakObjectPtr<AActor>> replayFollowTargetsById;
+
+	/// 当前回放采样中的跟随目标
+	TWeakObjectPtr<AActor> replayFollowTarget;
 };
@@ -0,0 +1,78 @@
+// Copyright 2024 Jesus Bracho All Rights Reserved.
+
+#pragma once
+
+#include <CoreMinimal.h>
+
+/**
+ * @brief       相机注意力热力图：覆盖小地图区域的规则网格，每个格子保存视野覆盖它的累计秒数。
+ *
+ * 文件格式（小端，仅追加）：
+ *   文件头  magic 'RTSH' | version | sizeX | sizeY | originX | originY | cellSize
+ *   数据块  magic 'CHNK' | 会话时间（秒） | 本块时长（秒） | 原始字节数 | 压缩字节数 | zlib 压缩的 float[sizeX * sizeY]
+ * 每个数据块只包含上次写入以来的增量，读取时全部相加；进程异常退出导致的残缺尾块会被忽略。
+ **/
+struct OPENRTSCAMERA_API FRTSCameraAttentionHeatmap
+{
+	static constexpr uint32 fileMagic = 0x48535452;   // 'RTSH'
+	static constexpr uint32 chunkMagic = 0x4B4E4843;  // 'CHNK'
+	static constexpr uint32 fileVersion = 1;
+
+	/// 网格尺寸、最小角坐标与格子边长（UU）
+	int32 sizeX = 0;
+	int32 sizeY = 0;
+	FVector2D origin = FVector2D::ZeroVector;
+	float cellSize = 0.0f;
+
+	/// 行优先的累计秒数
+	TArray<float> seconds;
+
+	/// 记录的总时长（秒），合并多场对局时为各场之和
+	double totalSeconds = 0.0;
+
+	/// 合并的文件数量
+	int32 sourceCount = 0;
+
+	bool isValid() const { return this->sizeX > 0 && this->sizeY > 0 && this->seconds.Num() == this->sizeX * this->sizeY; }
+
+	/** @brief 两张热力图的网格布局是否一致（同一张地图、同一精度） */
+	bool hasSameLayout(const FRTSCameraAttentionHeatmap& other) const;
+
+	/**
+	 * @brief       读取一个热力图文件并累加全部数据块
+	 *
+	 * @param       参数名称: filePath                      数据类型:        const FString&
+	 * @param       参数名称: outHeatmap                    数据类型:        FRTSCameraAttentionHeatmap&
+	 * @return      返回值类型:      bool  文件不存在或文件头无效时为 false
+	 **/
+	static bool loadFromFile(const FString& filePath, FRTSCameraAttentionHeatmap& outHeatmap);
+
+	/**
+	 * @brief       把另一张布局一致的热力图累加到本图；本图为空时直接复制
+	 *
+	 * @param       参数名称: other                         数据类型:        const FRTSCameraAttentionHeatmap&
+	 * @return      返回值类型:      bool  布局不一致时为 false
+	 **/
+	bool merge(const FRTSCameraAttentionHeatmap& other);
+
+	/**
+	 * @brief       合并多场对局的热力图文件，布局与第一个有效文件不一致的文件被跳过
+	 *
+	 * @param       参数名称: filePaths                     数据类型:        const TArray<FString>&
+	 * @param       参数名称: outHeatmap                    数据类型:        FRTSCameraAttentionHeatmap&
+	 * @return      返回值类型:      int32  成功合并的文件数量
+	 **/
+	static int32 mergeFiles(const TArray<FString>& filePaths, FRTSCameraAttentionHeatmap& outHeatmap);
+
+	/**
+	 * @brief       追加写入一个增量数据块，文件不存在时先写文件头。仅做文件 I/O，供后台线程调用。
+	 *
+	 * @param       参数名称: filePath                      数据类型:        const FString&
+	 * @param       参数名称: layout                        数据类型:        const FRTSCameraAttentionHeatmap&  只使用网格布局字段
+	 * @param       参数名称: deltaSeconds                  数据类型:        const TArray<float>&
+	 * @param       参数名称: sessionSeconds                数据类型:        double
+	 * @param       参数名称: chunkSeconds                  数据类型:        double
+	 * @return      返回值类型:      bool
+	 **/
+	static bool appendChunk(const FString& filePath, const FRTSCameraAttentionHeatmap& layout, const TArray<float>& deltaSeconds, double sessionSeconds, double chunkSeconds);
+};
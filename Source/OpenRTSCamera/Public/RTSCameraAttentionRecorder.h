@@ -0,0 +1,89 @@
+// Copyright 2024 Jesus Bracho All Rights Reserved.
+
+#pragma once
+
+#include <CoreMinimal.h>
+#include "Components/ActorComponent.h"
+#include "RTSCameraAttentionHeatmap.h"
+#include "Tasks/Task.h"
+#include "RTSCameraAttentionRecorder.generated.h"
+
+class URTSCamera;
+
+/**
+ * @brief       相机注意力记录器，挂在 RTS 相机所在的 Actor 上即可启用。
+ *
+ * 每隔若干帧把相机视野在地面上的四边形光栅化到覆盖小地图区域的粗网格中，按经过的时间累加；
+ * 定期把增量网格交给后台任务压缩并追加写入磁盘，游戏线程只做一次数组交换，不等待任何文件 I/O。
+ * 多场对局的文件可用 FRTSCameraAttentionHeatmap::mergeFiles 离线合并。
+ **/
+UCLASS(Blueprintable, ClassGroup=(Custom), meta=(BlueprintSpawnableComponent))
+class OPENRTSCAMERA_API URTSCameraAttentionRecorder : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	URTSCameraAttentionRecorder();
+
+	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+
+	/// 网格较长一边的格子数
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "RTSCamera - Attention", meta = (ClampMin = "8", ClampMax = "1024", DisplayName = "网格精度"))
+	int32 gridResolution;
+
+	/// 每隔多少帧光栅化一次视野，期间经过的时间合并计入
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "RTSCamera - Attention", meta = (ClampMin = "1", DisplayName = "采样帧间隔"))
+	int32 sampleFrameInterval;
+
+	/// 增量网格写入磁盘的间隔（秒）
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "RTSCamera - Attention", meta = (ClampMin = "1.0", DisplayName = "写入间隔"))
+	float flushIntervalSeconds;
+
+	/// 输出目录，为空时使用 Saved/Telemetry/CameraAttention
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "RTSCamera - Attention", meta = (DisplayName = "输出目录"))
+	FString outputDirectory;
+
+	/**
+	 * @brief       立即把当前的增量网格提交给后台写入
+	 **/
+	UFUNCTION(BlueprintCallable, Category = "RTSCamera|Attention")
+	void flush();
+
+	/** @brief 本场对局的输出文件路径，尚未开始记录时为空 */
+	UFUNCTION(BlueprintPure, Category = "RTSCamera|Attention")
+	FString getOutputFilePath() const { return this->outputFilePath; }
+
+protected:
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+private:
+	/** @brief 以小地图区域（不存在时为相机的移动边界）确定网格布局 */
+	bool initializeGridLayout();
+
+	/** @brief 把视野四边形按格子中心扫描线光栅化，覆盖的格子累加给定秒数 */
+	void rasterizeGroundQuad(const FVector corners[4], float weightSeconds);
+
+	/// 同一 Actor 上的 RTS 相机
+	UPROPERTY(Transient)
+	TObjectPtr<URTSCamera> camera;
+
+	/// 网格布局（seconds 字段不使用）
+	FRTSCameraAttentionHeatmap layout;
+
+	/// 上次写入以来的增量
+	TArray<float> pendingSeconds;
+	double pendingChunkSeconds;
+
+	/// 距上次光栅化累计的帧数与时间
+	int32 framesSinceSample;
+	float secondsSinceSample;
+
+	/// 距上次写入经过的时间
+	float secondsSinceFlush;
+
+	FString outputFilePath;
+
+	/// 最近一次写入任务；后续写入以其为前置，保证数据块按顺序追加
+	UE::Tasks::FTask pendingFlushTask;
+};
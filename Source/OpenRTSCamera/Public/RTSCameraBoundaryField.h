@@ -0,0 +1,65 @@
+// Copyright 2024 Jesus Bracho All Rights Reserved.
+
+#pragma once
+
+#include <CoreMinimal.h>
+
+/**
+ * @brief       多边形边界的有向距离场。
+ *
+ * 载入时对多边形外扩范围做一次规则网格烘焙，每个节点保存到边界的有向距离（内部为负）与最近边的外法线；
+ * 运行时的钳制与侧倾查询为 O(1) 双线性插值，与多边形的顶点数无关。
+ **/
+struct OPENRTSCAMERA_API FRTSCameraBoundaryField
+{
+	/**
+	 * @brief       以给定间距烘焙闭合多边形（世界坐标，首尾自动相连）
+	 *
+	 * @param       参数名称: polygon                       数据类型:        const TArray<FVector2D>&
+	 * @param       参数名称: cellSize                      数据类型:        float
+	 * @param       参数名称: maxSampleCount                数据类型:        int32  超过时自动放大采样间距
+	 * @return      返回值类型:      bool  多边形至少包含三个顶点时为 true
+	 **/
+	bool bake(const TArray<FVector2D>& polygon, float cellSize, int32 maxSampleCount = 256 * 256);
+
+	/**
+	 * @brief       查询任意水平坐标处的有向距离与外法线；网格之外的坐标按到网格边缘的距离外推
+	 *
+	 * @param       参数名称: location                      数据类型:        const FVector2D&
+	 * @param       参数名称: outSignedDistance             数据类型:        float&
+	 * @param       参数名称: outOutwardNormal              数据类型:        FVector2D&
+	 **/
+	void sample(const FVector2D& location, float& outSignedDistance, FVector2D& outOutwardNormal) const;
+
+	/**
+	 * @brief       将坐标沿外法线拉回多边形内部
+	 *
+	 * @param       参数名称: location                      数据类型:        const FVector2D&
+	 * @return      返回值类型:      FVector2D
+	 **/
+	FVector2D clampInside(const FVector2D& location) const;
+
+	bool isValid() const { return this->sampleCountX > 0 && this->sampleCountY > 0; }
+
+	/// 多边形自身的包围盒（不含外扩）
+	const FBox2D& getPolygonBounds() const { return this->polygonBounds; }
+
+private:
+	/** @brief 精确计算点到多边形的有向距离与外法线，仅在烘焙时使用 */
+	static void evaluatePolygon(const TArray<FVector2D>& polygon, const FVector2D& location, float& outSignedDistance, FVector2D& outOutwardNormal);
+
+	FBox2D polygonBounds = FBox2D(ForceInit);
+
+	/// 网格原点（最小 X/Y 角）、间距与其倒数
+	FVector2D gridOrigin = FVector2D::ZeroVector;
+	float gridCellSize = 0.0f;
+	float inverseGridCellSize = 0.0f;
+
+	/// 网格节点数量
+	int32 sampleCountX = 0;
+	int32 sampleCountY = 0;
+
+	/// 行优先存储的有向距离与外法线
+	TArray<float> signedDistances;
+	TArray<FVector2D> outwardNormals;
+};
@@ -0,0 +1,132 @@
+// Copyright 2024 Jesus Bracho All Rights Reserved.
+
+#pragma once
+
+#include <CoreMinimal.h>
+
+struct FRTSCameraBoundaryField;
+
+/**
+ * @brief       相机边界求解器：缓存区域边界、侧倾过渡区阈值与视野延伸系数。
+ *
+ * 所有输入（区域变换、FOV、俯仰角、长宽比、约束参数）在变化时才触发重算，
+ * 逐帧调用只剩下与缓存值的比较以及闭式的 SocketOffset / 钳制计算，不访问任何 UObject。
+ * 区域带有边界距离场时，钳制与侧倾沿最近边的法线进行，开销与多边形复杂度无关。
+ **/
+struct OPENRTSCAMERA_API FRTSCameraBoundarySolver
+{
+	/**
+	 * @brief       更新边界区域。区域变换发生变化时调用。
+	 *
+	 * @param       参数名称: origin                        数据类型:        const FVector&
+	 * @param       参数名称: extents                       数据类型:        const FVector&
+	 **/
+	void setRegion(const FVector& origin, const FVector& extents);
+
+	/**
+	 * @brief       设置非矩形区域的边界距离场；为空时按包围盒约束
+	 *
+	 * @param       参数名称: field                         数据类型:        TSharedPtr<const FRTSCameraBoundaryField>
+	 **/
+	void setBoundaryField(TSharedPtr<const FRTSCameraBoundaryField> field);
+
+	/**
+	 * @brief       清除边界区域，之后的约束调用均不生效
+	 **/
+	void clearRegion();
+
+	/**
+	 * @brief       更新视野投影参数；与缓存值相同时不做任何计算
+	 *
+	 * @param       参数名称: fieldOfViewDegrees            数据类型:        float
+	 * @param       参数名称: pitchDegrees                  数据类型:        float
+	 * @param       参数名称: aspectRatio                   数据类型:        float
+	 **/
+	void setProjection(float fieldOfViewDegrees, float pitchDegrees, float aspectRatio);
+
+	/**
+	 * @brief       更新侧倾约束参数；与缓存值相同时不做任何计算
+	 *
+	 * @param       参数名称: transitionZoneRatio           数据类型:        float
+	 * @param       参数名称: constraintStrength            数据类型:        float
+	 * @param       参数名称: bEnableX                      数据类型:        bool
+	 * @param       参数名称: bEnableY                      数据类型:        bool
+	 **/
+	void setConstraintSettings(float transitionZoneRatio, float constraintStrength, bool bEnableX, bool bEnableY);
+
+	/**
+	 * @brief       闭式求解给定根坐标与臂长下的 SocketOffset（X 为纵向，Y 为横向）
+	 *
+	 * @param       参数名称: rootPlanarLocation            数据类型:        const FVector2D&
+	 * @param       参数名称: armLength                     数据类型:        float
+	 * @return      返回值类型:      FVector2D
+	 **/
+	FVector2D calculateSocketOffset(const FVector2D& rootPlanarLocation, float armLength) const;
+
+	/**
+	 * @brief       将根坐标钳制到区域范围内
+	 *
+	 * @param       参数名称: rootPlanarLocation            数据类型:        const FVector2D&
+	 * @return      返回值类型:      FVector2D
+	 **/
+	FVector2D clampPlanarLocation(const FVector2D& rootPlanarLocation) const;
+
+	/**
+	 * @brief       计算给定臂长下的视野物理量 (离地高度, 横向延伸, 前向延伸)，用于诊断输出
+	 *
+	 * @param       参数名称: armLength                     数据类型:        float
+	 * @return      返回值类型:      FVector
+	 **/
+	FVector calculateReachForArmLength(float armLength) const;
+
+	bool hasRegion() const { return this->bHasRegion; }
+	const FVector& getRegionOrigin() const { return this->regionOrigin; }
+	const FVector& getRegionExtents() const { return this->regionExtents; }
+
+	float getLateralReachFactor() const { return this->lateralReachFactor; }
+	float getForwardReachFactor() const { return this->forwardReachFactor; }
+	float getBackwardReachFactor() const { return this->backwardReachFactor; }
+
+private:
+	/** @brief 由投影参数重算三个延伸系数 */
+	void recalculateReachFactors();
+
+	/** @brief 由区域与约束参数重算过渡区阈值 */
+	void recalculateTransitionThresholds();
+
+	/// 区域数据
+	bool bHasRegion = false;
+	FVector regionOrigin = FVector::ZeroVector;
+	FVector regionExtents = FVector::ZeroVector;
+
+	/// 投影输入缓存
+	float cachedFieldOfViewDegrees = -1.0f;
+	float cachedPitchDegrees = 0.0f;
+	float cachedAspectRatio = -1.0f;
+
+	/// 约束输入缓存
+	float cachedTransitionZoneRatio = -1.0f;
+	float cachedConstraintStrength = 0.0f;
+	bool bEnableXConstraint = true;
+	bool bEnableYConstraint = true;
+
+	/** @brief 预计算的横向延伸系数 (Lateral Reach / TargetArmLength) */
+	float lateralReachFactor = 0.0f;
+
+	/** @brief 预计算的纵向延伸系数 (Forward Reach / TargetArmLength) */
+	float forwardReachFactor = 0.0f;
+
+	/** @brief 预计算的后向延伸系数 (Backward Reach / TargetArmLength) */
+	float backwardReachFactor = 0.0f;
+
+	/// 各轴进入侧倾过渡区的距离阈值，以及过渡区宽度的倒数
+	FVector2D transitionStartDistance = FVector2D::ZeroVector;
+	FVector2D inverseTransitionWidth = FVector2D::ZeroVector;
+
+	/// 非矩形区域的边界距离场
+	TSharedPtr<const FRTSCameraBoundaryField> boundaryField;
+
+	/// 距离场模式下的过渡区宽度（以包围盒短边计）及其倒数
+	float fieldTransitionWidth = 0.0f;
+	float inverseFieldTransitionWidth = 0.0f;
+};
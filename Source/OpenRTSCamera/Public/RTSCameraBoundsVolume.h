@@ -6,6 +6,23 @@
 #include "GameFramework/CameraBlockingVolume.h"
 #include "RTSCameraBoundsVolume.generated.h"
 
+class USplineComponent;
+struct FRTSCameraBoundaryField;
+
+/**
+ * @brief       相机区域的边界形状
+ **/
+UENUM(BlueprintType)
+enum class ERTSCameraBoundaryShape : uint8
+{
+	/// 使用体积自身的轴对齐包围盒
+	Box,
+	/// 使用 BoundaryPolygonPoints 定义的闭合多边形
+	Polygon,
+	/// 使用 BoundarySpline 定义的闭合样条
+	Spline,
+};
+
 UCLASS()
 class OPENRTSCAMERA_API ARTSCameraBoundsVolume : public ACameraBlockingVolume
 {
@@ -14,6 +31,59 @@ class OPENRTSCAMERA_API ARTSCameraBoundsVolume : public ACameraBlockingVolume
 public:
 	ARTSCameraBoundsVolume();
 
+	/**
+	 * @brief       运行时启用或禁用该区域（例如对局中途解锁新区域）
+	 *
+	 * @param       参数名称: bEnabled                      数据类型:        bool
+	 **/
+	UFUNCTION(BlueprintCallable, Category = "RTSCamera|Regions")
+	void SetRegionEnabled(bool bEnabled);
+
+	/**
+	 * @brief       按当前形状与世界变换重新烘焙边界距离场；Box 形状会清空距离场
+	 **/
+	void RebuildBoundaryField();
+
+	/**
+	 * @brief       获取已烘焙的边界距离场，Box 形状或烘焙失败时为空
+	 **/
+	TSharedPtr<const FRTSCameraBoundaryField> GetBoundaryField() const { return this->BoundaryField; }
+
+	/// 区域重叠时优先级高者生效
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "RTSCamera|Regions")
+	int32 RegionPriority;
+
+	/// 开局时是否启用该区域
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "RTSCamera|Regions")
+	bool bRegionEnabled;
+
+	/// 边界形状：非矩形的岛屿、海岸线使用多边形或样条
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "RTSCamera|Regions")
+	ERTSCameraBoundaryShape BoundaryShape;
+
+	/// 多边形边界顶点（Actor 局部坐标，按顺序首尾相连）
+	UPROPERTY(EditAnywhere, Category = "RTSCamera|Regions", meta = (MakeEditWidget, EditCondition = "BoundaryShape == ERTSCameraBoundaryShape::Polygon"))
+	TArray<FVector> BoundaryPolygonPoints;
+
+	/// 样条边界，按闭合环处理
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "RTSCamera|Regions")
+	TObjectPtr<USplineComponent> BoundarySpline;
+
+	/// 样条离散为多边形时的采样间距
+	UPROPERTY(EditAnywhere, Category = "RTSCamera|Regions", meta = (ClampMin = "10.0", EditCondition = "BoundaryShape == ERTSCameraBoundaryShape::Spline"))
+	float BoundarySplineSampleSpacing;
+
+	/// 距离场网格间距，越小越贴合边界、烘焙越慢
+	UPROPERTY(EditAnywhere, Category = "RTSCamera|Regions", meta = (ClampMin = "10.0", EditCondition = "BoundaryShape != ERTSCameraBoundaryShape::Box"))
+	float BoundaryFieldCellSize;
+
 protected:
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+private:
+	/** @brief 按当前形状收集世界坐标下的边界多边形 */
+	bool CollectBoundaryPolygon(TArray<FVector2D>& OutPolygon) const;
+
+	TSharedPtr<FRTSCameraBoundaryField> BoundaryField;
 };
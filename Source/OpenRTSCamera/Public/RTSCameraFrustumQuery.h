@@ -0,0 +1,183 @@
+// Copyright 2024 Jesus Bracho All Rights Reserved.
+
+#pragma once
+
+#include <CoreMinimal.h>
+
+struct FRTSCameraSnapshot;
+
+/**
+ * @brief       相机可见性查询。
+ *
+ * 由某一帧的相机快照构建：包含完整的六个视锥平面，以及视野在地面上的四边形；
+ * 也可由视点与屏幕子矩形四个角点的射线构建，作为框选与点选的选择体积，与可见性查询共用同一套批量内核。
+ * 所有平面都以相机位置为原点存储，批量接口在相对坐标下以单精度向量（SSE/NEON）每次测试四个对象，
+ * 大世界坐标下也不会损失精度。构建完成后为只读数据，可复制到任意线程使用。
+ *
+ * 批量接口的输出为位掩码：第 i 个对象对应 outMask[i / 32] 的第 (i % 32) 位，调用方需提供 getMaskWordCount(num) 个字。
+ **/
+struct OPENRTSCAMERA_API FRTSCameraFrustumQuery
+{
+	/// 未指定时使用的近、远裁剪距离；相机使用无限远投影，远平面只用于剔除明显越界的对象
+	static constexpr float defaultNearClipDistance = 10.0f;
+	static constexpr float defaultFarClipDistance = 2000000.0f;
+
+	/**
+	 * @brief       由相机快照构建查询
+	 *
+	 * @param       参数名称: snapshot                      数据类型:        const FRTSCameraSnapshot&
+	 * @param       参数名称: nearClipDistance              数据类型:        float
+	 * @param       参数名称: farClipDistance               数据类型:        float
+	 **/
+	void build(const FRTSCameraSnapshot& snapshot, float nearClipDistance = defaultNearClipDistance, float farClipDistance = defaultFarClipDistance);
+
+	/**
+	 * @brief       由视点与屏幕子矩形四个角点的世界射线构建（框选体积）。侧面平面经过视点，近、远平面垂直于四条射线的平均方向；
+	 *              此时没有地面四边形，地面四边形相关的接口不可用。
+	 *
+	 * @param       参数名称: eye                           数据类型:        const FVector&
+	 * @param       参数名称: cornerDirections              数据类型:        const FVector(&)[4]  按屏幕上的环绕顺序排列，顺、逆时针均可
+	 * @param       参数名称: nearClipDistance              数据类型:        float
+	 * @param       参数名称: farClipDistance               数据类型:        float
+	 * @return      返回值类型:      bool  射线退化（选区面积为零或方向无效）时返回 false
+	 **/
+	bool buildFromCornerRays(const FVector& eye, const FVector (&cornerDirections)[4], float nearClipDistance = defaultNearClipDistance, float farClipDistance = defaultFarClipDistance);
+
+	/** @brief 是否已由快照构建 */
+	bool isValid() const { return this->bValid; }
+
+	/** @brief 相机位置，即所有平面的原点 */
+	const FVector& getOrigin() const { return this->origin; }
+
+	/** @brief 地面四边形的中心与外接半径 */
+	const FVector2D& getGroundQuadCenter() const { return this->groundQuadCenter; }
+	float getGroundQuadRadius() const { return this->groundQuadRadius; }
+
+	/**
+	 * @brief       视锥在 [minZ, maxZ] 高度范围内部分的水平包围盒，用于空间索引的粗筛
+	 *
+	 * @param       参数名称: minZ                          数据类型:        float
+	 * @param       参数名称: maxZ                          数据类型:        float
+	 * @param       参数名称: outGroundBox                  数据类型:        FBox2D&
+	 * @return      返回值类型:      bool  任一角点射线不朝下（看向地平线以上）时范围无界，返回 false
+	 **/
+	bool getGroundBounds(float minZ, float maxZ, FBox2D& outGroundBox) const;
+
+	/**
+	 * @brief       点是否在视锥内
+	 *
+	 * @param       参数名称: location                      数据类型:        const FVector&
+	 * @return      返回值类型:      bool
+	 **/
+	bool isPointVisible(const FVector& location) const;
+
+	/**
+	 * @brief       球体是否与视锥相交
+	 *
+	 * @param       参数名称: center                        数据类型:        const FVector&
+	 * @param       参数名称: radius                        数据类型:        float
+	 * @return      返回值类型:      bool
+	 **/
+	bool isSphereVisible(const FVector& center, float radius) const;
+
+	/**
+	 * @brief       点的水平投影是否在地面四边形内
+	 *
+	 * @param       参数名称: location                      数据类型:        const FVector&
+	 * @param       参数名称: margin                        数据类型:        float  大于 0 时四边形各边向外扩展
+	 * @return      返回值类型:      bool
+	 **/
+	bool isPointInGroundQuad(const FVector& location, float margin = 0.0f) const;
+
+	/**
+	 * @brief       批量测试点是否在视锥内
+	 *
+	 * @param       参数名称: locations                     数据类型:        TConstArrayView<FVector>
+	 * @param       参数名称: outMask                       数据类型:        TArrayView<uint32>
+	 **/
+	void testPointsVisible(TConstArrayView<FVector> locations, TArrayView<uint32> outMask) const;
+
+	/**
+	 * @brief       批量测试球体是否与视锥相交
+	 *
+	 * @param       参数名称: centers                       数据类型:        TConstArrayView<FVector>
+	 * @param       参数名称: radii                         数据类型:        TConstArrayView<float>  与 centers 等长
+	 * @param       参数名称: outMask                       数据类型:        TArrayView<uint32>
+	 **/
+	void testSpheresVisible(TConstArrayView<FVector> centers, TConstArrayView<float> radii, TArrayView<uint32> outMask) const;
+
+	/**
+	 * @brief       批量测试轴对齐包围盒是否与视锥相交：对每个平面取法线方向上最远的顶点（正顶点）判断
+	 *
+	 * @param       参数名称: centers                       数据类型:        TConstArrayView<FVector>
+	 * @param       参数名称: extents                       数据类型:        TConstArrayView<FVector3f>  半尺寸，与 centers 等长
+	 * @param       参数名称: outMask                       数据类型:        TArrayView<uint32>
+	 **/
+	void testBoxesVisible(TConstArrayView<FVector> centers, TConstArrayView<FVector3f> extents, TArrayView<uint32> outMask) const;
+
+	/**
+	 * @brief       批量测试点的水平投影是否在地面四边形内
+	 *
+	 * @param       参数名称: locations                     数据类型:        TConstArrayView<FVector>
+	 * @param       参数名称: margin                        数据类型:        float
+	 * @param       参数名称: outMask                       数据类型:        TArrayView<uint32>
+	 **/
+	void testPointsInGroundQuad(TConstArrayView<FVector> locations, float margin, TArrayView<uint32> outMask) const;
+
+	/**
+	 * @brief       四个点到地面四边形各边的最小有符号距离（内部为正），供自行组织数据的批量调用方使用
+	 *
+	 * @param       参数名称: relativeX                     数据类型:        VectorRegister4Float  相对 getOrigin() 的 X
+	 * @param       参数名称: relativeY                     数据类型:        VectorRegister4Float  相对 getOrigin() 的 Y
+	 * @return      返回值类型:      VectorRegister4Float
+	 **/
+	FORCEINLINE VectorRegister4Float groundQuadDistance4(const VectorRegister4Float relativeX, const VectorRegister4Float relativeY) const
+	{
+		VectorRegister4Float minDistance = VectorMultiplyAdd(VectorSetFloat1(this->edgeNormalX[0]), relativeX,
+			VectorMultiplyAdd(VectorSetFloat1(this->edgeNormalY[0]), relativeY, VectorSetFloat1(this->edgeOffsets[0])));
+		for (int32 edgeIndex = 1; edgeIndex < 4; ++edgeIndex)
+		{
+			minDistance = VectorMin(minDistance, VectorMultiplyAdd(VectorSetFloat1(this->edgeNormalX[edgeIndex]), relativeX,
+				VectorMultiplyAdd(VectorSetFloat1(this->edgeNormalY[edgeIndex]), relativeY, VectorSetFloat1(this->edgeOffsets[edgeIndex]))));
+		}
+		return minDistance;
+	}
+
+	/** @brief 批量接口所需的掩码字数 */
+	static int32 getMaskWordCount(const int32 num) { return (num + 31) / 32; }
+
+	/** @brief 读取批量接口输出的某一位 */
+	static bool isMaskBitSet(TConstArrayView<uint32> mask, const int32 index) { return (mask[index >> 5] >> (index & 31)) & 1u; }
+
+private:
+	/** @brief 四个球体到六个平面的最小有符号距离加半径，非负即可见 */
+	VectorRegister4Float frustumDistance4(VectorRegister4Float relativeX, VectorRegister4Float relativeY, VectorRegister4Float relativeZ) const;
+
+	/** @brief 四个包围盒的正顶点到六个平面的最小有符号距离，非负即相交 */
+	VectorRegister4Float frustumBoxDistance4(VectorRegister4Float relativeX, VectorRegister4Float relativeY, VectorRegister4Float relativeZ,
+		VectorRegister4Float extentX, VectorRegister4Float extentY, VectorRegister4Float extentZ) const;
+
+	/** @brief 把 locations[firstIndex, firstIndex + 4) 转为相对原点的单精度坐标；不足四个时重复最后一个 */
+	void loadRelative4(TConstArrayView<FVector> locations, int32 firstIndex, VectorRegister4Float& outX, VectorRegister4Float& outY, VectorRegister4Float& outZ) const;
+
+	FVector origin = FVector::ZeroVector;
+
+	/// 四条角点射线的单位方向，用于求高度层内的水平范围
+	FVector cornerDirections[4];
+
+	/// 视锥平面（左、右、上、下、近、远），法线朝内：n·(p - origin) + w >= 0 表示在平面内侧
+	float planeX[6] = {};
+	float planeY[6] = {};
+	float planeZ[6] = {};
+	float planeW[6] = {};
+
+	/// 地面四边形的边，法线朝内且已归一化：n·(p - origin) + offset 即到该边的有符号距离
+	float edgeNormalX[4] = {};
+	float edgeNormalY[4] = {};
+	float edgeOffsets[4] = {};
+
+	FVector2D groundQuadCenter = FVector2D::ZeroVector;
+	float groundQuadRadius = 0.0f;
+
+	bool bValid = false;
+};
@@ -0,0 +1,42 @@
+// Copyright 2024 Jesus Bracho All Rights Reserved.
+
+#pragma once
+
+#include <CoreMinimal.h>
+#include <atomic>
+#include "Framework/Application/IInputProcessor.h"
+
+/**
+ * @brief       注册到 Slate 的输入预处理器：在输入路径上记录最近一次原始光标事件的位置，供相机每帧一次性读取。
+ *
+ * 事件侧与读取侧只通过原子变量通信，不加锁；位置以 1/16 像素定点数打包进同一个 64 位原子量，读取时不会出现 X/Y 撕裂。
+ * 采样窗口可由相机在唤醒或开始拖拽时重置，重置后直到下一个事件到达前不提供位置，避免沿用休眠前的陈旧光标。
+ * 预处理器从不消费事件，对其余输入处理链路没有影响。
+ **/
+class OPENRTSCAMERA_API FRTSCameraInputPreprocessor : public IInputProcessor
+{
+public:
+	FRTSCameraInputPreprocessor();
+
+	virtual void Tick(const float DeltaTime, FSlateApplication& SlateApp, TSharedRef<ICursor> Cursor) override;
+	virtual bool HandleMouseMoveEvent(FSlateApplication& SlateApp, const FPointerEvent& MouseEvent) override;
+	virtual const TCHAR* GetDebugName() const override { return TEXT("RTSCameraInputPreprocessor"); }
+
+	/**
+	 * @brief       读取当前采样窗口内最近一次事件的光标位置（屏幕像素空间）
+	 *
+	 * @param       参数名称: outScreenPosition             数据类型:        FVector2D&
+	 * @return      返回值类型:      bool  自上次重置以来尚未收到光标事件时为 false
+	 **/
+	bool drain(FVector2D& outScreenPosition) const;
+
+	/** @brief 重置采样窗口，丢弃此前记录的光标位置 */
+	void resetSampleWindow();
+
+private:
+	/// 最近一次事件的光标位置：高 32 位为 X、低 32 位为 Y（1/16 像素）
+	std::atomic<int64> latestPackedPosition;
+
+	/// 当前采样窗口内是否收到过事件
+	std::atomic<bool> bHasPosition;
+};
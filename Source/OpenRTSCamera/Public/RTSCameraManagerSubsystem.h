@@ -0,0 +1,186 @@
+// Copyright 2024 Jesus Bracho All Rights Reserved.
+
+#pragma once
+
+#include <CoreMinimal.h>
+#include "Engine/EngineBaseTypes.h"
+#include "RTSCameraSnapshot.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "RTSCameraManagerSubsystem.generated.h"
+
+class URTSCamera;
+class FRTSCameraScreenBins;
+struct FRTSCameraBoundarySolver;
+
+/**
+ * @brief       相机管理器的 Tick 函数，各相机的弹簧臂以其为前置条件
+ **/
+USTRUCT()
+struct FRTSCameraManagerTickFunction : public FTickFunction
+{
+	GENERATED_BODY()
+
+	/// 所属的相机管理器
+	class URTSCameraManagerSubsystem* Manager = nullptr;
+
+	virtual void ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent) override;
+	virtual FString DiagnosticMessage() override;
+	virtual FName DiagnosticContext(bool bDetailed) override;
+};
+
+template<>
+struct TStructOpsTypeTraits<FRTSCameraManagerTickFunction> : public TStructOpsTypeTraitsBase2<FRTSCameraManagerTickFunction>
+{
+	enum
+	{
+		WithCopy = false
+	};
+};
+
+/**
+ * @brief       RTS 相机管理器。
+ *
+ * 同一世界中的所有 RTS 相机（分屏、画中画、观战视角）登记到此处，由一个 Tick 函数统一推进：
+ * 1. 收集：逐相机执行依赖 UObject 的输入与运动阶段，并把求解所需的状态写入结构数组；
+ * 2. 求解：缩放插值、边界 SocketOffset、根坐标钳制与视野投影均为纯计算，相机数量较多时以 ParallelFor 分发；
+ * 3. 写回：逐相机提交变换、广播视野框并判断休眠。
+ * 所有相机都休眠时管理器的 Tick 同样关闭。
+ **/
+UCLASS()
+class OPENRTSCAMERA_API URTSCameraManagerSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	/**
+	 * @brief       登记相机，之后由管理器推进其每帧更新
+	 *
+	 * @param       参数名称: Camera                        数据类型:        URTSCamera*
+	 **/
+	void RegisterCamera(URTSCamera* Camera);
+
+	/**
+	 * @brief       注销相机
+	 *
+	 * @param       参数名称: Camera                        数据类型:        URTSCamera*
+	 **/
+	void UnregisterCamera(URTSCamera* Camera);
+
+	/**
+	 * @brief       相机从空闲休眠中唤醒时调用，恢复管理器的 Tick
+	 *
+	 * @param       参数名称: Camera                        数据类型:        URTSCamera*
+	 **/
+	void NotifyCameraAwake(URTSCamera* Camera);
+
+	/** @brief 已登记的相机数量 */
+	int32 GetCameraCount() const { return this->Cameras.Num(); }
+
+	/**
+	 * @brief       主玩家相机的快照通道。通道在子系统生命周期内不变，可在初始化时缓存并在任务线程上读取；
+	 *              分屏时为第一位本地玩家的相机，Mass 处理器等不区分玩家的消费者使用它。
+	 *
+	 * @return      返回值类型:      TSharedRef<const FRTSCameraSnapshotChannel, ESPMode::ThreadSafe>
+	 **/
+	TSharedRef<const FRTSCameraSnapshotChannel, ESPMode::ThreadSafe> GetPrimarySnapshotChannel() const { return this->PrimarySnapshotChannel.ToSharedRef(); }
+
+	/**
+	 * @brief       由主玩家相机在发布自身快照后调用，转发到主快照通道
+	 *
+	 * @param       参数名称: Snapshot                      数据类型:        const FRTSCameraSnapshot&
+	 **/
+	void PublishPrimarySnapshot(const FRTSCameraSnapshot& Snapshot);
+
+	/**
+	 * @brief       按主快照分箱的 Mass 实体屏幕瓦片，由 URTSCameraScreenBinProcessor 写入，框选与点选读取
+	 *
+	 * @return      返回值类型:      TSharedRef<FRTSCameraScreenBins, ESPMode::ThreadSafe>
+	 **/
+	TSharedRef<FRTSCameraScreenBins, ESPMode::ThreadSafe> GetPrimaryScreenBins() const { return this->PrimaryScreenBins.ToSharedRef(); }
+
+	/// 本帧参与求解的相机数量达到该值时，纯计算阶段分发到任务线程
+	int32 ParallelSolveThreshold = 4;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	friend struct FRTSCameraManagerTickFunction;
+
+	/** @brief 推进所有未休眠的相机 */
+	void TickCameras(float DeltaTime);
+
+	/** @brief 收集阶段：在游戏线程上推进各相机并填充结构数组 */
+	void GatherFrameState(float DeltaTime);
+
+	/** @brief 求解阶段：对结构数组执行纯计算 */
+	void SolveFrameState(float DeltaTime);
+
+	/** @brief 写回阶段：把求解结果提交到各相机的组件 */
+	void ApplyFrameState();
+
+	/** @brief 按已登记相机的需求刷新 Tick 组：任一相机启用延迟更新时整批移至 TG_LastDemotable */
+	void RefreshTickGroup();
+
+	/** @brief 首个相机登记时向关卡注册 Tick 函数 */
+	void EnsureTickFunctionRegistered();
+
+	/// 已登记的相机
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<URTSCamera>> Cameras;
+
+	FRTSCameraManagerTickFunction TickFunction;
+
+	/// 主玩家相机的快照通道
+	TSharedPtr<FRTSCameraSnapshotChannel, ESPMode::ThreadSafe> PrimarySnapshotChannel;
+
+	/// 主玩家相机视角下的 Mass 实体屏幕瓦片
+	TSharedPtr<FRTSCameraScreenBins, ESPMode::ThreadSafe> PrimaryScreenBins;
+
+	/// 本帧参与求解的相机状态，结构数组布局，下标为本帧的紧凑序号
+	struct FFrameState
+	{
+		/// 求解阶段需要执行的步骤
+		enum EFlags : uint8
+		{
+			InterpolateArmLength = 1 << 0,
+			ResolveFrustum = 1 << 1
+		};
+
+		TArray<URTSCamera*> Cameras;
+		TArray<uint8> Flags;
+
+		/// 暂存的根坐标（收集时为约束前，求解后为最终提交值）
+		TArray<FVector> RootLocations;
+
+		/// 弹簧臂当前臂长、缩放意图与追赶速度
+		TArray<float> ArmLengths;
+		TArray<float> DesiredArmLengths;
+		TArray<float> ArmCatchupSpeeds;
+
+		/// 边界求解器；相机不在任何区域内时为空
+		TArray<const FRTSCameraBoundarySolver*> Solvers;
+
+		/// 弹簧臂 SocketOffset（求解后 X/Y 为边界补偿）
+		TArray<FVector> SocketOffsets;
+
+		/// 视野投影输入：弹簧臂原点相对根坐标的偏移、弹簧臂与相机的旋转、FOV、长宽比、各角点地面高度
+		TArray<FVector> ArmOriginOffsets;
+		TArray<FQuat> ArmRotations;
+		TArray<FQuat> CameraRelativeRotations;
+		TArray<float> FieldOfViews;
+		TArray<float> AspectRatios;
+		TArray<float> CornerAltitudes;
+
+		/// 视野投影输出，每个相机四个角点
+		TArray<FVector> FrustumCorners;
+
+		void Reset(int32 Capacity);
+		int32 Num() const { return Cameras.Num(); }
+	};
+
+	FFrameState FrameState;
+};
@@ -0,0 +1,175 @@
+// Copyright 2024 Jesus Bracho All Rights Reserved.
+
+#pragma once
+
+#include <CoreMinimal.h>
+#include "Components/SceneComponent.h"
+#include "Engine/EngineTypes.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "RTSCameraRegionSubsystem.generated.h"
+
+struct FRTSCameraBoundaryField;
+
+/** @brief 相机区域集合或任一区域的范围、启用状态发生变化时的多播委托声明 */
+DECLARE_MULTICAST_DELEGATE(FOnCameraRegionsChanged);
+
+/**
+ * @brief       已登记的相机活动区域
+ **/
+struct FRTSCameraRegion
+{
+	/// 区域对应的 Actor（ARTSCameraBoundsVolume 或 AMinimapRegion）
+	TWeakObjectPtr<AActor> RegionActor;
+
+	/// 区域包围盒的中心与半尺寸
+	FVector Origin = FVector::ZeroVector;
+	FVector Extents = FVector::ZeroVector;
+
+	/// 允许视野越出区域边缘的距离，仅 AMinimapRegion 提供
+	float OverflowDistance = 0.0f;
+
+	/// 区域重叠时优先级高者生效
+	int32 Priority = 0;
+
+	/// 优先级相同时的确定性排序键：登记时取 Actor 的完整路径名，与登记顺序无关
+	FString TieBreakKey;
+
+	/// 未启用的区域不参与查询，可在对局中途解锁
+	bool bEnabled = true;
+
+	/// 非矩形区域的边界距离场；为空时区域即包围盒本身
+	TSharedPtr<const FRTSCameraBoundaryField> BoundaryField;
+
+	/** @brief 是否应优先于另一个区域生效：先比较优先级，相同时按路径名排序 */
+	bool IsPreferredOver(const FRTSCameraRegion& Other) const
+	{
+		return Priority != Other.Priority ? Priority > Other.Priority : TieBreakKey < Other.TieBreakKey;
+	}
+
+	FBox2D GetPlanarBounds() const
+	{
+		return FBox2D(FVector2D(Origin.X - Extents.X, Origin.Y - Extents.Y), FVector2D(Origin.X + Extents.X, Origin.Y + Extents.Y));
+	}
+};
+
+/**
+ * @brief       相机区域注册表。
+ *
+ * ARTSCameraBoundsVolume 在 BeginPlay/EndPlay 中自行登记与注销；外部插件的 AMinimapRegion 在世界开始时统一收编一次。
+ * 按 X 轴区间构建居中区间树，任意坐标的活动区域查询为 O(log n + k)，启用状态切换无需重建。
+ * 重叠区域按优先级取舍，优先级相同时按 Actor 路径名确定，结果不依赖登记顺序。
+ **/
+UCLASS()
+class OPENRTSCAMERA_API URTSCameraRegionSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	virtual void Deinitialize() override;
+
+	/**
+	 * @brief       登记一个区域 Actor；重复登记只更新优先级与启用状态
+	 *
+	 * @param       参数名称: RegionActor                   数据类型:        AActor*
+	 * @param       参数名称: Priority                      数据类型:        int32
+	 * @param       参数名称: bEnabled                      数据类型:        bool
+	 **/
+	UFUNCTION(BlueprintCallable, Category = "RTSCamera|Regions")
+	void RegisterRegion(AActor* RegionActor, int32 Priority, bool bEnabled);
+
+	/**
+	 * @brief       注销一个区域 Actor
+	 *
+	 * @param       参数名称: RegionActor                   数据类型:        AActor*
+	 **/
+	UFUNCTION(BlueprintCallable, Category = "RTSCamera|Regions")
+	void UnregisterRegion(AActor* RegionActor);
+
+	/**
+	 * @brief       运行时启用或禁用区域
+	 *
+	 * @param       参数名称: RegionActor                   数据类型:        AActor*
+	 * @param       参数名称: bEnabled                      数据类型:        bool
+	 **/
+	UFUNCTION(BlueprintCallable, Category = "RTSCamera|Regions")
+	void SetRegionEnabled(AActor* RegionActor, bool bEnabled);
+
+	/**
+	 * @brief       查询包含给定水平坐标的、优先级最高的已启用区域 Actor
+	 *
+	 * @param       参数名称: Location                      数据类型:        FVector2D
+	 * @return      返回值类型:      AActor*  不存在时为空
+	 **/
+	UFUNCTION(BlueprintCallable, Category = "RTSCamera|Regions")
+	AActor* FindRegionActorAt(FVector2D Location) const;
+
+	/**
+	 * @brief       查询包含给定水平坐标的、优先级最高的已启用区域
+	 *
+	 * @param       参数名称: Location                      数据类型:        const FVector2D&
+	 * @param       参数名称: bFallbackToNearest            数据类型:        bool  无区域包含该坐标时返回距离最近的已启用区域
+	 * @return      返回值类型:      const FRTSCameraRegion*
+	 **/
+	const FRTSCameraRegion* FindRegionAt(const FVector2D& Location, bool bFallbackToNearest = false) const;
+
+	/**
+	 * @brief       按 Actor 查找已登记的区域
+	 **/
+	const FRTSCameraRegion* FindRegion(const AActor* RegionActor) const;
+
+	/// 区域集合、范围或启用状态变化时广播
+	FOnCameraRegionsChanged OnRegionsChanged;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	/** @brief 居中区间树节点：存放跨越中心点的区间，分别按左端升序与右端降序排列 */
+	struct FIntervalNode
+	{
+		float Center = 0.0f;
+		int32 LeftChild = INDEX_NONE;
+		int32 RightChild = INDEX_NONE;
+		TArray<int32> RegionsByMinX;
+		TArray<int32> RegionsByMaxX;
+	};
+
+	/** @brief 树被标记为脏时按当前区域重建 */
+	void RebuildIntervalTreeIfDirty() const;
+
+	/** @brief 递归构建子树，返回节点下标 */
+	int32 BuildIntervalNode(TArray<int32>& RegionIndices) const;
+
+	/** @brief 从 Actor 读取区域范围；AMinimapRegion 使用其 BoundsComponent，多边形体积使用其距离场 */
+	static bool CalculateRegionBounds(AActor* RegionActor, FRTSCameraRegion& OutRegion);
+
+	/** @brief 区域范围所依赖的组件，用于监听变换更新 */
+	static USceneComponent* GetRegionBoundsComponent(const AActor* RegionActor);
+
+	/** @brief 区域组件变换更新回调 */
+	void HandleRegionTransformUpdated(USceneComponent* UpdatedComponent, EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport);
+
+	/** @brief 收编的 AMinimapRegion 结束游戏时自动注销 */
+	UFUNCTION()
+	void HandleAdoptedRegionEndPlay(AActor* Actor, EEndPlayReason::Type EndPlayReason);
+
+	/** @brief 运行时生成的 AMinimapRegion 同样收编 */
+	void HandleActorSpawned(AActor* SpawnedActor);
+
+	/** @brief 收编一个 AMinimapRegion */
+	void AdoptMinimapRegion(AActor* RegionActor);
+
+	/// 已登记的区域（无序，注销时交换删除）
+	TArray<FRTSCameraRegion> Regions;
+
+	/// Actor 到区域下标的映射
+	TMap<TWeakObjectPtr<AActor>, int32> RegionIndexByActor;
+
+	/// 区间树节点池与根节点
+	mutable TArray<FIntervalNode> IntervalNodes;
+	mutable int32 IntervalRoot = INDEX_NONE;
+	mutable bool bIntervalTreeDirty = true;
+
+	FDelegateHandle ActorSpawnedHandle;
+};
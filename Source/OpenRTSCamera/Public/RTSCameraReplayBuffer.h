@@ -0,0 +1,122 @@
+// Copyright 2024 Jesus Bracho All Rights Reserved.
+
+#pragma once
+
+#include <CoreMinimal.h>
+
+/**
+ * @brief       相机回放的单个采样（解码后的完整状态）
+ **/
+struct FRTSCameraReplaySample
+{
+	/// 世界时间（秒）
+	double timeSeconds = 0.0;
+
+	/// 根组件坐标与偏航角
+	FVector rootLocation = FVector::ZeroVector;
+	float yaw = 0.0f;
+
+	/// 弹簧臂臂长与 SocketOffset
+	float armLength = 0.0f;
+	FVector socketOffset = FVector::ZeroVector;
+
+	/// 跟随目标的 UObject 唯一编号，0 表示未跟随
+	uint32 followTargetId = 0;
+};
+
+/**
+ * @brief       相机状态的定长环形缓冲。
+ *
+ * 存储区在 initialize() 时一次性分配并切分为定长数据块，之后记录与回放都不再分配内存。
+ * 每个数据块以一个完整关键帧开头，其后的采样只记录相对上一采样发生变化的字段：
+ * 数值先按固定步长量化为整数，差值经 ZigZag + 变长整数编码，静止帧只占两个字节。
+ * 写满后覆盖最旧的数据块；按时间查询时二分定位数据块，再从关键帧顺序解码，相邻采样间线性插值。
+ **/
+class OPENRTSCAMERA_API FRTSCameraReplayBuffer
+{
+public:
+	/**
+	 * @brief       分配存储区并清空已有记录
+	 *
+	 * @param       参数名称: capacityBytes                 数据类型:        int32  增量数据的总字节数
+	 * @param       参数名称: blockBytes                    数据类型:        int32  单个数据块的字节数，决定关键帧间隔与单次查询的解码量
+	 **/
+	void initialize(int32 capacityBytes, int32 blockBytes = 4096);
+
+	/** @brief 清空记录，保留存储区 */
+	void reset();
+
+	/**
+	 * @brief       追加一个采样；时间早于上一采样时（例如世界重新开始）先清空记录
+	 *
+	 * @param       参数名称: sample                        数据类型:        const FRTSCameraReplaySample&
+	 **/
+	void record(const FRTSCameraReplaySample& sample);
+
+	/**
+	 * @brief       查询指定时间的相机状态，时间被钳制到已记录的范围内
+	 *
+	 * @param       参数名称: timeSeconds                   数据类型:        double
+	 * @param       参数名称: outSample                     数据类型:        FRTSCameraReplaySample&
+	 * @return      返回值类型:      bool  尚无任何记录时为 false
+	 **/
+	bool sampleAt(double timeSeconds, FRTSCameraReplaySample& outSample) const;
+
+	bool isInitialized() const { return this->blocks.Num() > 0; }
+	bool isEmpty() const { return this->activeBlockCount == 0; }
+
+	/** @brief 已记录范围的起止时间（秒） */
+	double getOldestTimeSeconds() const;
+	double getNewestTimeSeconds() const;
+
+	/** @brief 存储区占用的内存（字节） */
+	SIZE_T getAllocatedBytes() const { return this->storage.GetAllocatedSize() + this->blocks.GetAllocatedSize(); }
+
+private:
+	/// 量化后的采样；时间单位为毫秒，长度单位为 positionQuantizationStep，偏航角为 1/65536 圈
+	struct FQuantizedSample
+	{
+		int64 timeMilliseconds = 0;
+		int32 rootLocation[3] = {};
+		uint16 yaw = 0;
+		int32 armLength = 0;
+		int32 socketOffset[3] = {};
+		uint32 followTargetId = 0;
+	};
+
+	/// 数据块：关键帧保存在块头中，存储区只保存其后的增量记录
+	struct FBlock
+	{
+		FQuantizedSample keyframe;
+		int32 usedBytes = 0;
+	};
+
+	static FQuantizedSample quantize(const FRTSCameraReplaySample& sample);
+	static FRTSCameraReplaySample dequantize(const FQuantizedSample& sample);
+
+	/** @brief 以给定采样为关键帧开启新数据块，必要时覆盖最旧的块 */
+	void beginBlock(const FQuantizedSample& keyframe);
+
+	/** @brief 把增量记录写入当前数据块 */
+	void writeDelta(const FQuantizedSample& sample);
+
+	/** @brief 逻辑序号（0 为最旧）转换为数据块下标 */
+	int32 getBlockIndex(const int32 logicalIndex) const { return (this->oldestBlock + logicalIndex) % this->blocks.Num(); }
+
+	/// 单条增量记录的最大字节数：标志位、时间差与全部字段的变长编码
+	static constexpr int32 maxDeltaRecordBytes = 64;
+
+	/// 相邻采样的时间间隔超过该值时不插值（相机休眠期间不记录，状态保持不变）
+	static constexpr int64 maxInterpolationGapMilliseconds = 250;
+
+	TArray<uint8> storage;
+	TArray<FBlock> blocks;
+	int32 blockBytes = 0;
+
+	/// 最旧的数据块下标与正在使用的块数
+	int32 oldestBlock = 0;
+	int32 activeBlockCount = 0;
+
+	/// 最近写入的采样，增量编码的基准
+	FQuantizedSample lastSample;
+};
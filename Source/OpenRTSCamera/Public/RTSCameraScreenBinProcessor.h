@@ -0,0 +1,68 @@
+// Copyright 2024 Jesus Bracho All Rights Reserved.
+
+#pragma once
+
+#include <CoreMinimal.h>
+#include "MassProcessor.h"
+#include "RTSCameraScreenBinProcessor.generated.h"
+
+class FRTSCameraScreenBins;
+class FRTSCameraSnapshotChannel;
+
+/**
+ * @brief       按主玩家相机的快照把带 FRTSCameraScreenBinTag 的 Mass 实体分入屏幕瓦片。
+ *
+ * 在任务线程上运行：先按块收集实体的句柄、位置与半径，再以 ParallelFor 分块投影并统计各瓦片的数量，
+ * 前缀和得到每块在每个瓦片中的写入偏移后并行散列，结果为按瓦片连续存放的数组（计数排序，结果与线程调度无关）。
+ * 排序键为 (类型桶, 瓦片)，类型取自可选的 FSubType 片段，同类单位的屏幕查询因此只读取一个类型桶。
+ * 投影圆跨越多个瓦片的实体写入其覆盖的每个瓦片，单个近处的大单位不会扩大所有查询的范围。
+ * 实体每帧都在移动，分箱每帧整体重建；相机尚未发布快照时（例如专用服务器）不做任何工作。
+ * 存在不带 FRTSCameraScreenBinTag 的代理时同样不发布，HUD 回退到 ViewTraceForAgents 而不是漏选这些代理。
+ **/
+UCLASS()
+class OPENRTSCAMERA_API URTSCameraScreenBinProcessor : public UMassProcessor
+{
+	GENERATED_BODY()
+
+public:
+	URTSCameraScreenBinProcessor();
+
+	/// 实体没有 FAgentRadiusFragment 时使用的半径
+	UPROPERTY(EditDefaultsOnly, Category = "RTSCamera|Screen Bins")
+	float DefaultAgentRadius;
+
+	/// 每个并行块处理的实体数量
+	UPROPERTY(EditDefaultsOnly, Category = "RTSCamera|Screen Bins")
+	int32 EntitiesPerBlock;
+
+protected:
+	virtual void Initialize(UObject& Owner) override;
+	virtual void ConfigureQueries() override;
+	virtual void Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context) override;
+
+private:
+	FMassEntityQuery EntityQuery;
+
+	/// 有 FAgentRadiusFragment 却没有 FRTSCameraScreenBinTag 的代理，只用于计数
+	FMassEntityQuery UntaggedAgentQuery;
+
+	/// 已报告过未加标记的代理，避免逐帧刷屏
+	bool bHasWarnedUntaggedAgents;
+
+	/// 初始化时缓存的主快照通道与屏幕瓦片；世界中没有相机管理器时为空
+	TSharedPtr<const FRTSCameraSnapshotChannel, ESPMode::ThreadSafe> SnapshotChannel;
+	TSharedPtr<FRTSCameraScreenBins, ESPMode::ThreadSafe> ScreenBins;
+
+	/// 逐帧复用的缓冲
+	TArray<FMassEntityHandle> GatheredEntities;
+	TArray<FVector> GatheredLocations;
+	TArray<float> GatheredRadii;
+	TArray<int32> GatheredBuckets;
+	TArray<int32> TypeKeys;
+	TMap<int32, int32> BucketByTypeKey;
+	TArray<uint32> EntityTileRects;
+	TArray<int32> BlockTileCounts;
+	TArray<int32> TileStarts;
+	TArray<FMassEntityHandle> BinnedEntities;
+	TArray<uint16> BinnedFirstTiles;
+};
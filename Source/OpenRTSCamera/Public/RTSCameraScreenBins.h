@@ -0,0 +1,113 @@
+// Copyright 2024 Jesus Bracho All Rights Reserved.
+
+#pragma once
+
+#include <CoreMinimal.h>
+#include <atomic>
+#include "MassEntityTraitBase.h"
+#include "MassEntityTypes.h"
+#include "RTSCameraScreenBins.generated.h"
+
+/**
+ * @brief       Mass 实体按主玩家相机的屏幕位置分入的粗粒度瓦片。
+ *
+ * 由 URTSCameraScreenBinProcessor 每帧在任务线程上重建并发布，游戏线程上的框选、点选只读取选区覆盖的瓦片，
+ * 代价取决于选区内的实体数量而与实体总数无关。瓦片只作粗筛：发布时的位置可能落后一帧，调用方需用当前位置做精确测试。
+ *
+ * 屏幕坐标使用与长宽比无关的相机平面坐标：相对相机的位置在右、上方向的分量除以 (前向深度 × tan(水平半视角))，
+ * 水平方向屏幕左右边缘为 ±1，竖直方向向上为正，屏幕上下边缘为 ±1 / 视口长宽比。
+ * 瓦片覆盖 [-1, 1] × [-1, 1]，横屏视口的可见范围都在其中。
+ *
+ * 实体另按类型键（FSubType::Index，没有该片段时为 INDEX_NONE）分桶：数组按 (类型桶, 瓦片行, 瓦片列) 排序，
+ * "选中屏幕内所有同类单位" 只读取该类型桶中视口覆盖的瓦片。
+ *
+ * 实体按投影圆写入其覆盖的每个瓦片，查询无需按最大半径扩展；同一实体在查询矩形内只由其覆盖范围与矩形交集的首个瓦片返回，结果不含重复。
+ **/
+class OPENRTSCAMERA_API FRTSCameraScreenBins
+{
+public:
+	static constexpr int32 tileCountX = 32;
+	static constexpr int32 tileCountY = 32;
+	static constexpr int32 tileCount = tileCountX * tileCountY;
+
+	/** @brief 相机平面坐标所在的瓦片列、行；超出范围时钳制到边缘 */
+	static int32 getTileX(const float screenX) { return FMath::Clamp(FMath::FloorToInt32((screenX + 1.0f) * 0.5f * tileCountX), 0, tileCountX - 1); }
+	static int32 getTileY(const float screenY) { return FMath::Clamp(FMath::FloorToInt32((screenY + 1.0f) * 0.5f * tileCountY), 0, tileCountY - 1); }
+
+	/** @brief 把瓦片列、行打包为 publish 所需的首瓦片编号 */
+	static uint16 packTile(const int32 tileX, const int32 tileY) { return uint16(tileX | (tileY << 8)); }
+
+	/**
+	 * @brief       发布新一帧的分箱结果，与内部缓冲交换，调用方取回上一帧的缓冲以复用内存
+	 *
+	 * @param       参数名称: inOutTypeKeys                 数据类型:        TArray<int32>&  各类型桶的类型键
+	 * @param       参数名称: inOutTileStarts               数据类型:        TArray<int32>&  类型桶数 × tileCount + 1 个元素，
+	 *                                                                                      类型桶 b 中瓦片 t 的实体为 [starts[b × tileCount + t], starts[b × tileCount + t + 1])
+	 * @param       参数名称: inOutEntities                 数据类型:        TArray<FMassEntityHandle>&  覆盖多个瓦片的实体在每个瓦片中各出现一次
+	 * @param       参数名称: inOutFirstTiles               数据类型:        TArray<uint16>&  与 inOutEntities 一一对应，该实体覆盖范围左下角瓦片的 packTile 编号
+	 * @param       参数名称: publishFrame                  数据类型:        uint64  发布时的 GFrameCounter；相机休眠时快照不变，分箱仍逐帧发布
+	 **/
+	void publish(TArray<int32>& inOutTypeKeys, TArray<int32>& inOutTileStarts, TArray<FMassEntityHandle>& inOutEntities, TArray<uint16>& inOutFirstTiles, uint64 publishFrame);
+
+	/**
+	 * @brief       收集与相机平面坐标矩形相交的瓦片中的实体
+	 *
+	 * @param       参数名称: screenMin                     数据类型:        const FVector2f&
+	 * @param       参数名称: screenMax                     数据类型:        const FVector2f&
+	 * @param       参数名称: outEntities                   数据类型:        TArray<FMassEntityHandle>&  追加
+	 * @return      返回值类型:      bool  尚未发布过分箱结果时为 false
+	 **/
+	bool gatherEntities(const FVector2f& screenMin, const FVector2f& screenMax, TArray<FMassEntityHandle>& outEntities) const;
+
+	/**
+	 * @brief       只收集某一类型桶中与相机平面坐标矩形相交的瓦片中的实体
+	 *
+	 * @param       参数名称: typeKey                       数据类型:        int32
+	 * @param       参数名称: screenMin                     数据类型:        const FVector2f&
+	 * @param       参数名称: screenMax                     数据类型:        const FVector2f&
+	 * @param       参数名称: outEntities                   数据类型:        TArray<FMassEntityHandle>&  追加
+	 * @return      返回值类型:      bool  尚未发布过分箱结果时为 false；类型不在屏幕内时返回 true 且不追加
+	 **/
+	bool gatherEntitiesOfType(int32 typeKey, const FVector2f& screenMin, const FVector2f& screenMax, TArray<FMassEntityHandle>& outEntities) const;
+
+	/** @brief 最近一次发布时的 GFrameCounter，尚未发布时为 0；调用方据此判断处理器是否仍在运行 */
+	uint64 getPublishFrame() const { return this->publishFrame.load(std::memory_order_acquire); }
+
+private:
+	/** @brief 追加某一类型桶中矩形覆盖的瓦片，调用方持有锁 */
+	void gatherBucket(int32 bucket, const FVector2f& screenMin, const FVector2f& screenMax, TArray<FMassEntityHandle>& outEntities) const;
+
+	/// 发布与读取都只交换或复制数组，临界区很短
+	mutable FCriticalSection lock;
+
+	TArray<int32> typeKeys;
+	TArray<int32> tileStarts;
+	TArray<FMassEntityHandle> entities;
+	TArray<uint16> firstTiles;
+
+	std::atomic<uint64> publishFrame{0};
+};
+
+/**
+ * @brief       标记参与屏幕分箱的 Mass 实体
+ **/
+USTRUCT()
+struct OPENRTSCAMERA_API FRTSCameraScreenBinTag : public FMassTag
+{
+	GENERATED_BODY()
+};
+
+/**
+ * @brief       让 MassBattle 实体参与屏幕分箱，框选与点选由此只读取选区下的瓦片
+ *
+ * 要么全部、要么都不：分箱只含带此特征的实体，框选与点选读取分箱时看不到其余实体。
+ * 只要存在不带此特征的代理（有 FAgentRadiusFragment 的实体），处理器就停止发布，HUD 随之回退到 ViewTraceForAgents。
+ **/
+UCLASS(meta = (DisplayName = "RTS Camera Screen Bins"))
+class OPENRTSCAMERA_API URTSCameraScreenBinTrait : public UMassEntityTraitBase
+{
+	GENERATED_BODY()
+
+protected:
+	virtual void BuildTemplate(FMassEntityTemplateBuildContext& BuildContext, const UWorld& World) const override;
+};
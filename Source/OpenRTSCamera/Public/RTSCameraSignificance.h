@@ -0,0 +1,50 @@
+// Copyright 2024 Jesus Bracho All Rights Reserved.
+
+#pragma once
+
+#include <CoreMinimal.h>
+#include "MassEntityTraitBase.h"
+#include "MassEntityTypes.h"
+#include "RTSCameraSignificance.generated.h"
+
+/**
+ * @brief       Mass 实体相对主玩家相机的重要度分级，数值越大越不重要
+ **/
+UENUM(BlueprintType)
+enum class ERTSCameraSignificance : uint8
+{
+	OnScreenNear    UMETA(DisplayName = "On Screen Near"),
+	OnScreenFar     UMETA(DisplayName = "On Screen Far"),
+	NearOffScreen   UMETA(DisplayName = "Just Off Screen"),
+	FarOffScreen    UMETA(DisplayName = "Far Off Screen")
+};
+
+/**
+ * @brief       相机重要度片段，由 URTSCameraSignificanceProcessor 每帧批量写入。
+ *
+ * 动画、特效、AI 与 LOD 处理器读取 Significance 决定本帧的更新频率与细节级别；
+ * 分级以片段数值而非 Tag 表示，相机平移时大批实体改变分级也不会触发原型迁移。
+ **/
+USTRUCT()
+struct OPENRTSCAMERA_API FRTSCameraSignificanceFragment : public FMassFragment
+{
+	GENERATED_BODY()
+
+	/// 当前分级，相机尚未发布快照时保持最不重要的一级
+	ERTSCameraSignificance Significance = ERTSCameraSignificance::FarOffScreen;
+
+	/// 到相机的距离
+	float DistanceToCamera = MAX_flt;
+};
+
+/**
+ * @brief       为 MassBattle 实体配置相机重要度片段
+ **/
+UCLASS(meta = (DisplayName = "RTS Camera Significance"))
+class OPENRTSCAMERA_API URTSCameraSignificanceTrait : public UMassEntityTraitBase
+{
+	GENERATED_BODY()
+
+protected:
+	virtual void BuildTemplate(FMassEntityTemplateBuildContext& BuildContext, const UWorld& World) const override;
+};
@@ -0,0 +1,48 @@
+// Copyright 2024 Jesus Bracho All Rights Reserved.
+
+#pragma once
+
+#include <CoreMinimal.h>
+#include "MassProcessor.h"
+#include "RTSCameraSignificanceProcessor.generated.h"
+
+class FRTSCameraSnapshotChannel;
+
+/**
+ * @brief       按主玩家相机的快照为 Mass 实体计算重要度分级。
+ *
+ * 在任务线程上运行：读取 URTSCameraManagerSubsystem 的主快照通道，以视野在地面上的四边形为界，
+ * 每次四个实体做向量化的点在四边形内测试与距离比较，结果写入 FRTSCameraSignificanceFragment。
+ * 相机尚未发布快照时（例如专用服务器）不做任何修改。
+ **/
+UCLASS()
+class OPENRTSCAMERA_API URTSCameraSignificanceProcessor : public UMassProcessor
+{
+	GENERATED_BODY()
+
+public:
+	URTSCameraSignificanceProcessor();
+
+	/// 屏幕内的实体到相机的距离小于 臂长 × 该系数 时视为近处
+	UPROPERTY(EditDefaultsOnly, Category = "RTSCamera|Significance")
+	float NearDistanceArmLengthScale;
+
+	/// 近处距离的上限，避免高空俯视时整个屏幕都被视为近处
+	UPROPERTY(EditDefaultsOnly, Category = "RTSCamera|Significance")
+	float MaxNearDistance;
+
+	/// 视野四边形向外扩展的宽度（以四边形半径为单位），扩展带内的实体视为刚出屏幕
+	UPROPERTY(EditDefaultsOnly, Category = "RTSCamera|Significance")
+	float OffScreenMarginScale;
+
+protected:
+	virtual void Initialize(UObject& Owner) override;
+	virtual void ConfigureQueries() override;
+	virtual void Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context) override;
+
+private:
+	FMassEntityQuery EntityQuery;
+
+	/// 初始化时缓存的主快照通道；世界中没有相机管理器时为空
+	TSharedPtr<const FRTSCameraSnapshotChannel, ESPMode::ThreadSafe> SnapshotChannel;
+};
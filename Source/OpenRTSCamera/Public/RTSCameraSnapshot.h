@@ -0,0 +1,72 @@
+// Copyright 2024 Jesus Bracho All Rights Reserved.
+
+#pragma once
+
+#include <CoreMinimal.h>
+#include <atomic>
+#include <type_traits>
+
+/**
+ * @brief       RTS 相机某一帧的只读状态，纯数据结构，可在任意线程复制与使用
+ **/
+struct FRTSCameraSnapshot
+{
+	/// 相机的最终位姿（按弹簧臂求解公式得到，不受相机延迟影响）
+	FVector Location = FVector::ZeroVector;
+	FQuat Rotation = FQuat::Identity;
+
+	/// 根组件坐标（地面焦点）
+	FVector RootLocation = FVector::ZeroVector;
+
+	/// 当前臂长，以及在最小/最大缩放之间的归一化位置 [0, 1]
+	float ArmLength = 0.0f;
+	float ZoomAlpha = 0.0f;
+
+	/// 投影参数
+	float FieldOfView = 0.0f;
+	float AspectRatio = 0.0f;
+
+	/// 视野四角与地面的交点，与 URTSCamera::minimapFrustumPoints 一致（按缩放意图计算），顺序为左上、右上、右下、左下
+	FVector GroundCorners[4] = {};
+
+	/// 发布时的 GFrameCounter；相机休眠期间不再发布，读取方可据此判断快照的新旧
+	uint64 FrameNumber = 0;
+};
+
+static_assert(std::is_trivially_copyable_v<FRTSCameraSnapshot>, "FRTSCameraSnapshot 必须可按字节复制");
+
+/**
+ * @brief       相机快照的发布通道（顺序锁）。
+ *
+ * 游戏线程是唯一的写入方，每帧提交后发布一次；任意数量的读取方在任意线程上无锁读取，
+ * 读到写入中途的数据时自动重试。数据以原子字存储，读写两侧都不存在数据竞争。
+ **/
+class OPENRTSCAMERA_API FRTSCameraSnapshotChannel
+{
+public:
+	/**
+	 * @brief       发布新快照，仅由游戏线程调用
+	 *
+	 * @param       参数名称: snapshot                      数据类型:        const FRTSCameraSnapshot&
+	 **/
+	void publish(const FRTSCameraSnapshot& snapshot);
+
+	/**
+	 * @brief       读取最近一次发布的快照，可在任意线程调用
+	 *
+	 * @param       参数名称: outSnapshot                   数据类型:        FRTSCameraSnapshot&
+	 * @return      返回值类型:      bool  尚未发布过任何快照时为 false
+	 **/
+	bool read(FRTSCameraSnapshot& outSnapshot) const;
+
+	/** @brief 已发布的快照数量（每次发布递增，可用于廉价地判断是否有新数据） */
+	uint64 getPublishCount() const { return this->sequence.load(std::memory_order_acquire) / 2; }
+
+private:
+	static constexpr int32 snapshotWordCount = (sizeof(FRTSCameraSnapshot) + sizeof(uint64) - 1) / sizeof(uint64);
+
+	/// 偶数表示数据稳定，奇数表示写入进行中
+	std::atomic<uint64> sequence{0};
+
+	std::atomic<uint64> snapshotWords[snapshotWordCount] = {};
+};
@@ -4,6 +4,7 @@
 
 #include <CoreMinimal.h>
 #include "GameFramework/HUD.h"
+#include "MassAPIStructs.h"
 #include "RTSHUD.generated.h"
 
 UCLASS()
@@ -25,6 +26,13 @@ public:
 	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "Selection Box")
 	float MinSelectionSizeSq;
 
+	// Highlight the selectables under the box while it is being dragged
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "Selection Box")
+	bool bPreviewSelection;
+
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "Selection Box")
+	FLinearColor SelectionPreviewColor;
+
 	UFUNCTION(BlueprintCallable, Category = "Selection Box")
 	void BeginSelection(const FVector2D& StartPoint);
 
@@ -40,6 +48,11 @@ public:
 	UFUNCTION(BlueprintNativeEvent, Category = "Selection Box")
 	void PerformSelection();
 
+	// Called every frame while dragging with the selectables and Mass entities the box would select.
+	// Mass entities come from the primary camera's screen bins only and are empty when those are unavailable.
+	UFUNCTION(BlueprintNativeEvent, Category = "Selection Box")
+	void DrawSelectionPreview(const TArray<AActor*>& PreviewActors, const TArray<FEntityHandle>& PreviewEntities);
+
 protected:
 	/** Draw the selection box */
 	void DrawSelectionMarquee();
@@ -49,6 +62,46 @@ protected:
 private:
 	void PerformMassSelection(TArray<struct FEntityHandle>& OutEntities);
 
+	// Fast path for PerformMassSelection: reads only the screen tiles under the box from the primary camera's
+	// screen bins, then tests those agents' current positions. Returns false when the bins are unavailable
+	// or stale so the caller falls back to ViewTraceForAgents.
+	bool PerformBinnedMassSelection(const FVector2D& Min, const FVector2D& Max, bool bIsClick, TArray<struct FEntityHandle>& OutEntities) const;
+
+	// ViewTraceForAgents through the pixel rectangle; a click keeps only the nearest agent
+	void TraceMassSelection(const FVector2D& Min, const FVector2D& Max, bool bIsClick, TArray<struct FEntityHandle>& OutEntities) const;
+
+	// Ctrl+click for Mass: on-screen entities sharing the template's landmark type or FSubType index.
+	// Reads the template's type bucket of the screen bins, or filters a full-viewport trace when the bins are
+	// unavailable (split-screen guests, agents without the screen bin trait).
+	bool GatherOnScreenEntitiesOfSameType(const struct FEntityHandle& TemplateEntity, TArray<struct FEntityHandle>& OutEntities) const;
+
+	// The primary camera's screen bins, or null when this HUD is not the primary player's or the bins are stale
+	TSharedPtr<class FRTSCameraScreenBins, ESPMode::ThreadSafe> GetFreshScreenBins() const;
+
+	// Converts a pixel rectangle to the screen bins' camera-plane coordinates, padded by half a tile
+	bool PixelRectToScreenBinRect(const FVector2D& Min, const FVector2D& Max, FVector2f& OutScreenMin, FVector2f& OutScreenMax) const;
+
+	// Tests Mass candidates' current positions against the volume; appends hits and their locations
+	void SelectMassCandidates(const TArray<struct FMassEntityHandle>& Candidates, const struct FRTSCameraFrustumQuery& Volume, TArray<struct FMassEntityHandle>& OutEntities, TArray<FVector>& OutLocations) const;
+
+	// Replacement for GetActorsInSelectionRectangle over registered selectables only: the registry's spatial
+	// grid picks candidates under the rectangle's ground footprint, then FRTSCameraFrustumQuery tests their
+	// collision AABBs in SIMD batches. MatchClass optionally filters by exact class.
+	void GetSelectablesInSelectionRectangle(const FVector2D& FirstPoint, const FVector2D& SecondPoint, TArray<AActor*>& OutActors, const UClass* MatchClass = nullptr) const;
+
+	// Builds the selection volume from the camera through the rectangle's corners; clicks are widened to 2x2 pixels
+	bool BuildSelectionVolume(const FVector2D& FirstPoint, const FVector2D& SecondPoint, struct FRTSCameraFrustumQuery& OutVolume) const;
+
+	// Screen rectangle of the bounds' corners in front of the camera; false when every corner is behind it
+	bool ProjectBoundsToScreen(const FBox& Bounds, FBox2D& OutScreenBox) const;
+
+	// Draws the outline of a screen rectangle in the preview color
+	void DrawPreviewOutline(const FBox2D& ScreenBox);
+
+	// Reused every frame by the drag preview
+	TArray<AActor*> SelectionPreviewActors;
+	TArray<FEntityHandle> SelectionPreviewEntities;
+
 	bool bIsDrawingSelectionBox;
 	bool bIsPerformingSelection;
 	FVector2D SelectionStart;
@@ -1,4 +1,5 @@
 #pragma once
+#include "Components/ActorComponent.h"
 #include "RTSSelectable.generated.h"
 
 UCLASS(Blueprintable, ClassGroup=(Custom), meta=(BlueprintSpawnableComponent))
@@ -31,4 +32,15 @@ public:
 	float Shield = 0.0f;
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "RTS Data")
 	float MaxShield = 0.0f;
+
+protected:
+	// Registers with URTSSelectableRegistrySubsystem so selection never scans actors for this component.
+	virtual void OnRegister() override;
+	virtual void OnUnregister() override;
+
+private:
+	friend class URTSSelectableRegistrySubsystem;
+
+	// Slot in the registry's dense arrays, INDEX_NONE while unregistered.
+	int32 RegistrySlot = INDEX_NONE;
 };
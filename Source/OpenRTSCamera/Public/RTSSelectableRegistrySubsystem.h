@@ -0,0 +1,160 @@
+// Copyright 2024 Jesus Bracho All Rights Reserved.
+
+#pragma once
+
+#include <CoreMinimal.h>
+#include "Components/SceneComponent.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "RTSSelectableRegistrySubsystem.generated.h"
+
+class URTSSelectable;
+class UMassBattleAgentComponent;
+
+/**
+ * @brief       可选择单位注册表。
+ *
+ * URTSSelectable 在 OnRegister/OnUnregister 中自行登记与注销。注册表以紧凑数组保存组件、所属 Actor
+ * 与缓存的 UMassBattleAgentComponent，组件持有自身下标，注销时交换删除为 O(1)；另有 Actor 到下标的映射。
+ * 选择逻辑只遍历已登记的单位，不再遍历世界中的全部 Actor，也不再逐个查找组件。
+ *
+ * 每个单位另以地面投影的圆（包围盒中心 XY 与水平半径）登记到均匀网格。根组件变换时只标记为已移动，
+ * 查询前统一刷新；框选先把屏幕矩形投影为地面范围，再只对其覆盖的网格单元中的候选做精确测试。
+ * 精确测试所需的包围盒中心与半尺寸以紧凑数组保存，可直接交给 FRTSCameraFrustumQuery 批量测试。
+ **/
+UCLASS()
+class OPENRTSCAMERA_API URTSSelectableRegistrySubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+
+	/**
+	 * @brief       登记一个可选择组件；重复登记无效果
+	 *
+	 * @param       参数名称: Selectable                    数据类型:        URTSSelectable*
+	 **/
+	void RegisterSelectable(URTSSelectable* Selectable);
+
+	/**
+	 * @brief       注销一个可选择组件
+	 *
+	 * @param       参数名称: Selectable                    数据类型:        URTSSelectable*
+	 **/
+	void UnregisterSelectable(URTSSelectable* Selectable);
+
+	/**
+	 * @brief       查找 Actor 上已登记的可选择组件
+	 *
+	 * @param       参数名称: Actor                         数据类型:        const AActor*
+	 * @return      返回值类型:      URTSSelectable*  Actor 不可选择时为空
+	 **/
+	URTSSelectable* FindSelectable(const AActor* Actor) const;
+
+	/**
+	 * @brief       查找可选择 Actor 上缓存的 Mass 代理组件；登记时尚未创建的组件在首次查找时补查并缓存
+	 *
+	 * @param       参数名称: Actor                         数据类型:        const AActor*
+	 * @return      返回值类型:      UMassBattleAgentComponent*  Actor 不可选择或不是 Mass 代理时为空
+	 **/
+	UMassBattleAgentComponent* FindMassAgent(const AActor* Actor);
+
+	/** @brief Actor 是否可选择 */
+	bool IsSelectable(const AActor* Actor) const { return this->SlotByActor.Contains(Actor); }
+
+	/// 紧凑数组，三者下标一致；遍历时无需判空
+	TConstArrayView<TObjectPtr<URTSSelectable>> GetSelectables() const { return this->Selectables; }
+	TConstArrayView<TObjectPtr<AActor>> GetSelectableActors() const { return this->Owners; }
+
+	int32 Num() const { return this->Selectables.Num(); }
+
+	/// 有碰撞组件的轴对齐包围盒（中心与半尺寸），与紧凑数组下标一致；读取前需调用 FlushMovedSelectables
+	TConstArrayView<FVector> GetSelectableBoundsCenters() const { return this->BoundsCenters; }
+	TConstArrayView<FVector3f> GetSelectableBoundsExtents() const { return this->BoundsExtents; }
+
+	/** @brief 刷新所有已移动单位的包围盒、地面投影与所在网格；查询接口会自动调用 */
+	void FlushMovedSelectables();
+
+	/**
+	 * @brief       查询地面投影圆与给定地面范围相交的单位
+	 *
+	 * @param       参数名称: GroundBox                     数据类型:        const FBox2D&
+	 * @param       参数名称: OutSlots                      数据类型:        TArray<int32>&  追加命中单位在紧凑数组中的下标
+	 **/
+	void QuerySelectablesInGroundBox(const FBox2D& GroundBox, TArray<int32>& OutSlots);
+
+	/**
+	 * @brief       已登记单位包围盒覆盖的高度范围（只增不减），用于把屏幕矩形投影为地面范围
+	 *
+	 * @param       参数名称: OutMinZ                       数据类型:        float&
+	 * @param       参数名称: OutMaxZ                       数据类型:        float&
+	 * @return      返回值类型:      bool  没有已登记单位时返回 false
+	 **/
+	bool GetSelectableHeightRange(float& OutMinZ, float& OutMaxZ);
+
+	/// 空间网格单元边长，需在首个单位登记前设置
+	float SpatialCellSize = 2000.0f;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	/** @brief 单位根组件变换时标记为已移动 */
+	void HandleRootTransformUpdated(USceneComponent* UpdatedComponent, EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport);
+
+	/** @brief 标记单位需要在下次查询前刷新空间网格 */
+	void MarkMoved(int32 Slot);
+
+	/** @brief 按包围盒重新计算单位的地面投影，跨单元时迁移 */
+	void UpdateSpatialEntry(int32 Slot);
+
+	/** @brief 从所在网格单元中移除单位 */
+	void RemoveFromCell(int32 Slot);
+
+	FIntPoint GetCellCoord(const FVector2D& GroundLocation) const;
+
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<URTSSelectable>> Selectables;
+
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<AActor>> Owners;
+
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<UMassBattleAgentComponent>> MassAgents;
+
+	/// Actor 到紧凑数组下标的映射
+	TMap<TObjectKey<AActor>, int32> SlotByActor;
+
+	/// 单位的地面投影，与紧凑数组下标一致
+	struct FSpatialEntry
+	{
+		FVector2D Center = FVector2D::ZeroVector;
+		float Radius = 0.0f;
+		FIntPoint Cell = FIntPoint::ZeroValue;
+
+		/// 在所在单元数组中的下标，尚未放入网格时为 INDEX_NONE
+		int32 CellEntry = INDEX_NONE;
+
+		bool bMoved = false;
+
+		/// 监听变换的根组件；静态根组件不监听
+		TWeakObjectPtr<USceneComponent> TrackedRoot;
+	};
+
+	TArray<FSpatialEntry> SpatialEntries;
+
+	TArray<FVector> BoundsCenters;
+	TArray<FVector3f> BoundsExtents;
+
+	/// 网格单元到单位下标的映射，空单元即时移除
+	TMap<FIntPoint, TArray<int32>> Cells;
+
+	/// 待刷新的单位下标；交换删除后可能残留失效下标，刷新时以 bMoved 过滤
+	TArray<int32> MovedSlots;
+
+	/// 已登记单位的最大地面半径与高度范围，只增不减，用于保守地扩展查询
+	float MaxGroundRadius = 0.0f;
+	float MinBoundsZ = TNumericLimits<float>::Max();
+	float MaxBoundsZ = TNumericLimits<float>::Lowest();
+};
@@ -0,0 +1,160 @@
+// Copyright 2024 Jesus Bracho All Rights Reserved.
+
+#pragma once
+
+#include <CoreMinimal.h>
+#include "Components/SceneComponent.h"
+#include "Engine/EngineTypes.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "RTSTerrainHeightfieldSubsystem.generated.h"
+
+/**
+ * @brief       单个区域的高度场网格
+ **/
+struct FRTSTerrainHeightGrid
+{
+	/// 网格原点（最小 X/Y 角）
+	FVector2D GridOrigin = FVector2D::ZeroVector;
+
+	/// 采样间距与其倒数
+	float GridCellSize = 0.0f;
+	float InverseGridCellSize = 0.0f;
+
+	/// 网格节点数量
+	int32 SampleCountX = 0;
+	int32 SampleCountY = 0;
+
+	/// 射线参数
+	TEnumAsByte<ECollisionChannel> TraceChannel = ECC_WorldStatic;
+	float TraceStartZ = 0.0f;
+	float TraceEndZ = 0.0f;
+
+	/// 构建时请求的原始范围，用于判断缓存能否复用
+	FBox2D RequestedBounds = FBox2D(ForceInit);
+	float RequestedCellSize = 0.0f;
+
+	/// 行优先存储的节点高度
+	TArray<float> Heights;
+
+	/// 分帧构建的进度：下标小于该值的节点已完成首次采样
+	int32 BuiltNodeCount = 0;
+
+	/// 待重采样节点队列及其去重标记
+	TArray<int32> DirtyNodeQueue;
+	TBitArray<> DirtyNodeFlags;
+
+	/** @brief 网格是否已完成首次构建，可以响应查询 */
+	bool IsComplete() const { return SampleCountX > 0 && BuiltNodeCount == SampleCountX * SampleCountY; }
+};
+
+/**
+ * @brief       地形高度场缓存。
+ *
+ * 每个相机区域各自持有一份规则网格，互不覆盖；同一区域的网格只构建一次，由所有处于该区域的相机共享。
+ * 网格在 Tick 中按预算分帧采样，构建完成前查询返回 false，调用方回退到射线检测，对局中途切换区域不会卡顿。
+ * 带有 DynamicTerrainTag 标签的 Actor 移动或销毁时，仅将其覆盖的采样点标记为脏，并在 Tick 中按预算增量重采样。
+ **/
+UCLASS()
+class OPENRTSCAMERA_API URTSTerrainHeightfieldSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/// 标记会改变地面高度的动态几何体（可移动平台、可破坏地形等）的 Actor 标签
+	static const FName DynamicTerrainTag;
+
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	/**
+	 * @brief       请求为指定区域在给定水平范围内以固定间距采样地面高度。
+	 *              该区域已存在相同范围与精度的网格时直接复用，否则在后续 Tick 中分帧重建。
+	 *
+	 * @param       参数名称: Region                        数据类型:        const AActor*
+	 * @param       参数名称: Bounds                        数据类型:        const FBox2D&
+	 * @param       参数名称: CellSize                      数据类型:        float
+	 * @param       参数名称: Channel                       数据类型:        ECollisionChannel
+	 * @param       参数名称: TraceTopZ                     数据类型:        float
+	 * @param       参数名称: TraceBottomZ                  数据类型:        float
+	 **/
+	void BuildHeightfield(const AActor* Region, const FBox2D& Bounds, float CellSize, ECollisionChannel Channel, float TraceTopZ, float TraceBottomZ);
+
+	/**
+	 * @brief       查询指定区域网格中任意水平坐标处的地面高度（双线性插值，无物理查询）
+	 *
+	 * @param       参数名称: Region                        数据类型:        const AActor*
+	 * @param       参数名称: X                             数据类型:        float
+	 * @param       参数名称: Y                             数据类型:        float
+	 * @param       参数名称: OutHeight                     数据类型:        float&
+	 * @return      返回值类型:      bool  网格已构建完毕、坐标位于范围内且周围采样均命中地面时为 true
+	 **/
+	UFUNCTION(BlueprintCallable, Category = "RTSCamera|Heightfield")
+	bool GetGroundHeightAt(const AActor* Region, float X, float Y, float& OutHeight) const;
+
+	/**
+	 * @brief       指定区域的高度场是否已经构建完毕
+	 *
+	 * @param       参数名称: Region                        数据类型:        const AActor*
+	 **/
+	UFUNCTION(BlueprintPure, Category = "RTSCamera|Heightfield")
+	bool IsHeightfieldValid(const AActor* Region) const;
+
+	/**
+	 * @brief       将所有区域网格中落在指定水平范围内的采样点标记为待重采样
+	 *
+	 * @param       参数名称: Area                          数据类型:        const FBox2D&
+	 **/
+	void MarkAreaDirty(const FBox2D& Area);
+
+	/**
+	 * @brief       显式登记一个动态地形 Actor，其变换更新或销毁时自动刷新对应区域
+	 *
+	 * @param       参数名称: Actor                         数据类型:        AActor*
+	 **/
+	UFUNCTION(BlueprintCallable, Category = "RTSCamera|Heightfield")
+	void RegisterDynamicTerrainActor(AActor* Actor);
+
+	/// 每帧增量重采样的最大射线数量
+	int32 MaxRefreshSamplesPerTick = 64;
+
+	/// 每帧分帧构建的最大射线数量；射线在游戏线程上同步执行，预算保持在几百条以内
+	int32 MaxBuildSamplesPerTick = 256;
+
+	/// 每帧分帧构建的时间预算（毫秒），与射线数量预算先到者为准，复杂碰撞下也不会造成卡顿
+	float MaxBuildMillisecondsPerTick = 0.5f;
+
+	/// 单个网格允许的最大采样点数；超过时自动放大采样间距
+	int32 MaxSampleCount = 1024 * 1024;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	/** @brief 对网格的单个节点执行一次向下射线，写入高度缓存 */
+	void SampleNode(FRTSTerrainHeightGrid& Grid, int32 NodeIndex) const;
+
+	/** @brief 首次构建时登记场景中已有的动态地形，并监听之后生成的动态地形 */
+	void BeginTrackingDynamicTerrain();
+
+	/** @brief 动态地形 Actor 的根组件变换更新回调 */
+	void HandleDynamicTerrainTransformUpdated(USceneComponent* UpdatedComponent, EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport);
+
+	/** @brief 动态地形 Actor 销毁回调 */
+	UFUNCTION()
+	void HandleDynamicTerrainDestroyed(AActor* DestroyedActor);
+
+	/** @brief 新生成的 Actor 若带有动态地形标签则自动登记 */
+	void HandleActorSpawned(AActor* SpawnedActor);
+
+	/** @brief 计算 Actor 的水平包围盒 */
+	static FBox2D CalculateActorFootprint(const AActor* Actor);
+
+	/// 按区域 Actor 索引的高度场网格
+	TMap<TObjectKey<AActor>, FRTSTerrainHeightGrid> HeightGrids;
+
+	/// 已登记的动态地形 Actor 及其上一次的水平包围盒
+	TMap<TWeakObjectPtr<AActor>, FBox2D> TrackedDynamicFootprints;
+
+	FDelegateHandle ActorSpawnedHandle;
+};
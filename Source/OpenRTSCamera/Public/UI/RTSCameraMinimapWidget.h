@@ -55,6 +55,11 @@ private:
 	 **/
 	void handleMinimapFrustumUpdated();
 
+	/**
+	 * @brief       相机活动区域切换时的回调，使缓存的地图边界失效
+	 **/
+	void handleMovementBoundaryChanged();
+
 	/** Convert World Location (XY) to Widget Local Coordinates (UV * Size) */
 	FVector2D ConvertWorldToWidgetLocal(const FVector2D& WorldPos, const FVector2D& WidgetSize) const;
 
@@ -85,4 +90,7 @@ protected:
 
 	/// 状态位：标识玩家当前是否正在通过鼠标在控件上执行位置拖拽
 	bool bIsDragging = false;
+
+	/// 最近一次标记重绘的帧号，保证每帧至多失效一次
+	uint64 lastInvalidatedFrame = 0;
 };